@@ -15,7 +15,7 @@
  * Integerlab solution (c) the above-named student(s)
  */
 
-#include "alu.h"
+#include "alu_extensions.h"
 
 
 /**
@@ -24,8 +24,8 @@
  * @return 1 if the interpreted argument is less than zero; 0 otherwise
  */
 bool is_negative(uint16_t value) {
-    // Since it is a 16-bit integer, the most significant bit is the sign bit
-    return (value >> 15) & 1;
+    // The most significant bit is the sign bit
+    return (value >> ALU_SIGN_BIT) & 1;
 }
 
 /**
@@ -108,11 +108,25 @@ one_bit_adder_t one_bit_full_addition(one_bit_adder_t bits) {
  * @return the 32-bit sum of the arguments
  */
 uint32_t ripple_carry_addition(uint32_t value1, uint32_t value2, uint8_t initial_carry_in) {
+    return ripple_carry_addition_with_carry_out(value1, value2, initial_carry_in).sum;
+}
+
+/**
+ * Uses 32 one-bit full adders to add two 32-bit integers, preserving the carry-out bit from the most-significant bit
+ * so that additions can be chained to add numbers wider than 32 bits.
+ * @param value1 the first number to be added
+ * @param value2 the second number to be added
+ * @param initial_carry_in The carry-in bit for the least-significant bit's adder
+ * @return the 32-bit sum of the arguments, and the carry-out bit from the most-significant bit's adder
+ */
+ripple_carry_adder_t ripple_carry_addition_with_carry_out(uint32_t value1, uint32_t value2, uint8_t initial_carry_in) {
+    ripple_carry_adder_t result;
     uint8_t carry = initial_carry_in & 0x1;
     uint32_t sum = 0;
     uint32_t i = 0;
+    bool more_bits = true;
 
-    while (not_equal(i, 31))
+    while (more_bits)
     {
         one_bit_adder_t adder;
         adder.a = (value1 >> i) & 0x1;
@@ -123,12 +137,131 @@ uint32_t ripple_carry_addition(uint32_t value1, uint32_t value2, uint8_t initial
         adder = one_bit_full_addition(adder);
 
         // Update the sum and carry for the next iteration
-        sum |= (adder.sum << i);
+        sum |= ((uint32_t) adder.sum << i);
         carry = adder.c_out;
+
+        // Bit 31 is the last; advancing past it would wrap exponentiate(i) << 1 to zero
+        more_bits = not_equal(i, 31);
         i = lg(exponentiate(i) << 1);
     }
 
-    return sum;
+    result.sum = sum;
+    result.c_out = carry;
+    return result;
+}
+
+/**
+ * <p>Adds two 16-bit integers without evaluating any condition flags. The returned record holds the operation, its
+ * operands, and the adder's raw output; the flags are derived from that record only when one of the
+ * <code>lazy_</code> flag accessors is called.</p>
+ *
+ * <p>Use this (and <code>lazy_subtract</code>) when the caller only needs the sum, or needs only one or two of the
+ * flags.</p>
+ *
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @return the record from which the sum and flags can be evaluated
+ */
+lazy_alu_result_t lazy_add(uint16_t augend, uint16_t addend) {
+    lazy_alu_result_t record;
+    record.operation = ALU_ADDITION;
+    record.operand1 = augend;
+    record.operand2 = addend;
+    record.raw_result = ripple_carry_addition(augend, addend, 0);
+    return record;
+}
+
+/**
+ * <p>Subtracts two 16-bit integers without evaluating any condition flags. The subtrahend's one's complement is added
+ * with a carry-in of 1, so the difference takes a single pass through the ripple-carry adder.</p>
+ *
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @return the record from which the difference and flags can be evaluated
+ */
+lazy_alu_result_t lazy_subtract(uint16_t menuend, uint16_t subtrahend) {
+    lazy_alu_result_t record;
+    record.operation = ALU_SUBTRACTION;
+    record.operand1 = menuend;
+    record.operand2 = subtrahend;
+    record.raw_result = ripple_carry_addition(menuend, (uint16_t) ~subtrahend, 1);
+    return record;
+}
+
+/**
+ * Determines the operand that the adder actually saw as its second input for a lazily-evaluated operation.
+ * @param record the lazily-evaluated operation
+ * @return the addend for an addition, or the one's complement of the subtrahend for a subtraction
+ */
+static uint16_t lazy_adder_operand(lazy_alu_result_t record) {
+    return (uint16_t) (record.operation == ALU_SUBTRACTION ? ~record.operand2 : record.operand2);
+}
+
+/**
+ * Extracts the 16-bit result of a lazily-evaluated operation.
+ * @param record the lazily-evaluated operation
+ * @return the sum or difference
+ */
+uint16_t lazy_result(lazy_alu_result_t record) {
+    return (uint16_t) record.raw_result;
+}
+
+/**
+ * Determines whether the result of a lazily-evaluated operation is zero.
+ * @param record the lazily-evaluated operation
+ * @return 1 if the 16-bit result is zero; 0 otherwise
+ */
+bool lazy_zero(lazy_alu_result_t record) {
+    return is_zero(lazy_result(record));
+}
+
+/**
+ * Determines whether the result of a lazily-evaluated operation is negative when interpreted as a signed integer.
+ * @param record the lazily-evaluated operation
+ * @return 1 if the 16-bit result's sign bit is set; 0 otherwise
+ */
+bool lazy_negative(lazy_alu_result_t record) {
+    return is_negative(lazy_result(record));
+}
+
+/**
+ * Determines whether a lazily-evaluated operation overflowed when its operands are interpreted as unsigned integers.
+ * For an addition this is the carry out of the most-significant bit; for a subtraction it is the borrow, which is the
+ * complement of that carry.
+ * @param record the lazily-evaluated operation
+ * @return 1 if unsigned overflow occurred; 0 otherwise
+ */
+bool lazy_unsigned_overflow(lazy_alu_result_t record) {
+    bool carry = (record.raw_result >> ALU_WIDTH) & 0x1;
+    return carry ^ (record.operation == ALU_SUBTRACTION);
+}
+
+/**
+ * Determines whether a lazily-evaluated operation overflowed when its operands are interpreted as signed integers.
+ * Signed overflow occurs when both of the adder's inputs have the same sign and the result's sign differs from it.
+ * @param record the lazily-evaluated operation
+ * @return 1 if signed overflow occurred; 0 otherwise
+ */
+bool lazy_signed_overflow(lazy_alu_result_t record) {
+    uint16_t first = record.operand1;
+    uint16_t second = lazy_adder_operand(record);
+    uint16_t result = lazy_result(record);
+    return is_negative((uint16_t) (~(first ^ second) & (first ^ result)));
+}
+
+/**
+ * Evaluates every flag of a lazily-evaluated operation, producing the same ALU result that the eager function would
+ * have produced. The <code>supplemental_result</code> field and the <code>divide_by_zero</code> flag are set to 0.
+ * @param record the lazily-evaluated operation
+ * @return the result in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t evaluate_lazy_flags(lazy_alu_result_t record) {
+    alu_result_t evaluation = {};
+    evaluation.result = lazy_result(record);
+    evaluation.unsigned_overflow = lazy_unsigned_overflow(record);
+    evaluation.signed_overflow = lazy_signed_overflow(record);
+    evaluation.divide_by_zero = 0;
+    return evaluation;
 }
 
 /**
@@ -145,28 +278,8 @@ uint32_t ripple_carry_addition(uint32_t value1, uint32_t value2, uint8_t initial
  * @return the sum in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
  */
 alu_result_t add(uint16_t augend, uint16_t addend) {
-    alu_result_t sum = {}; // Initialize sum with all fields set to 0
-
-    // Calculate the sum using ripple carry addition
-    uint32_t result = ripple_carry_addition((uint32_t)augend, (uint32_t)addend, 0);
-
-    // Check for overflow when interpreted as unsigned integers
-    sum.unsigned_overflow = ((result >> 16) != 0); // Check if the upper 16 bits are not all 0
-
-    // Check for overflow when interpreted as signed integers
-    int16_t signed_augend = (int16_t)augend;
-    int16_t signed_addend = (int16_t)addend;
-    int16_t signed_result = (int16_t)result;
-    sum.signed_overflow = ((signed_augend > 0 && signed_addend > 0 && signed_result < 0) ||
-                           (signed_augend < 0 && signed_addend < 0 && signed_result > 0));
-
-    // Set the result field
-    sum.result = (uint16_t)result;
-
-    // Set divide_by_zero flag to 0
-    sum.divide_by_zero = 0;
-
-    return sum;
+    // The flags are evaluated immediately so that eager and lazy callers share one definition of each flag
+    return evaluate_lazy_flags(lazy_add(augend, addend));
 }
 
 /**
@@ -183,65 +296,115 @@ alu_result_t add(uint16_t augend, uint16_t addend) {
  * @return the difference in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
  */
 alu_result_t subtract(uint16_t menuend, uint16_t subtrahend) {
-    alu_result_t difference = {};   // Initialize the result structure
-
-    // Calculate the two's complement of the subtrahend
-    // uint16_t twos_complement_subtrahend = ~subtrahend + 1;
-    uint16_t twos_complement_subtrahend = add(~subtrahend, 1).result;
-
-    // Perform addition of the minuend and the two's complement of the subtrahend
-    difference = add(menuend, twos_complement_subtrahend);
-
-    // Check for overflow when interpreted as unsigned integers
-    difference.unsigned_overflow = (difference.result >> 16) != 0; // Check if the upper 16 bits are not all 0
-
-    // Check for overflow when interpreted as signed integers
-    difference.signed_overflow = (difference.result >> 15) != (menuend >> 15) && (difference.result >> 15) != (twos_complement_subtrahend >> 15);
+    // a - b == a + ~b + 1, so the two's complement is folded into the adder's carry-in (one ripple pass, not two)
+    return evaluate_lazy_flags(lazy_subtract(menuend, subtrahend));
+}
 
-    return difference;
+/**
+ * <p>Compares two values by subtracting the second from the first in a single pass through the ripple-carry adder.
+ * Every signed and unsigned relation between the two values can be derived from the returned flags with the
+ * <code>flags_</code> macros, so code that tests several relations between the same pair of values should call this
+ * function once and reuse its result.</p>
+ *
+ * <p>The flags are <code>ALU_ZERO_FLAG</code> (the values are equal), <code>ALU_SIGN_FLAG</code> (the difference is
+ * negative), <code>ALU_OVERFLOW_FLAG</code> (the difference overflowed as a signed integer), and
+ * <code>ALU_CARRY_FLAG</code> (the subtraction borrowed; that is, the first value is less than the second as an
+ * unsigned integer).</p>
+ *
+ * @param value1 the value on the left side of the comparison
+ * @param value2 the value on the right side of the comparison
+ * @return the condition flags of <code>value1 - value2</code>
+ */
+alu_flags_t compare(uint16_t value1, uint16_t value2) {
+    lazy_alu_result_t difference = lazy_subtract(value1, value2);
+    return (alu_flags_t) ((lazy_zero(difference) ? ALU_ZERO_FLAG : 0)
+                          | (lazy_negative(difference) ? ALU_SIGN_FLAG : 0)
+                          | (lazy_signed_overflow(difference) ? ALU_OVERFLOW_FLAG : 0)
+                          | (lazy_unsigned_overflow(difference) ? ALU_CARRY_FLAG : 0));
 }
 
 /**
- * Determines whether the first value is strictly less than the second.
+ * Determines whether the first value is strictly less than the second when both are interpreted as signed integers.
  * @param value1 the value on the left side of the inequality comparison
  * @param value2 the value on the right side of the inequality comparison
  * @return 1 if the first argument is strictly less than the second; 0 otherwise
  */
 bool less_than(uint16_t value1, uint16_t value2) {
-    return is_negative(subtract(value1, value2).result);
+    // the sign of the difference is only meaningful when the subtraction did not overflow
+    return flags_less_than(compare(value1, value2));
 }
 
 /**
  * Determines whether the first value is at most the second; that is, whether the first value is less than or equal to
- * the second.
+ * the second when both are interpreted as signed integers.
  * @param value1 the value on the left side of the inequality comparison
  * @param value2 the value on the right side of the inequality comparison
  * @return 1 if the first argument is at most the second; 0 otherwise
  */
 bool at_most(uint16_t value1, uint16_t value2) {
-    return !less_than(value2, value1);
+    return flags_at_most(compare(value1, value2));
 }
 
 /**
  * Determines whether the first value is at least the second; that is, whether the first value is greater than or equal
- * to the second.
+ * to the second when both are interpreted as signed integers.
  * @param value1 the value on the left side of the inequality comparison
  * @param value2 the value on the right side of the inequality comparison
  * @return 1 if the first argument is at least the second; 0 otherwise
  */
 bool at_least(uint16_t value1, uint16_t value2) {
-    return !less_than(value1, value2);
+    return flags_at_least(compare(value1, value2));
 }
 
 /**
- * Determines whether the first value is strictly greater than the second.
+ * Determines whether the first value is strictly greater than the second when both are interpreted as signed integers.
  * @param value1 the value on the left side of the inequality comparison
  * @param value2 the value on the right side of the inequality comparison
  * @return 1 if the first argument is strictly greater than the second; 0 otherwise
  */
 bool greater_than(uint16_t value1, uint16_t value2) {
-    // inverse of value1 <= value2 is value1 > value2
-    return less_than(value2, value1);
+    return flags_greater_than(compare(value1, value2));
+}
+
+/**
+ * Determines whether the first value is strictly less than the second when both are interpreted as unsigned integers.
+ * @param value1 the value on the left side of the inequality comparison
+ * @param value2 the value on the right side of the inequality comparison
+ * @return 1 if the first argument is strictly less than the second; 0 otherwise
+ */
+bool unsigned_less_than(uint16_t value1, uint16_t value2) {
+    return flags_unsigned_less_than(compare(value1, value2));
+}
+
+/**
+ * Determines whether the first value is at most the second when both are interpreted as unsigned integers.
+ * @param value1 the value on the left side of the inequality comparison
+ * @param value2 the value on the right side of the inequality comparison
+ * @return 1 if the first argument is at most the second; 0 otherwise
+ */
+bool unsigned_at_most(uint16_t value1, uint16_t value2) {
+    return flags_unsigned_at_most(compare(value1, value2));
+}
+
+/**
+ * Determines whether the first value is at least the second when both are interpreted as unsigned integers.
+ * @param value1 the value on the left side of the inequality comparison
+ * @param value2 the value on the right side of the inequality comparison
+ * @return 1 if the first argument is at least the second; 0 otherwise
+ */
+bool unsigned_at_least(uint16_t value1, uint16_t value2) {
+    return flags_unsigned_at_least(compare(value1, value2));
+}
+
+/**
+ * Determines whether the first value is strictly greater than the second when both are interpreted as unsigned
+ * integers.
+ * @param value1 the value on the left side of the inequality comparison
+ * @param value2 the value on the right side of the inequality comparison
+ * @return 1 if the first argument is strictly greater than the second; 0 otherwise
+ */
+bool unsigned_greater_than(uint16_t value1, uint16_t value2) {
+    return flags_unsigned_greater_than(compare(value1, value2));
 }
 
 /**
@@ -252,8 +415,97 @@ bool greater_than(uint16_t value1, uint16_t value2) {
  * @return the full product of the two arguments
  */
 uint32_t multiply_by_power_of_two(uint16_t value, uint16_t power_of_two) {
-    // Multiply the value by the power of two is equivalent to left shifting the value by the log base 2 of the power of two
-    return value << lg(power_of_two);
+    // Multiplying by a power of two is shifting left by its logarithm; the bits shifted out are the product's upper half
+    alu_result_t shifted = barrel_shift(value, lg(power_of_two), ALU_SHIFT_LEFT);
+    return (uint32_t) shifted.supplemental_result << ALU_WIDTH | shifted.result;
+}
+
+/**
+ * One multiplexer stage of the barrel shifter: the stage passes its 32-bit input through unchanged, or shifted by the
+ * stage's fixed distance, depending on one bit of the shift amount.
+ * @param word the stage's input
+ * @param select the bit of the shift amount that controls this stage
+ * @param distance the stage's fixed distance, a power of two
+ * @param right whether the stage shifts toward the least-significant bit
+ * @param fill the bits that a right shift brings in at the most-significant end: all ones or all zeroes
+ * @return the stage's output
+ */
+static uint32_t barrel_shift_stage(uint32_t word, bool select, uint8_t distance, bool right, uint32_t fill) {
+    uint32_t shifted = right ? (word >> distance) | (fill & ~(UINT32_MAX >> distance)) : word << distance;
+    return select ? shifted : word;
+}
+
+/**
+ * <p>Shifts or rotates a 16-bit value by 0 to 15 places, using lg(16) = 4 multiplexer stages that shift by 1, 2, 4,
+ * and 8 places; each bit of <code>amount</code> selects whether its stage shifts. Only the four least-significant bits
+ * of <code>amount</code> are used.</p>
+ *
+ * <p>The stages work on a 32-bit word. A left shift starts with the value in the lower half, so the bits shifted out
+ * collect in the upper half; a right shift starts with the value in the upper half, so the bits shifted out collect
+ * in the lower half; and a rotation starts with two copies of the value, so a shift of the word is a rotation of
+ * each copy.</p>
+ *
+ * <p>The shifted value is placed in the ALU's <code>result</code> field. For shifts, the bits shifted out are placed
+ * in the <code>supplemental_result</code> field: a left shift's lost bits are the upper half of the 32-bit product
+ * <code>value</code> * 2<sup><code>amount</code></sup>, and a right shift's lost bits are left-aligned, as the
+ * fraction that the quotient discards. Rotations lose no bits and place 0 there.</p>
+ *
+ * <p>The <code>unsigned_overflow</code> flag is the carry-out: the last bit shifted out, or for a rotation the last
+ * bit carried around. It is 0 when <code>amount</code> is 0. The <code>signed_overflow</code> flag is set when a left
+ * shift's result, interpreted as a signed integer, is not <code>value</code> * 2<sup><code>amount</code></sup>; it
+ * is 0 for the other operations, as is <code>divide_by_zero</code>.</p>
+ *
+ * @param value the bit vector to be shifted or rotated
+ * @param amount the number of places to shift or rotate
+ * @param operation the kind of shift or rotation
+ * @return the shifted value in the ALU's <code>result</code> field, the bits shifted out in its
+ * <code>supplemental_result</code> field, and the carry-out and overflow flags set appropriately
+ */
+alu_result_t barrel_shift(uint16_t value, uint8_t amount, alu_shift_t operation) {
+    alu_result_t shift = {};
+    bool right = (operation == ALU_SHIFT_RIGHT) || (operation == ALU_SHIFT_RIGHT_ARITHMETIC)
+                 || (operation == ALU_ROTATE_RIGHT);
+    bool rotate = (operation == ALU_ROTATE_LEFT) || (operation == ALU_ROTATE_RIGHT);
+    uint32_t fill = ((operation == ALU_SHIFT_RIGHT_ARITHMETIC) && is_negative(value)) ? UINT32_MAX : 0;
+    uint32_t word = rotate ? ((uint32_t) value << ALU_WIDTH | value) : (right ? (uint32_t) value << ALU_WIDTH : value);
+    // The mask of a left shift's lost bits goes through a second set of stages alongside the word
+    uint32_t lost_bits = 0xFFFF;
+
+    word = barrel_shift_stage(word, amount & 0x1, 1, right, fill);
+    word = barrel_shift_stage(word, amount & 0x2, 2, right, fill);
+    word = barrel_shift_stage(word, amount & 0x4, 4, right, fill);
+    word = barrel_shift_stage(word, amount & 0x8, 8, right, fill);
+    lost_bits = barrel_shift_stage(lost_bits, amount & 0x1, 1, false, 0);
+    lost_bits = barrel_shift_stage(lost_bits, amount & 0x2, 2, false, 0);
+    lost_bits = barrel_shift_stage(lost_bits, amount & 0x4, 4, false, 0);
+    lost_bits = barrel_shift_stage(lost_bits, amount & 0x8, 8, false, 0);
+
+    uint16_t upper = word >> ALU_WIDTH;
+    uint16_t lower = word & 0xFFFF;
+    switch (operation) {
+        case ALU_SHIFT_LEFT:
+            shift.result = lower;
+            shift.supplemental_result = upper;
+            shift.unsigned_overflow = upper & 0x1;
+            // Without overflow, every bit shifted out is a copy of the result's sign bit
+            shift.signed_overflow = not_equal(upper, is_negative(lower) ? lost_bits >> ALU_WIDTH : 0);
+            break;
+        case ALU_SHIFT_RIGHT:
+        case ALU_SHIFT_RIGHT_ARITHMETIC:
+            shift.result = upper;
+            shift.supplemental_result = lower;
+            shift.unsigned_overflow = is_negative(lower);
+            break;
+        case ALU_ROTATE_LEFT:
+            shift.result = upper;
+            shift.unsigned_overflow = is_not_zero(amount & 0xF) & upper & 0x1;
+            break;
+        default:
+            shift.result = lower;
+            shift.unsigned_overflow = is_not_zero(amount & 0xF) & is_negative(lower);
+            break;
+    }
+    return shift;
 }
 
 /**
@@ -271,28 +523,25 @@ uint32_t multiply_by_power_of_two(uint16_t value, uint16_t power_of_two) {
 alu_result_t unsigned_multiply(uint16_t multiplicand, uint16_t multiplier) {
     alu_result_t product = {};  // Initialize the result structure
     uint32_t result = 0;        // Initialize the result to 0
-    uint32_t i = 0;                  // Initialize the bit index
+    uint32_t partial_product = multiplicand;    // the multiplicand, shifted into place under the current multiplier bit
 
     // Iterate through each bit of the multiplier
     while (multiplier) {
         // Check if the least significant bit of the multiplier is set
         if (multiplier & 1) {
-            // Calculate the intermediate product by multiplying the multiplicand by 2^i
-            uint32_t intermediate_product = multiplicand << i;
-            // Add the intermediate product to the result
-            result = add(result, intermediate_product).result;
+            // Accumulate the partial product; none of the flags are needed, so bypass the flag logic entirely
+            result = ripple_carry_addition(result, partial_product, 0);
         }
-        
-        // Right-shift the multiplier to move to the next bit
+
+        // Right-shift the multiplier to move to the next bit, and left-shift the partial product to stay under it
         multiplier >>= 1;
-        // Increment the bit index
-        i = lg(exponentiate(i) << 1);
+        partial_product <<= 1;
     }
 
     // Store the lower 16 bits of the result in the product's result field
     product.result = result & 0xFFFF;
     // Store the upper 16 bits of the result in the product's supplemental_result field
-    product.supplemental_result = result >> 16;
+    product.supplemental_result = result >> ALU_WIDTH;
     // Set the divide_by_zero flag to 0
     product.divide_by_zero = 0;
 
@@ -319,17 +568,14 @@ alu_result_t unsigned_multiply(uint16_t multiplicand, uint16_t multiplier) {
  */
 alu_result_t unsigned_divide(uint16_t dividend, uint16_t divisor) {
     alu_result_t quotient = {};     // empty initializer to suppress uninitialized variable warning in the starter code
-        
-    // Check if the divisor is zero using bitwise operations
-    quotient.divide_by_zero = (add(~divisor, 1).result >> 15) & 1;
-    
-    // Determine the quotient and remainder using fast division by power of two
-    // quotient.result = dividend >> lg(divisor);  // Quotient
-    quotient.supplemental_result = dividend & (subtract(divisor, 1).result);  // Remainder
-    
-    // Set the divide_by_zero flag to 0
-    quotient.divide_by_zero = 0;
-    
+    uint8_t places = lg(divisor);
+
+    // Dividing by a power of two is shifting right by its logarithm
+    quotient.result = barrel_shift(dividend, places, ALU_SHIFT_RIGHT).result;
+    // The remainder is what the quotient, shifted back, does not account for
+    quotient.supplemental_result = dividend ^ barrel_shift(quotient.result, places, ALU_SHIFT_LEFT).result;
+    quotient.divide_by_zero = is_zero(divisor);
+
     return quotient;  // Return the result
 }
 
@@ -351,7 +597,13 @@ alu_result_t unsigned_divide(uint16_t dividend, uint16_t divisor) {
  * @return the product in the ALU's <code>result</code> and <code>supplemental_result</code> fields
  */
 alu_result_t signed_multiply(uint16_t multiplicand, uint16_t multiplier) {
-    alu_result_t product = {};      // empty initializer to suppress uninitialized variable warning in the starter code
+    // The unsigned product reads each negative operand as 2**16 more than its signed value, which adds the other
+    // operand times 2**16 to the full product; the lower half is unaffected, and the upper half loses the excess
+    alu_result_t product = unsigned_multiply(multiplicand, multiplier);
+    uint16_t excess = (uint16_t) ripple_carry_addition(is_negative(multiplicand) ? multiplier : 0,
+                                                       is_negative(multiplier) ? multiplicand : 0, 0);
+    product.supplemental_result = subtract(product.supplemental_result, excess).result;
+    product.divide_by_zero = 0;
     return product;
 }
 
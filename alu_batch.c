@@ -0,0 +1,93 @@
+/**************************************************************************//**
+ *
+ * @file alu_batch.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Batch entry point for the ALU, compiled against its inline twin.
+ *
+ * alu_batch() is compiled with alu_inline.h, so each operation's loop calls
+ * the static-inline copy of alu.c. The compiler can inline the ALU into the
+ * loop, keep the operands in registers, and skip the profiler's hooks. The
+ * out-of-line functions cannot be called from here. A caller that checks
+ * these results against them, or counts their calls, does so from its own
+ * translation unit.
+ *
+ * The operation is chosen once per batch, outside the loop, so each loop body
+ * is a single ALU operation.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "alu_inline.h"
+#include "alu_batch.h"
+
+static const char *operation_names[NUMBER_OF_ALU_BATCH_OPERATIONS] = {
+        "add", "subtract", "unsigned_multiply", "signed_multiply", "unsigned_divide", "compare", "equal", "is_negative"
+};
+
+/**
+ * Applies one ALU operation to each pair of operands, with the ALU inlined.
+ * @param operation the operation, the same for every pair
+ * @param operands1 the first operands
+ * @param operands2 the second operands
+ * @param results where the ALU's result for each pair is written
+ * @param count the number of pairs
+ */
+void alu_batch(alu_batch_operation_t operation, const uint16_t *operands1, const uint16_t *operands2,
+               alu_result_t *results, size_t count) {
+    switch (operation) {
+        case ALU_BATCH_ADD:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = add(operands1[i], operands2[i]);
+            }
+            break;
+        case ALU_BATCH_SUBTRACT:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = subtract(operands1[i], operands2[i]);
+            }
+            break;
+        case ALU_BATCH_UNSIGNED_MULTIPLY:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = unsigned_multiply(operands1[i], operands2[i]);
+            }
+            break;
+        case ALU_BATCH_SIGNED_MULTIPLY:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = signed_multiply(operands1[i], operands2[i]);
+            }
+            break;
+        case ALU_BATCH_UNSIGNED_DIVIDE:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = unsigned_divide(operands1[i], operands2[i]);
+            }
+            break;
+        case ALU_BATCH_COMPARE:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = (alu_result_t) {.result = compare(operands1[i], operands2[i])};
+            }
+            break;
+        case ALU_BATCH_EQUAL:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = (alu_result_t) {.result = equal(operands1[i], operands2[i])};
+            }
+            break;
+        default:
+            for (size_t i = 0; i < count; i++) {
+                results[i] = (alu_result_t) {.result = is_negative(operands1[i])};
+            }
+    }
+}
+
+/**
+ * Names an operation, as alu.h spells it.
+ * @param operation the operation
+ * @return the name of the ALU function that the operation applies
+ */
+const char *alu_batch_operation_name(alu_batch_operation_t operation) {
+    return (operation < NUMBER_OF_ALU_BATCH_OPERATIONS) ? operation_names[operation] : "unknown";
+}
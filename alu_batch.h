@@ -0,0 +1,39 @@
+/**************************************************************************//**
+ *
+ * @file alu_batch.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for applying one ALU
+ *      operation to arrays of operands, with the ALU inlined into the loop.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_BATCH_H
+#define ALU_BATCH_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+typedef enum {
+    ALU_BATCH_ADD = 0,
+    ALU_BATCH_SUBTRACT,
+    ALU_BATCH_UNSIGNED_MULTIPLY,
+    ALU_BATCH_SIGNED_MULTIPLY,
+    ALU_BATCH_UNSIGNED_DIVIDE,          // the divisors must be powers of two, or zero
+    ALU_BATCH_COMPARE,                  // the condition flags are placed in the result field
+    ALU_BATCH_EQUAL,                    // the relations' truth values are placed in the result field
+    ALU_BATCH_IS_NEGATIVE,              // of the first operands; the second operands are ignored
+    NUMBER_OF_ALU_BATCH_OPERATIONS
+} alu_batch_operation_t;
+
+void alu_batch(alu_batch_operation_t operation, const uint16_t *operands1, const uint16_t *operands2,
+               alu_result_t *results, size_t count) __attribute__ ((no_instrument_function));
+const char *alu_batch_operation_name(alu_batch_operation_t operation) __attribute__ ((no_instrument_function));
+
+#endif //ALU_BATCH_H
@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ *
+ * @file alu_constant_time.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Branch-free ALU variant whose latency does not depend on the operand
+ *      values.
+ *
+ * Every operation runs a fixed number of one-bit steps, and wherever the
+ * bitwise ALU would branch on an operand bit, this variant instead computes
+ * both alternatives and selects one with an all-zeros or all-ones mask. The
+ * functions therefore double as a constant-time implementation.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "alu_constant_time.h"
+
+static uint64_t fixed_width_addition(uint32_t value1, uint32_t value2, uint32_t carry, int width) __attribute__ ((no_instrument_function));
+static uint32_t select_mask(uint32_t bit) __attribute__ ((no_instrument_function));
+
+/**
+ * Adds the low <code>width</code> bits of two values one bit position at a time, always taking exactly
+ * <code>width</code> steps.
+ * @param value1 the first number to be added
+ * @param value2 the second number to be added
+ * @param carry the carry-in bit for the least-significant bit
+ * @param width the number of bit positions to add
+ * @return the <code>width</code>-bit sum, with the carry out of the most-significant bit in bit <code>width</code>
+ */
+static uint64_t fixed_width_addition(uint32_t value1, uint32_t value2, uint32_t carry, int width) {
+    uint64_t sum = 0;
+    carry &= 0x1;
+    for (int i = 0; i < width; i++) {
+        uint32_t a = (value1 >> i) & 0x1;
+        uint32_t b = (value2 >> i) & 0x1;
+        sum |= (uint64_t) (a ^ b ^ carry) << i;
+        carry = (a & b) | (carry & (a ^ b));
+    }
+    return sum | ((uint64_t) carry << width);
+}
+
+/**
+ * Expands a single bit into a selection mask.
+ * @param bit the selecting bit; only the least-significant bit is considered
+ * @return all ones if the bit is set; all zeros otherwise
+ */
+static uint32_t select_mask(uint32_t bit) {
+    return (uint32_t) 0 - (bit & 0x1);
+}
+
+/**
+ * Adds two 16-bit integers in a fixed 16 steps. The flags have the same meaning as those of <code>add</code>.
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @return the sum in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t constant_time_add(uint16_t augend, uint16_t addend) {
+    alu_result_t sum = {};
+    uint64_t raw_sum = fixed_width_addition(augend, addend, 0, 16);
+    sum.result = (uint16_t) raw_sum;
+    sum.unsigned_overflow = (raw_sum >> 16) & 0x1;
+    sum.signed_overflow = ((~(augend ^ addend) & (augend ^ sum.result)) >> 15) & 0x1;
+    sum.divide_by_zero = 0;
+    return sum;
+}
+
+/**
+ * Subtracts two 16-bit integers in a fixed 16 steps. The flags have the same meaning as those of
+ * <code>subtract</code>.
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @return the difference in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t constant_time_subtract(uint16_t menuend, uint16_t subtrahend) {
+    alu_result_t difference = {};
+    uint64_t raw_difference = fixed_width_addition(menuend, (uint16_t) ~subtrahend, 1, 16);
+    difference.result = (uint16_t) raw_difference;
+    difference.unsigned_overflow = (~raw_difference >> 16) & 0x1;
+    difference.signed_overflow = (((menuend ^ subtrahend) & (menuend ^ difference.result)) >> 15) & 0x1;
+    difference.divide_by_zero = 0;
+    return difference;
+}
+
+/**
+ * Multiplies two 16-bit unsigned integers. All 16 partial products are accumulated; a partial product whose
+ * multiplier bit is 0 is masked to zero rather than skipped.
+ * @param multiplicand the number to be multiplied
+ * @param multiplier the number that the first is to be multiplied by
+ * @return the product in the ALU's <code>result</code> and <code>supplemental_result</code> fields
+ */
+alu_result_t constant_time_unsigned_multiply(uint16_t multiplicand, uint16_t multiplier) {
+    alu_result_t product = {};
+    uint32_t accumulator = 0;
+    for (int i = 0; i < 16; i++) {
+        uint32_t partial_product = ((uint32_t) multiplicand << i) & select_mask((uint32_t) multiplier >> i);
+        accumulator = (uint32_t) fixed_width_addition(accumulator, partial_product, 0, 32);
+    }
+    product.result = (uint16_t) accumulator;
+    product.supplemental_result = (uint16_t) (accumulator >> 16);
+    product.divide_by_zero = 0;
+    return product;
+}
+
+/**
+ * <p>Divides two 16-bit unsigned integers by restoring division. Unlike <code>unsigned_divide</code>, the divisor need
+ * not be a power of two. Each of the 16 steps always performs the trial subtraction, and the restored or reduced
+ * remainder is selected with a mask.</p>
+ *
+ * <p>If the divisor is zero, the <code>divide_by_zero</code> flag is set to 1 and the work is performed anyway (so
+ * that it takes the same time); no guarantees are made about the <code>result</code> and
+ * <code>supplemental_result</code> fields.</p>
+ *
+ * @param dividend the number to be divided
+ * @param divisor the number that divides the first
+ * @return the quotient in the ALU's <code>result</code> field, the remainder in the <code>supplemental_result</code> field, and the <code>divide_by_zero</code> flag set appropriately
+ */
+alu_result_t constant_time_unsigned_divide(uint16_t dividend, uint16_t divisor) {
+    alu_result_t quotient = {};
+    uint32_t remainder = 0;
+    uint32_t quotient_bits = 0;
+    uint32_t negated_divisor = ~(uint32_t) divisor & 0x1FFFF;      // the shifted remainder can need 17 bits
+    for (int i = 15; i >= 0; i--) {
+        remainder = (remainder << 1) | (((uint32_t) dividend >> i) & 0x1);
+        uint64_t trial = fixed_width_addition(remainder, negated_divisor, 1, 17);
+        uint32_t no_borrow = (uint32_t) (trial >> 17) & 0x1;
+        uint32_t mask = select_mask(no_borrow);
+        remainder = ((uint32_t) trial & 0x1FFFF & mask) | (remainder & ~mask);
+        quotient_bits |= no_borrow << i;
+    }
+    quotient.result = (uint16_t) quotient_bits;
+    quotient.supplemental_result = (uint16_t) remainder;
+    quotient.divide_by_zero = !divisor;
+    return quotient;
+}
+
+/**
+ * Compares two values in a fixed 16 steps, producing the same flags as <code>compare</code>.
+ * @param value1 the value on the left side of the comparison
+ * @param value2 the value on the right side of the comparison
+ * @return the condition flags of <code>value1 - value2</code>
+ */
+alu_flags_t constant_time_compare(uint16_t value1, uint16_t value2) {
+    uint64_t raw_difference = fixed_width_addition(value1, (uint16_t) ~value2, 1, 16);
+    uint32_t difference = (uint16_t) raw_difference;
+    uint32_t zero = (difference - 1) >> 31;
+    uint32_t sign = difference >> 15;
+    uint32_t overflow = (((value1 ^ value2) & (value1 ^ difference)) >> 15) & 0x1;
+    uint32_t borrow = (uint32_t) (~raw_difference >> 16) & 0x1;
+    return (alu_flags_t) ((zero * ALU_ZERO_FLAG) | (sign * ALU_SIGN_FLAG)
+                          | (overflow * ALU_OVERFLOW_FLAG) | (borrow * ALU_CARRY_FLAG));
+}
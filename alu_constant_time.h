@@ -0,0 +1,28 @@
+/**************************************************************************//**
+ *
+ * @file alu_constant_time.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for the branch-free, constant-latency ALU
+ *      variant.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_CONSTANT_TIME_H
+#define ALU_CONSTANT_TIME_H
+
+#include "alu_extensions.h"
+
+alu_result_t constant_time_add(uint16_t augend, uint16_t addend);
+alu_result_t constant_time_subtract(uint16_t menuend, uint16_t subtrahend);
+alu_result_t constant_time_unsigned_multiply(uint16_t multiplicand, uint16_t multiplier);
+alu_result_t constant_time_unsigned_divide(uint16_t dividend, uint16_t divisor);
+alu_flags_t constant_time_compare(uint16_t value1, uint16_t value2);
+
+#endif //ALU_CONSTANT_TIME_H
@@ -0,0 +1,120 @@
+/**************************************************************************//**
+ *
+ * @file alu_extensions.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations, macros, and function prototypes that extend the
+ *      starter code's alu.h: condition flags, the carry-out adder, the barrel
+ *      shifter, and lazy flag evaluation.
+ *
+ * alu.h is starter code and is not edited. alu.c and basetwo.c include this
+ * header in its place, as does any other file that uses the extensions.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_EXTENSIONS_H
+#define ALU_EXTENSIONS_H
+
+#include "alu.h"
+
+#define ALU_WIDTH       16
+#define ALU_SIGN_BIT    (ALU_WIDTH - 1)
+
+typedef struct {
+    uint32_t sum;
+    uint8_t c_out   : 1;
+} ripple_carry_adder_t;
+
+typedef enum {
+    ALU_ADDITION,
+    ALU_SUBTRACTION
+} alu_operation_t;
+
+typedef struct {
+    uint32_t raw_result;
+    uint16_t operand1;
+    uint16_t operand2;
+    alu_operation_t operation;
+} lazy_alu_result_t;
+
+typedef uint8_t alu_flags_t;
+
+/*
+ * CONDITION FLAGS PRODUCED BY compare(), AND THE RELATIONS DERIVED FROM THEM
+ */
+
+#define ALU_ZERO_FLAG       0x1
+#define ALU_SIGN_FLAG       0x2
+#define ALU_OVERFLOW_FLAG   0x4
+#define ALU_CARRY_FLAG      0x8     // set when the subtraction borrows
+
+#define flags_equal(flags)                  (is_not_zero((flags) & ALU_ZERO_FLAG))
+#define flags_not_equal(flags)              (is_zero((flags) & ALU_ZERO_FLAG))
+#define flags_less_than(flags)              (is_zero((flags) & ALU_SIGN_FLAG) != is_zero((flags) & ALU_OVERFLOW_FLAG))
+#define flags_at_most(flags)                (flags_equal(flags) || flags_less_than(flags))
+#define flags_at_least(flags)               (!flags_less_than(flags))
+#define flags_greater_than(flags)           (!flags_at_most(flags))
+#define flags_unsigned_less_than(flags)     (is_not_zero((flags) & ALU_CARRY_FLAG))
+#define flags_unsigned_at_most(flags)       (flags_equal(flags) || flags_unsigned_less_than(flags))
+#define flags_unsigned_at_least(flags)      (!flags_unsigned_less_than(flags))
+#define flags_unsigned_greater_than(flags)  (!flags_unsigned_at_most(flags))
+
+/*
+ * UTILITY FUNCTIONS
+ */
+
+int floor_lg(uint32_t value);
+int ceil_lg(uint32_t value);
+
+/*
+ * COMPARISON FUNCTIONS
+ */
+
+bool unsigned_less_than(uint16_t value1, uint16_t value2);
+bool unsigned_at_most(uint16_t value1, uint16_t value2);
+bool unsigned_at_least(uint16_t value1, uint16_t value2);
+bool unsigned_greater_than(uint16_t value1, uint16_t value2);
+alu_flags_t compare(uint16_t value1, uint16_t value2);
+
+/*
+ * ARITHMETIC BUILDING BLOCKS
+ */
+
+ripple_carry_adder_t ripple_carry_addition_with_carry_out(uint32_t value1, uint32_t value2, uint8_t initial_carry_in);
+
+/*
+ * BARREL SHIFTER
+ */
+
+typedef enum {
+    ALU_SHIFT_LEFT,
+    ALU_SHIFT_RIGHT,                // zeroes are shifted in
+    ALU_SHIFT_RIGHT_ARITHMETIC,     // copies of the sign bit are shifted in
+    ALU_ROTATE_LEFT,
+    ALU_ROTATE_RIGHT
+} alu_shift_t;
+
+#define ALU_SHIFT_STAGES    4       // lg(ALU_WIDTH); shift amounts are taken modulo ALU_WIDTH
+
+alu_result_t barrel_shift(uint16_t value, uint8_t amount, alu_shift_t operation);
+
+/*
+ * LAZY CONDITION FLAGS
+ */
+
+lazy_alu_result_t lazy_add(uint16_t augend, uint16_t addend);
+lazy_alu_result_t lazy_subtract(uint16_t menuend, uint16_t subtrahend);
+uint16_t lazy_result(lazy_alu_result_t record);
+bool lazy_zero(lazy_alu_result_t record);
+bool lazy_negative(lazy_alu_result_t record);
+bool lazy_unsigned_overflow(lazy_alu_result_t record);
+bool lazy_signed_overflow(lazy_alu_result_t record);
+alu_result_t evaluate_lazy_flags(lazy_alu_result_t record);
+
+#endif //ALU_EXTENSIONS_H
@@ -0,0 +1,121 @@
+/**************************************************************************//**
+ *
+ * @file alu_shift.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Batch entry point for the barrel shifter.
+ *
+ * barrel_shift() takes one value through all four multiplexer stages before
+ * starting the next. Here each stage is applied to a whole block of values
+ * before the next stage starts, the way a pipelined shifter would see them,
+ * so that each stage is one branch-free loop over the block. The results
+ * match barrel_shift()'s result and supplemental_result fields.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "alu_shift.h"
+
+#define SHIFT_BLOCK     256
+
+/**
+ * Shifts or rotates each value by its own amount, as <code>barrel_shift</code> would.
+ * @param operation the kind of shift or rotation, the same for every value
+ * @param values the bit vectors to be shifted or rotated
+ * @param amounts the number of places to shift or rotate each value; only the four least-significant bits are used
+ * @param results where the shifted values are written
+ * @param shifted_out where the bits shifted out are written, as in <code>barrel_shift</code>'s
+ * <code>supplemental_result</code> field; may be <code>NULL</code>
+ * @param count the number of values
+ */
+void barrel_shift_batch(alu_shift_t operation, const uint16_t *values, const uint8_t *amounts, uint16_t *results,
+                        uint16_t *shifted_out, size_t count) {
+    bool right = (operation == ALU_SHIFT_RIGHT) || (operation == ALU_SHIFT_RIGHT_ARITHMETIC)
+                 || (operation == ALU_ROTATE_RIGHT);
+    bool rotate = (operation == ALU_ROTATE_LEFT) || (operation == ALU_ROTATE_RIGHT);
+    bool arithmetic = operation == ALU_SHIFT_RIGHT_ARITHMETIC;
+    // the shifted value is in the word's upper half after left rotations and right shifts
+    bool result_in_upper_half = rotate ? !right : right;
+    uint32_t words[SHIFT_BLOCK];
+    for (size_t start = 0; start < count; start += SHIFT_BLOCK) {
+        size_t length = count - start < SHIFT_BLOCK ? count - start : SHIFT_BLOCK;
+        const uint16_t *block_values = values + start;
+        const uint8_t *block_amounts = amounts + start;
+        for (size_t i = 0; i < length; i++) {
+            uint32_t value = block_values[i];
+            words[i] = rotate ? (value << ALU_WIDTH | value) : (right ? value << ALU_WIDTH : value);
+        }
+        for (int stage = 0; stage < ALU_SHIFT_STAGES; stage++) {
+            uint8_t select = (uint8_t) (1 << stage);
+            uint32_t fill_mask = ~(UINT32_MAX >> select);
+            for (size_t i = 0; i < length; i++) {
+                uint32_t word = words[i];
+                // during a right shift, bit 31 is still the original sign bit
+                uint32_t fill = arithmetic ? (uint32_t) -(word >> 31) & fill_mask : 0;
+                uint32_t shifted = right ? (word >> select) | fill : word << select;
+                words[i] = (block_amounts[i] & select) ? shifted : word;
+            }
+        }
+        for (size_t i = 0; i < length; i++) {
+            uint16_t upper = (uint16_t) (words[i] >> ALU_WIDTH);
+            uint16_t lower = (uint16_t) words[i];
+            results[start + i] = result_in_upper_half ? upper : lower;
+            if (shifted_out) {
+                shifted_out[start + i] = rotate ? 0 : (result_in_upper_half ? lower : upper);
+            }
+        }
+    }
+}
+
+/**
+ * Shifts or rotates a value with the host's shift instructions, producing the result and flags that
+ * <code>barrel_shift</code> is expected to produce.
+ * @param value the bit vector to be shifted or rotated
+ * @param amount the number of places to shift or rotate; only the four least-significant bits are used
+ * @param operation the kind of shift or rotation
+ * @return the expected ALU result
+ */
+alu_result_t host_shift(uint16_t value, uint8_t amount, alu_shift_t operation) {
+    alu_result_t expected = {};
+    int places = amount & 0xF;
+    uint32_t wide = (uint32_t) value << places;
+    switch (operation) {
+        case ALU_SHIFT_LEFT:
+            expected.result = (uint16_t) wide;
+            expected.supplemental_result = (uint16_t) (wide >> ALU_WIDTH);
+            expected.unsigned_overflow = places ? (value >> (ALU_WIDTH - places)) & 0x1 : 0;
+            expected.signed_overflow = (int32_t) (int16_t) value * (1 << places) != (int16_t) expected.result;
+            break;
+        case ALU_SHIFT_RIGHT:
+        case ALU_SHIFT_RIGHT_ARITHMETIC:
+            expected.result = (operation == ALU_SHIFT_RIGHT) ? (uint16_t) (value >> places)
+                                                             : (uint16_t) ((int16_t) value >> places);
+            expected.supplemental_result = places ? (uint16_t) (value << (ALU_WIDTH - places)) : 0;
+            expected.unsigned_overflow = places ? (value >> (places - 1)) & 0x1 : 0;
+            break;
+        case ALU_ROTATE_LEFT:
+            expected.result = places ? (uint16_t) (value << places | value >> (ALU_WIDTH - places)) : value;
+            expected.unsigned_overflow = places ? expected.result & 0x1 : 0;
+            break;
+        default:
+            expected.result = places ? (uint16_t) (value >> places | value << (ALU_WIDTH - places)) : value;
+            expected.unsigned_overflow = places ? expected.result >> ALU_SIGN_BIT : 0;
+            break;
+    }
+    return expected;
+}
+
+/**
+ * Names a shift or rotation, as the driver and benchmarks spell it.
+ * @param operation the kind of shift or rotation
+ * @return the operation's name
+ */
+const char *barrel_shift_name(alu_shift_t operation) {
+    static const char *names[] = {"left", "right", "arithmetic", "rotl", "rotr"};
+    return (operation <= ALU_ROTATE_RIGHT) ? names[operation] : "unknown";
+}
@@ -0,0 +1,29 @@
+/**************************************************************************//**
+ *
+ * @file alu_shift.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for shifting and rotating arrays of 16-bit values
+ *      with the barrel shifter's multiplexer stages, and for the host's own
+ *      shifts that the barrel shifter is checked against.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_SHIFT_H
+#define ALU_SHIFT_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+void barrel_shift_batch(alu_shift_t operation, const uint16_t *values, const uint8_t *amounts, uint16_t *results,
+                        uint16_t *shifted_out, size_t count);
+alu_result_t host_shift(uint16_t value, uint8_t amount, alu_shift_t operation) __attribute__ ((no_instrument_function));
+const char *barrel_shift_name(alu_shift_t operation) __attribute__ ((no_instrument_function));
+
+#endif //ALU_SHIFT_H
@@ -0,0 +1,145 @@
+/**************************************************************************//**
+ *
+ * @file alu_table.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Table-driven ALU backend for hosts where a memory lookup is cheaper
+ *      than a chain of one-bit additions.
+ *
+ * Operands are split into 8-bit chunks. One 256x256 table holds the 8-bit sum
+ * and carry-out of every pair of chunks; a carry into a chunk is added with a
+ * second lookup, pairing the partial sum with 1. Another 256x256 table holds
+ * the 16-bit product of every pair of chunks, so a 16x16-bit multiplication
+ * is four lookups whose partial products are accumulated with the sum table.
+ * Each table is 128 KiB, small enough for both to stay in a typical L2 cache.
+ * The tables are generated the first time any of these functions is called.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <pthread.h>
+#include "alu_table.h"
+
+#define CHUNK_VALUES    256
+#define CHUNK_BITS      8
+#define CHUNK_MASK      0xFF
+#define CHUNKS          (ALU_WIDTH / CHUNK_BITS)
+
+static void generate_tables(void) __attribute__ ((no_instrument_function));
+static uint32_t chunk_addition(uint32_t value1, uint32_t value2, uint32_t carry, int chunks) __attribute__ ((no_instrument_function));
+
+/* sum_table[a << 8 | b] holds a + b: the 8-bit sum in bits 0-7 and the carry-out in bit 8 */
+static uint16_t sum_table[CHUNK_VALUES * CHUNK_VALUES];
+static uint16_t product_table[CHUNK_VALUES * CHUNK_VALUES];
+static pthread_once_t tables_generated = PTHREAD_ONCE_INIT;
+
+static void generate_tables(void) {
+    for (uint32_t a = 0; a < CHUNK_VALUES; a++) {
+        for (uint32_t b = 0; b < CHUNK_VALUES; b++) {
+            sum_table[a << CHUNK_BITS | b] = (uint16_t) (a + b);
+            product_table[a << CHUNK_BITS | b] = (uint16_t) (a * b);
+        }
+    }
+}
+
+/**
+ * Generates the tables if they have not been generated yet. Every function in this backend does this itself; calling
+ * it ahead of time only moves the cost of generating the tables out of the first operation.
+ */
+void table_alu_initialize(void) {
+    pthread_once(&tables_generated, generate_tables);
+}
+
+/**
+ * Reports how much memory the backend's lookups can touch.
+ * @return the combined size of the tables in bytes
+ */
+size_t table_alu_footprint(void) {
+    return sizeof(sum_table) + sizeof(product_table);
+}
+
+/**
+ * Adds the low <code>chunks</code> 8-bit chunks of two values with the sum table.
+ * @param value1 the first number to be added
+ * @param value2 the second number to be added
+ * @param carry the carry into the least-significant chunk, 0 or 1
+ * @param chunks the number of chunks to add, at most 3 so that the carry-out fits
+ * @return the sum, with the carry out of the most-significant chunk just above it
+ */
+static uint32_t chunk_addition(uint32_t value1, uint32_t value2, uint32_t carry, int chunks) {
+    uint32_t sum = 0;
+    for (int i = 0; i < chunks; i++) {
+        uint32_t shift = (uint32_t) (CHUNK_BITS * i);
+        uint32_t partial = sum_table[((value1 >> shift) & CHUNK_MASK) << CHUNK_BITS | ((value2 >> shift) & CHUNK_MASK)];
+        // adding the incoming carry can carry out only if the partial sum did not, so the two carries never both occur
+        uint32_t carried = sum_table[(partial & CHUNK_MASK) << CHUNK_BITS | carry];
+        sum |= (carried & CHUNK_MASK) << shift;
+        carry = (partial | carried) >> CHUNK_BITS;
+    }
+    return sum | carry << (CHUNK_BITS * chunks);
+}
+
+/**
+ * Adds two 16-bit integers as two 8-bit chunks. The flags have the same meaning as those of <code>add</code>.
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @return the sum in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t table_add(uint16_t augend, uint16_t addend) {
+    alu_result_t sum = {};
+    table_alu_initialize();
+    uint32_t raw_sum = chunk_addition(augend, addend, 0, CHUNKS);
+    sum.result = (uint16_t) raw_sum;
+    sum.unsigned_overflow = (raw_sum >> ALU_WIDTH) & 0x1;
+    sum.signed_overflow = ((~(augend ^ addend) & (augend ^ sum.result)) >> ALU_SIGN_BIT) & 0x1;
+    sum.divide_by_zero = 0;
+    return sum;
+}
+
+/**
+ * Subtracts two 16-bit integers as two 8-bit chunks, adding the subtrahend's complement with a carry-in of 1. The
+ * flags have the same meaning as those of <code>subtract</code>.
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @return the difference in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t table_subtract(uint16_t menuend, uint16_t subtrahend) {
+    alu_result_t difference = {};
+    table_alu_initialize();
+    uint32_t raw_difference = chunk_addition(menuend, (uint16_t) ~subtrahend, 1, CHUNKS);
+    difference.result = (uint16_t) raw_difference;
+    difference.unsigned_overflow = (~raw_difference >> ALU_WIDTH) & 0x1;
+    difference.signed_overflow = (((menuend ^ subtrahend) & (menuend ^ difference.result)) >> ALU_SIGN_BIT) & 0x1;
+    difference.divide_by_zero = 0;
+    return difference;
+}
+
+/**
+ * Multiplies two 16-bit unsigned integers from four 8x8-bit partial products, which are accumulated with the sum
+ * table.
+ * @param multiplicand the number to be multiplied
+ * @param multiplier the number that the first is to be multiplied by
+ * @return the product in the ALU's <code>result</code> and <code>supplemental_result</code> fields
+ */
+alu_result_t table_unsigned_multiply(uint16_t multiplicand, uint16_t multiplier) {
+    alu_result_t product = {};
+    table_alu_initialize();
+    uint32_t low1 = multiplicand & CHUNK_MASK, high1 = (uint32_t) multiplicand >> CHUNK_BITS;
+    uint32_t low2 = multiplier & CHUNK_MASK, high2 = (uint32_t) multiplier >> CHUNK_BITS;
+    uint32_t low_product = product_table[low1 << CHUNK_BITS | low2];
+    uint32_t middle_product1 = product_table[low1 << CHUNK_BITS | high2];
+    uint32_t middle_product2 = product_table[high1 << CHUNK_BITS | low2];
+    uint32_t high_product = product_table[high1 << CHUNK_BITS | high2];
+    // the middle products overlap each other, so their sum is 17 bits; it is then added to bits 8-31 of the rest
+    uint32_t middle = chunk_addition(middle_product1, middle_product2, 0, CHUNKS);
+    uint32_t upper = chunk_addition((low_product >> CHUNK_BITS) | high_product << CHUNK_BITS, middle, 0, 3);
+    product.result = (uint16_t) ((upper & CHUNK_MASK) << CHUNK_BITS | (low_product & CHUNK_MASK));
+    product.supplemental_result = (uint16_t) (upper >> CHUNK_BITS);
+    product.divide_by_zero = 0;
+    return product;
+}
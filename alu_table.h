@@ -0,0 +1,29 @@
+/**************************************************************************//**
+ *
+ * @file alu_table.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for the table-driven ALU backend, which works on
+ *      8-bit chunks looked up in precomputed sum and partial-product tables.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_TABLE_H
+#define ALU_TABLE_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+void table_alu_initialize(void) __attribute__ ((no_instrument_function));
+size_t table_alu_footprint(void) __attribute__ ((no_instrument_function));
+alu_result_t table_add(uint16_t augend, uint16_t addend);
+alu_result_t table_subtract(uint16_t menuend, uint16_t subtrahend);
+alu_result_t table_unsigned_multiply(uint16_t multiplicand, uint16_t multiplier);
+
+#endif //ALU_TABLE_H
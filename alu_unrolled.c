@@ -0,0 +1,106 @@
+/**************************************************************************//**
+ *
+ * @file alu_unrolled.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Ripple-carry adders with their bit loop unrolled at compile time.
+ *
+ * ripple_carry_addition() spends more on its loop than on its work: each bit
+ * costs a call to not_equal() for the loop test and calls to lg() and
+ * exponentiate() to advance the bit index, on top of the one-bit addition.
+ * These adders are the same chain of one_bit_full_addition() calls, in the
+ * same order, written out once per bit by the preprocessor, so each bit
+ * position and its shift distance are constants. In an instrumented build the
+ * profiler still counts one one_bit_full_addition() per bit, and nothing else.
+ *
+ * Each width has a variable carry-in, and constant carry-ins of 0 (for
+ * addition) and 1 (for subtraction as a + ~b + 1), which let the compiler
+ * fold the first bit's carry. unrolled_add() and unrolled_subtract() use the
+ * 16-bit adder, which suffices for 16-bit operands because its carry-out is
+ * kept, where add() and subtract() run all 32 bits of ripple_carry_addition().
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "alu_unrolled.h"
+
+/* one bit position: the previous position's carry-out becomes this position's carry-in */
+#define UNROLLED_STEP(BIT)                                                                                             \
+    bits.a = (value1 >> (BIT)) & 0x1;                                                                                  \
+    bits.b = (value2 >> (BIT)) & 0x1;                                                                                  \
+    bits.c_in = bits.c_out;                                                                                            \
+    bits = one_bit_full_addition(bits);                                                                                \
+    sum |= (uint32_t) bits.sum << (BIT);
+
+#define UNROLLED_STEPS_4(BIT)                                                                                          \
+    UNROLLED_STEP(BIT) UNROLLED_STEP((BIT) + 1) UNROLLED_STEP((BIT) + 2) UNROLLED_STEP((BIT) + 3)
+#define UNROLLED_STEPS_8(BIT)   UNROLLED_STEPS_4(BIT) UNROLLED_STEPS_4((BIT) + 4)
+#define UNROLLED_STEPS_16(BIT)  UNROLLED_STEPS_8(BIT) UNROLLED_STEPS_8((BIT) + 8)
+#define UNROLLED_STEPS_32(BIT)  UNROLLED_STEPS_16(BIT) UNROLLED_STEPS_16((BIT) + 16)
+
+/* the carry-in enters as a carry-out, so that the first step can read it like every other step */
+#define UNROLLED_ADDER_BODY(WIDTH, CARRY_IN)                                                                           \
+    {                                                                                                                  \
+        one_bit_adder_t bits = {.c_out = (CARRY_IN) & 0x1};                                                            \
+        uint32_t sum = 0;                                                                                              \
+        ripple_carry_adder_t result;                                                                                   \
+        UNROLLED_STEPS_##WIDTH(0)                                                                                      \
+        result.sum = sum;                                                                                              \
+        result.c_out = bits.c_out;                                                                                     \
+        return result;                                                                                                 \
+    }
+
+#define UNROLLED_ADDER_DEFINITIONS(WIDTH)                                                                              \
+    ripple_carry_adder_t unrolled_addition##WIDTH(uint32_t value1, uint32_t value2, uint8_t carry_in)                  \
+    UNROLLED_ADDER_BODY(WIDTH, carry_in)                                                                               \
+                                                                                                                       \
+    ripple_carry_adder_t unrolled_addition##WIDTH##_carry0(uint32_t value1, uint32_t value2)                           \
+    UNROLLED_ADDER_BODY(WIDTH, 0)                                                                                      \
+                                                                                                                       \
+    ripple_carry_adder_t unrolled_addition##WIDTH##_carry1(uint32_t value1, uint32_t value2)                           \
+    UNROLLED_ADDER_BODY(WIDTH, 1)
+
+UNROLLED_ADDER_DEFINITIONS(8)
+UNROLLED_ADDER_DEFINITIONS(16)
+UNROLLED_ADDER_DEFINITIONS(32)
+
+/**
+ * <p>Adds two 16-bit integers with the unrolled 16-bit adder, determining the same flags as <code>add</code>.</p>
+ *
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @return the sum in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and
+ * <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t unrolled_add(uint16_t augend, uint16_t addend) {
+    alu_result_t sum = {};
+    ripple_carry_adder_t adder = unrolled_addition16_carry0(augend, addend);
+    sum.result = (uint16_t) adder.sum;
+    sum.unsigned_overflow = adder.c_out;
+    sum.signed_overflow = is_negative((uint16_t) (~(augend ^ addend) & (augend ^ sum.result)));
+    return sum;
+}
+
+/**
+ * <p>Subtracts two 16-bit integers with the unrolled 16-bit adder, as <code>a + ~b + 1</code>, determining the same
+ * flags as <code>subtract</code>.</p>
+ *
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @return the difference in the ALU's <code>result</code> field, and the <code>unsigned_overflow</code> and
+ * <code>signed_overflow</code> flags set appropriately
+ */
+alu_result_t unrolled_subtract(uint16_t menuend, uint16_t subtrahend) {
+    alu_result_t difference = {};
+    uint16_t complement = (uint16_t) ~subtrahend;
+    ripple_carry_adder_t adder = unrolled_addition16_carry1(menuend, complement);
+    difference.result = (uint16_t) adder.sum;
+    difference.unsigned_overflow = !adder.c_out;
+    difference.signed_overflow = is_negative((uint16_t) (~(menuend ^ complement) & (menuend ^ difference.result)));
+    return difference;
+}
@@ -0,0 +1,39 @@
+/**************************************************************************//**
+ *
+ * @file alu_unrolled.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for ripple-carry adders that are unrolled at
+ *      compile time for 8-, 16-, and 32-bit operands.
+ *
+ * UNROLLED_ADDER_FAMILY(8) declares unrolled_addition8(), which takes its
+ * carry-in as an argument, and unrolled_addition8_carry0() and
+ * unrolled_addition8_carry1(), whose carry-ins are constants; alu_unrolled.c
+ * instantiates the matching definitions for each width.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_UNROLLED_H
+#define ALU_UNROLLED_H
+
+#include "alu_extensions.h"
+
+#define UNROLLED_ADDER_FAMILY(WIDTH)                                                                                   \
+    ripple_carry_adder_t unrolled_addition##WIDTH(uint32_t value1, uint32_t value2, uint8_t carry_in);                 \
+    ripple_carry_adder_t unrolled_addition##WIDTH##_carry0(uint32_t value1, uint32_t value2);                          \
+    ripple_carry_adder_t unrolled_addition##WIDTH##_carry1(uint32_t value1, uint32_t value2);
+
+UNROLLED_ADDER_FAMILY(8)
+UNROLLED_ADDER_FAMILY(16)
+UNROLLED_ADDER_FAMILY(32)
+
+alu_result_t unrolled_add(uint16_t augend, uint16_t addend);
+alu_result_t unrolled_subtract(uint16_t menuend, uint16_t subtrahend);
+
+#endif //ALU_UNROLLED_H
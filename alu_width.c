@@ -0,0 +1,148 @@
+/**************************************************************************//**
+ *
+ * @file alu_width.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief The 8-, 16-, 32-, and 64-bit ALU family, generated from one
+ *      macro-based definition.
+ *
+ * Each width is specialised at compile time: the operand type, the sign-bit
+ * position, and the loop bounds all come from the WIDTH parameter, so no
+ * width-specific literal appears in the definition. Additions use a
+ * parallel-prefix carry network, which takes log2(WIDTH) word-wide steps;
+ * wider operands therefore need fewer operations per byte, while narrower
+ * operands pack more values into each batch.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "alu_width.h"
+
+/*
+ * For each width, ALU_WIDTH_DEFINITIONS defines:
+ *
+ *  aluN_prefix_addition    adds two N-bit values and a carry-in, reporting the carry out of the most-significant bit
+ *  aluN_is_negative        determines whether the N-bit value's sign bit is set
+ *  aluN_add                as add(), with N-bit operands
+ *  aluN_subtract           as subtract(), with N-bit operands
+ *  aluN_unsigned_multiply  the 2N-bit product, its low half in result and its high half in supplemental_result
+ *  aluN_unsigned_divide    the quotient in result and the remainder in supplemental_result; unlike unsigned_divide(),
+ *                              the divisor need not be a power of two
+ *  aluN_compare            as compare(), with N-bit operands
+ *  aluN_add_batch          the sums (without flags) of corresponding elements of two arrays
+ *  aluN_subtract_batch     the differences (without flags) of corresponding elements of two arrays
+ */
+
+#define ALU_WIDTH_DEFINITIONS(WIDTH, UTYPE)                                                                            \
+    static UTYPE alu##WIDTH##_prefix_addition(UTYPE value1, UTYPE value2, UTYPE carry_in, UTYPE *carry_out)            \
+            __attribute__ ((no_instrument_function));                                                                  \
+                                                                                                                       \
+    static UTYPE alu##WIDTH##_prefix_addition(UTYPE value1, UTYPE value2, UTYPE carry_in, UTYPE *carry_out) {          \
+        UTYPE propagate = value1 ^ value2;                                                                             \
+        /* the carry-in can only be generated into bit 0 */                                                            \
+        UTYPE generate = (UTYPE) ((value1 & value2) | (propagate & carry_in & 0x1));                                   \
+        UTYPE group_propagate = propagate;                                                                             \
+        for (int distance = 1; distance < WIDTH; distance <<= 1) {                                                     \
+            generate |= (UTYPE) (group_propagate & (UTYPE) (generate << distance));                                    \
+            group_propagate &= (UTYPE) (group_propagate << distance);                                                  \
+        }                                                                                                              \
+        /* now bit i of generate is the carry out of bit position i */                                                 \
+        *carry_out = (UTYPE) (generate >> (WIDTH - 1));                                                                \
+        return (UTYPE) (propagate ^ (UTYPE) ((UTYPE) (generate << 1) | (carry_in & 0x1)));                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    bool alu##WIDTH##_is_negative(UTYPE value) {                                                                       \
+        return (value >> (WIDTH - 1)) & 0x1;                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    alu##WIDTH##_result_t alu##WIDTH##_add(UTYPE augend, UTYPE addend) {                                               \
+        alu##WIDTH##_result_t sum = {};                                                                                \
+        UTYPE carry;                                                                                                   \
+        sum.result = alu##WIDTH##_prefix_addition(augend, addend, 0, &carry);                                          \
+        sum.unsigned_overflow = carry;                                                                                 \
+        sum.signed_overflow = alu##WIDTH##_is_negative((UTYPE) (~(augend ^ addend) & (augend ^ sum.result)));          \
+        sum.divide_by_zero = 0;                                                                                        \
+        return sum;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    alu##WIDTH##_result_t alu##WIDTH##_subtract(UTYPE menuend, UTYPE subtrahend) {                                     \
+        alu##WIDTH##_result_t difference = {};                                                                         \
+        UTYPE carry;                                                                                                   \
+        difference.result = alu##WIDTH##_prefix_addition(menuend, (UTYPE) ~subtrahend, 1, &carry);                     \
+        difference.unsigned_overflow = !carry;                                                                         \
+        difference.signed_overflow =                                                                                   \
+                alu##WIDTH##_is_negative((UTYPE) ((menuend ^ subtrahend) & (menuend ^ difference.result)));            \
+        difference.divide_by_zero = 0;                                                                                 \
+        return difference;                                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    alu##WIDTH##_result_t alu##WIDTH##_unsigned_multiply(UTYPE multiplicand, UTYPE multiplier) {                       \
+        alu##WIDTH##_result_t product = {};                                                                            \
+        UTYPE low = 0, high = 0;                                                                                       \
+        for (int i = 0; i < WIDTH; i++) {                                                                              \
+            UTYPE mask = (UTYPE) (0 - (UTYPE) ((multiplier >> i) & 0x1));                                              \
+            UTYPE partial_low = (UTYPE) (multiplicand << i) & mask;                                                    \
+            /* two shifts, because shifting by WIDTH is undefined */                                                   \
+            UTYPE partial_high = (UTYPE) ((multiplicand >> 1) >> (WIDTH - 1 - i)) & mask;                              \
+            UTYPE carry;                                                                                               \
+            low = alu##WIDTH##_prefix_addition(low, partial_low, 0, &carry);                                           \
+            high = alu##WIDTH##_prefix_addition(high, partial_high, carry, &carry);                                    \
+        }                                                                                                              \
+        product.result = low;                                                                                          \
+        product.supplemental_result = high;                                                                            \
+        product.divide_by_zero = 0;                                                                                    \
+        return product;                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    alu##WIDTH##_result_t alu##WIDTH##_unsigned_divide(UTYPE dividend, UTYPE divisor) {                                \
+        alu##WIDTH##_result_t quotient = {};                                                                           \
+        UTYPE remainder = 0, quotient_bits = 0;                                                                        \
+        for (int i = WIDTH - 1; i >= 0; i--) {                                                                         \
+            /* the bit shifted out of the remainder makes it larger than any divisor */                                \
+            UTYPE shifted_out = (UTYPE) (remainder >> (WIDTH - 1));                                                    \
+            remainder = (UTYPE) ((UTYPE) (remainder << 1) | ((dividend >> i) & 0x1));                                  \
+            UTYPE carry;                                                                                               \
+            UTYPE trial = alu##WIDTH##_prefix_addition(remainder, (UTYPE) ~divisor, 1, &carry);                        \
+            UTYPE no_borrow = carry | shifted_out;                                                                     \
+            UTYPE mask = (UTYPE) (0 - no_borrow);                                                                      \
+            remainder = (UTYPE) ((trial & mask) | (remainder & (UTYPE) ~mask));                                        \
+            quotient_bits |= (UTYPE) (no_borrow << i);                                                                 \
+        }                                                                                                              \
+        quotient.result = quotient_bits;                                                                               \
+        quotient.supplemental_result = remainder;                                                                      \
+        quotient.divide_by_zero = !divisor;                                                                            \
+        return quotient;                                                                                               \
+    }                                                                                                                  \
+                                                                                                                       \
+    alu_flags_t alu##WIDTH##_compare(UTYPE value1, UTYPE value2) {                                                     \
+        alu##WIDTH##_result_t difference = alu##WIDTH##_subtract(value1, value2);                                      \
+        return (alu_flags_t) ((is_zero(difference.result) ? ALU_ZERO_FLAG : 0)                                         \
+                              | (alu##WIDTH##_is_negative(difference.result) ? ALU_SIGN_FLAG : 0)                      \
+                              | (difference.signed_overflow ? ALU_OVERFLOW_FLAG : 0)                                   \
+                              | (difference.unsigned_overflow ? ALU_CARRY_FLAG : 0));                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    void alu##WIDTH##_add_batch(const UTYPE *augends, const UTYPE *addends, UTYPE *sums, size_t count) {               \
+        for (size_t i = 0; i < count; i++) {                                                                           \
+            UTYPE carry;                                                                                               \
+            sums[i] = alu##WIDTH##_prefix_addition(augends[i], addends[i], 0, &carry);                                 \
+        }                                                                                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+    void alu##WIDTH##_subtract_batch(const UTYPE *menuends, const UTYPE *subtrahends, UTYPE *differences,              \
+                                     size_t count) {                                                                   \
+        for (size_t i = 0; i < count; i++) {                                                                           \
+            UTYPE carry;                                                                                               \
+            differences[i] = alu##WIDTH##_prefix_addition(menuends[i], (UTYPE) ~subtrahends[i], 1, &carry);            \
+        }                                                                                                              \
+    }
+
+ALU_WIDTH_DEFINITIONS(8, uint8_t)
+ALU_WIDTH_DEFINITIONS(16, uint16_t)
+ALU_WIDTH_DEFINITIONS(32, uint32_t)
+ALU_WIDTH_DEFINITIONS(64, uint64_t)
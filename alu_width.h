@@ -0,0 +1,51 @@
+/**************************************************************************//**
+ *
+ * @file alu_width.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for the 8-, 16-, 32-, and
+ *      64-bit ALU family, all generated from one macro-based definition.
+ *
+ * ALU_WIDTH_FAMILY(8, uint8_t) declares alu8_result_t, alu8_add(), and so on;
+ * alu_width.c instantiates the matching definitions for each width.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef ALU_WIDTH_H
+#define ALU_WIDTH_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+#define ALU_WIDTH_FAMILY(WIDTH, UTYPE)                                                                                 \
+    typedef struct {                                                                                                   \
+        UTYPE result;                                                                                                  \
+        UTYPE supplemental_result;                                                                                     \
+        uint8_t unsigned_overflow   : 1;                                                                               \
+        uint8_t signed_overflow     : 1;                                                                               \
+        uint8_t divide_by_zero      : 1;                                                                               \
+    } alu##WIDTH##_result_t;                                                                                           \
+                                                                                                                       \
+    bool alu##WIDTH##_is_negative(UTYPE value);                                                                        \
+    alu##WIDTH##_result_t alu##WIDTH##_add(UTYPE augend, UTYPE addend);                                                \
+    alu##WIDTH##_result_t alu##WIDTH##_subtract(UTYPE menuend, UTYPE subtrahend);                                      \
+    alu##WIDTH##_result_t alu##WIDTH##_unsigned_multiply(UTYPE multiplicand, UTYPE multiplier);                        \
+    alu##WIDTH##_result_t alu##WIDTH##_unsigned_divide(UTYPE dividend, UTYPE divisor);                                 \
+    alu_flags_t alu##WIDTH##_compare(UTYPE value1, UTYPE value2);                                                      \
+                                                                                                                       \
+    void alu##WIDTH##_add_batch(const UTYPE *augends, const UTYPE *addends, UTYPE *sums, size_t count);                \
+    void alu##WIDTH##_subtract_batch(const UTYPE *menuends, const UTYPE *subtrahends, UTYPE *differences,              \
+                                     size_t count);
+
+ALU_WIDTH_FAMILY(8, uint8_t)
+ALU_WIDTH_FAMILY(16, uint16_t)
+ALU_WIDTH_FAMILY(32, uint32_t)
+ALU_WIDTH_FAMILY(64, uint64_t)
+
+#endif //ALU_WIDTH_H
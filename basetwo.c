@@ -15,7 +15,7 @@
  * IntegerLab solution (c) the above-named student(s)
  */
 
-#include "alu.h"
+#include "alu_extensions.h"
 
 /**
  * Computes a power of two, specifically, the value of 2 raised to the power of <code>exponent</code>.
@@ -33,47 +33,37 @@ uint32_t exponentiate(int exponent) {
 
 /**
  * Determines the base-two logarithm of an integer that is a power of two.
- * foo == exponentiate(bar) \<--> bar == lg(foo). The argument must be a positive power of two.
+ * foo == exponentiate(bar) \<--> bar == lg(foo). The argument must be a positive power of two; for any other
+ * argument, this function returns 0.
  * @param power_of_two the value whose logarithm will be determined
  * @return base-2 logarithm of the argument
  */
 int lg(uint32_t power_of_two) {
-    switch (power_of_two) {
-        case 0x1 :
-            return 0;
-        case 0x2 :
-            return 1;
-        case 0x4: return 2;
-        case 0x8: return 3;
-        case 0x10: return 4;
-        case 0x20: return 5;
-        case 0x40: return 6;
-        case 0x80: return 7;
-        case 0x100: return 8;
-        case 0x200: return 9;
-        case 0x400: return 10;
-        case 0x800: return 11;
-        case 0x1000: return 12;
-        case 0x2000: return 13;
-        case 0x4000: return 14;
-        case 0x8000: return 15;
-        case 0x10000: return 16;
-        case 0x20000: return 17;
-        case 0x40000: return 18;
-        case 0x80000: return 19;
-        case 0x100000: return 20;
-        case 0x200000: return 21;
-        case 0x400000: return 22;
-        case 0x800000: return 23;
-        case 0x1000000: return 24;
-        case 0x2000000: return 25;
-        case 0x4000000: return 26;
-        case 0x8000000: return 27;
-        case 0x10000000: return 28;
-        case 0x20000000: return 29;
-        case 0x40000000: return 30;
-        case 0x80000000: return 31;
-        default :
-            return 0;
-    }
-}
\ No newline at end of file
+    // A power of two's logarithm is the number of zeroes below its one bit; the extra bit keeps 0 well-defined, and
+    // the select compiles to a conditional move rather than a branch
+    int trailing_zeroes = __builtin_ctzll((uint64_t) power_of_two | 0x100000000);
+    return (__builtin_popcount(power_of_two) == 1) ? trailing_zeroes : 0;
+}
+
+/**
+ * Determines the base-two logarithm of an integer, rounded down: the position of its most-significant one bit.
+ * floor_lg(0) is 0.
+ * @param value the value whose logarithm will be determined
+ * @return the greatest integer that is no greater than the base-2 logarithm of the argument
+ */
+int floor_lg(uint32_t value) {
+    // The leading zeroes of a 64-bit word are between 0 and 63, so 63 ^ leading_zeroes is 63 less them
+    return 63 ^ __builtin_clzll((uint64_t) value | 0x1);
+}
+
+/**
+ * Determines the base-two logarithm of an integer, rounded up: the exponent of the least power of two that is no less
+ * than the value. ceil_lg(0) is 0.
+ * @param value the value whose logarithm will be determined
+ * @return the least integer that is no less than the base-2 logarithm of the argument
+ */
+int ceil_lg(uint32_t value) {
+    // Doubling a value that is not a power of two moves its most-significant bit to the rounded-up logarithm
+    uint64_t rounded = (uint64_t) value << (__builtin_popcount(value) > 1);
+    return 63 ^ __builtin_clzll(rounded | 0x1);
+}
@@ -0,0 +1,87 @@
+/**************************************************************************//**
+ *
+ * @file basetwo_batch.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Batch versions of lg() and exponentiate().
+ *
+ * With SSE2, four values are converted at a time through single-precision
+ * floating point, whose exponent field holds a power of two's logarithm
+ * biased by 127: lg reads the field of the converted power of two, and
+ * exponentiate writes the field and converts back. Values left over at the
+ * end of an array, and every value on hosts without SSE2, go through the
+ * scalar functions. Both batch functions return exactly what the scalar
+ * functions do, including 0 from lg for values that are not powers of two.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "basetwo_batch.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define LANES                   4
+#define FLOAT_MANTISSA_BITS     23
+#define FLOAT_EXPONENT_MASK     0xFF
+#define FLOAT_EXPONENT_BIAS     127
+#define EXPONENT_MASK           31
+
+/**
+ * Determines the base-two logarithm of each value, as <code>lg</code> would.
+ * @param powers_of_two the values whose logarithms will be determined
+ * @param exponents where the logarithms are written; 0 for values that are not positive powers of two
+ * @param count the number of values
+ */
+void lg_batch(const uint32_t *powers_of_two, int32_t *exponents, size_t count) {
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i all_ones = _mm_set1_epi32(-1);
+    const __m128i exponent_mask = _mm_set1_epi32(FLOAT_EXPONENT_MASK);
+    const __m128i bias = _mm_set1_epi32(FLOAT_EXPONENT_BIAS);
+    for (; i + LANES <= count; i += LANES) {
+        __m128i values = _mm_loadu_si128((const __m128i *) (powers_of_two + i));
+        // the conversion is signed, but 2**31 becomes -2**31, which differs only in the sign bit that is masked off
+        __m128i bits = _mm_castps_si128(_mm_cvtepi32_ps(values));
+        __m128i exponent = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(bits, FLOAT_MANTISSA_BITS), exponent_mask),
+                                         bias);
+        // a power of two has one bit set: it is not zero, and clearing its lowest set bit leaves zero
+        __m128i single_bit = _mm_cmpeq_epi32(_mm_and_si128(values, _mm_add_epi32(values, all_ones)), zero);
+        __m128i power = _mm_andnot_si128(_mm_cmpeq_epi32(values, zero), single_bit);
+        _mm_storeu_si128((__m128i *) (exponents + i), _mm_and_si128(exponent, power));
+    }
+#endif
+    for (; i < count; i++) {
+        exponents[i] = lg(powers_of_two[i]);
+    }
+}
+
+/**
+ * Computes 2 raised to the power of each exponent, as <code>exponentiate</code> would.
+ * @param exponents the exponents; only the five least-significant bits of each are used
+ * @param powers_of_two where the powers of two are written
+ * @param count the number of exponents
+ */
+void exponentiate_batch(const int32_t *exponents, uint32_t *powers_of_two, size_t count) {
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i exponent_mask = _mm_set1_epi32(EXPONENT_MASK);
+    const __m128i bias = _mm_set1_epi32(FLOAT_EXPONENT_BIAS);
+    for (; i + LANES <= count; i += LANES) {
+        __m128i exponent = _mm_and_si128(_mm_loadu_si128((const __m128i *) (exponents + i)), exponent_mask);
+        __m128 power = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, bias), FLOAT_MANTISSA_BITS));
+        // 2**31 is out of range for the signed conversion, which then produces 0x80000000: exactly 2**31 unsigned
+        _mm_storeu_si128((__m128i *) (powers_of_two + i), _mm_cvttps_epi32(power));
+    }
+#endif
+    for (; i < count; i++) {
+        powers_of_two[i] = exponentiate(exponents[i]);
+    }
+}
@@ -0,0 +1,26 @@
+/**************************************************************************//**
+ *
+ * @file basetwo_batch.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for computing powers of two and their logarithms
+ *      over arrays, several values per instruction where the host allows.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef BASETWO_BATCH_H
+#define BASETWO_BATCH_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+void lg_batch(const uint32_t *powers_of_two, int32_t *exponents, size_t count) __attribute__ ((no_instrument_function));
+void exponentiate_batch(const int32_t *exponents, uint32_t *powers_of_two, size_t count) __attribute__ ((no_instrument_function));
+
+#endif //BASETWO_BATCH_H
@@ -0,0 +1,1759 @@
+/**************************************************************************//**
+ *
+ * @file benchmark.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Timing helpers, and the benchmarks that the driver can run.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <inttypes.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "alu_extensions.h"
+#include "alu_constant_time.h"
+#include "alu_table.h"
+#include "alu_unrolled.h"
+#include "alu_batch.h"
+#include "predicate.h"
+#include "alu_shift.h"
+#include "gates.h"
+#include "basetwo_batch.h"
+#include "float16.h"
+#include "q15.h"
+#include "swar.h"
+#include "alu_width.h"
+#include "bignum.h"
+#include "expression.h"
+#include "cpu.h"
+#include "trace.h"
+#include "server.h"
+#include "pipeline.h"
+#include "formatter.h"
+#include "authoritative_results.h"
+#include "profiler.h"
+#include "sampler.h"
+#include "benchmark.h"
+
+#define TIMING_SAMPLES              256
+#define TIMING_TRIALS               101
+#define TIMING_ATTEMPTS             3
+#define CONSTANT_TIME_TOLERANCE     0.10
+#define THROUGHPUT_WORDS            (1 << 16)
+#define THROUGHPUT_REPETITIONS      64
+#define THROUGHPUT_BYTES            (1 << 20)
+#define BIGNUM_SMALLEST_BITS        256
+#define BIGNUM_LARGEST_BITS         8192
+#define BIGNUM_SCHOOLBOOK_BITS      2048    // schoolbook multiplication is too slow to time beyond this
+#define EXPRESSION_BINDINGS         (1 << 16)
+#define EXPRESSION_RECOMPILATIONS   (1 << 14)
+#define TRACE_BENCHMARK_PATH        "/tmp/integerlab-benchmark.trace"
+#define TRACE_BENCHMARK_WORKLOAD    1       // sort
+#define SERVER_BENCHMARK_PATH       "/tmp/integerlab-benchmark.sock"
+#define SERVER_BENCHMARK_CLIENTS    4
+#define SERVER_BENCHMARK_BATCHES    32      // each client sends all of its batches before reading any response
+#define SERVER_BENCHMARK_OPERATIONS 256
+#define PIPELINE_BENCHMARK_LINES    (1 << 14)
+#define FORMAT_BENCHMARK_CHECKS     (1 << 14)
+#define TABLE_BENCHMARK_OPERATIONS  (1 << 16)
+#define TABLE_NARROW_OPERAND        0xF     // narrow operands keep every lookup in a few cache lines
+#define PREDICATE_BENCHMARK_VALUES  ((1 << 20) + 37)    // not a multiple of 64, so the partial block is exercised
+#define PREDICATE_ALU_CHECKS        2048    // elements checked against the ALU's own relations
+#define SHIFT_BENCHMARK_VALUES      (1 << 16)
+#define GATE_BENCHMARK_PAIRS        2000
+#define LG_BENCHMARK_VALUES         (1 << 16)
+#define FLOAT16_BENCHMARK_PAIRS     4096
+#define Q15_BENCHMARK_SAMPLES       1024
+#define Q15_BENCHMARK_TAPS          16
+#define Q15_BENCHMARK_WINDOW        16      // a power of two
+#define Q15_BENCHMARK_FFT_POINTS    256
+#define Q15_BENCHMARK_PI            3.14159265358979323846
+#define SAMPLER_BENCHMARK_PAIRS     (1 << 12)
+#define SAMPLER_BENCHMARK_PASSES    8       // enough CPU time for about a hundred of the timer's ticks
+#define SAMPLER_BENCHMARK_FUNCTIONS 12      // lines of the flat report that are printed
+#define INLINE_BENCHMARK_PAIRS      4096
+#define UNROLLED_BENCHMARK_PAIRS    (1 << 14)
+#define UNROLLED_BENCHMARK_ADDERS   10      // the loop, then three variants of each of three widths
+
+typedef alu_result_t (*binary_operation_t)(uint16_t, uint16_t);
+
+enum operand_class {
+    ZEROS = 0,
+    ONES,
+    ALTERNATING,
+    POWERS_OF_TWO,
+    RANDOM,
+    NUMBER_OF_OPERAND_CLASSES
+};
+
+static const char *operand_class_names[NUMBER_OF_OPERAND_CLASSES] = {
+        "zeros", "ones", "0xAAAA", "2^k", "random"
+};
+
+static void fill_operands(enum operand_class operand_class, uint16_t *operands, int count, uint32_t *seed) __attribute__ ((no_instrument_function));
+static double time_operation(binary_operation_t operation, const uint16_t *operands1, const uint16_t *operands2) __attribute__ ((no_instrument_function));
+static double measure_operation(binary_operation_t operation, double latencies[NUMBER_OF_OPERAND_CLASSES]) __attribute__ ((no_instrument_function));
+static alu_result_t compare_as_result(uint16_t value1, uint16_t value2) __attribute__ ((no_instrument_function));
+static alu_result_t constant_time_compare_as_result(uint16_t value1, uint16_t value2) __attribute__ ((no_instrument_function));
+
+static void benchmark_swar(void) __attribute__ ((no_instrument_function));
+static void benchmark_width(void) __attribute__ ((no_instrument_function));
+static void benchmark_bignum(void) __attribute__ ((no_instrument_function));
+static void benchmark_expression(void) __attribute__ ((no_instrument_function));
+static void benchmark_cpu(void) __attribute__ ((no_instrument_function));
+static void benchmark_trace(void) __attribute__ ((no_instrument_function));
+static void benchmark_server(void) __attribute__ ((no_instrument_function));
+static void benchmark_pipeline(void) __attribute__ ((no_instrument_function));
+static void benchmark_format(void) __attribute__ ((no_instrument_function));
+static void benchmark_table(void) __attribute__ ((no_instrument_function));
+static void benchmark_predicate(void) __attribute__ ((no_instrument_function));
+static void benchmark_shift(void) __attribute__ ((no_instrument_function));
+static void benchmark_gates(void) __attribute__ ((no_instrument_function));
+static void benchmark_lg(void) __attribute__ ((no_instrument_function));
+static void benchmark_float16(void) __attribute__ ((no_instrument_function));
+static void benchmark_unrolled(void) __attribute__ ((no_instrument_function));
+static void benchmark_q15(void) __attribute__ ((no_instrument_function));
+static void benchmark_inline(void) __attribute__ ((no_instrument_function));
+static void benchmark_sampler(void) __attribute__ ((no_instrument_function));
+static uint16_t sampled_workload(const uint16_t *operands1, const uint16_t *operands2) __attribute__ ((no_instrument_function));
+static alu_result_t out_of_line(alu_batch_operation_t operation, uint16_t operand1, uint16_t operand2) __attribute__ ((no_instrument_function));
+static int64_t reference_accumulate(int64_t accumulator, int64_t addend) __attribute__ ((no_instrument_function));
+static q15_t reference_narrow(int64_t accumulator, int places) __attribute__ ((no_instrument_function));
+static void reference_butterfly(q15_complex_t *top, q15_complex_t *bottom, q15_complex_t twiddle) __attribute__ ((no_instrument_function));
+static ripple_carry_adder_t unrolled_adder(int adder, uint32_t value1, uint32_t value2, uint8_t carry_in) __attribute__ ((no_instrument_function));
+static int switch_lg(uint32_t power_of_two);     // instrumented like lg(), so that both pay for the profiler's hook
+static int reference_floor_lg(uint64_t value) __attribute__ ((no_instrument_function));
+static bool alu_relation(predicate_t predicate, uint16_t value1, uint16_t value2) __attribute__ ((no_instrument_function));
+static int print_sum_check(FILE *stream, const format_arithmetic_t *check) __attribute__ ((no_instrument_function));
+static double time_workload(cpu_t *cpu, const cpu_workload_t *workload) __attribute__ ((no_instrument_function));
+static void *serve(void *path) __attribute__ ((no_instrument_function));
+static int connect_to_server(const char *path) __attribute__ ((no_instrument_function));
+static bool transfer(int socket, void *buffer, size_t length, bool sending) __attribute__ ((no_instrument_function));
+static void *server_client(void *mismatches) __attribute__ ((no_instrument_function));
+static void scalar_add_batch(const uint16_t *augends, const uint16_t *addends, uint16_t *sums,
+                             uint16_t *unsigned_overflows, uint16_t *signed_overflows, size_t count) __attribute__ ((no_instrument_function));
+
+static volatile uint16_t benchmark_sink;
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+    const char *description;
+} benchmarks[] = {
+        {"q15", benchmark_q15, "Q15 saturating arithmetic, dot product, FIR, moving average, and FFT, in samples/s"},
+        {"swar", benchmark_swar, "4x16-bit SWAR addition against the ALU and a lane-at-a-time loop"},
+        {"width", benchmark_width, "8-, 16-, 32-, and 64-bit batch addition over the same number of bytes"},
+        {"bignum", benchmark_bignum, "multi-limb addition, subtraction, multiplication, and division from 256 to 8192 bits"},
+        {"expression", benchmark_expression, "one compiled formula over many variable bindings, against reparsing"},
+        {"cpu", benchmark_cpu, "simulated instructions per second on each of the CPU's workloads"},
+        {"trace", benchmark_trace, "a CPU workload with and without recording, then replay of its trace"},
+        {"pipeline", benchmark_pipeline, "a generated script on 0 (sequential) to 4 pipelined evaluator threads"},
+        {"table", benchmark_table, "the 8-bit table-driven backend against the ripple-carry and constant-time ALUs"},
+        {"sampler", benchmark_sampler, "the sampling profiler's overhead, and its breakdown of an ALU workload"},
+        {"inline", benchmark_inline, "batch loops with the ALU inlined against calls to the instrumented ALU"},
+        {"unrolled", benchmark_unrolled, "unrolled 8-, 16-, and 32-bit ripple-carry adders against the loop, with call counts"},
+        {"float16", benchmark_float16, "binary16 and bfloat16 arithmetic on the ALU, in FLOP/s, against the host"},
+        {"lg", benchmark_lg, "branch-free and batch lg and exponentiate against a switch, and floor_lg/ceil_lg"},
+        {"gates", benchmark_gates, "gate counts and critical-path depths of each operation over random operands"},
+        {"shift", benchmark_shift, "the barrel shifter, one value at a time and in batches, and power-of-two division"},
+        {"predicate", benchmark_predicate, "batch comparisons to bitmasks with each kernel, then counting and compaction"},
+        {"format", benchmark_format, "printf against the hand-rolled formatter in each verbosity, on addition checks"},
+        {"server", benchmark_server, "pipelined batches from concurrent clients of the ALU server, checked against the ALU"},
+};
+
+/**
+ * Reads a monotonic clock.
+ * @return the current time in nanoseconds, relative to an unspecified epoch
+ */
+uint64_t benchmark_nanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * Generates a pseudorandom number (xorshift32), so that benchmarks are repeatable from run to run.
+ * @param state the generator's state, which must not be zero; it is updated in place
+ * @return the next pseudorandom number
+ */
+uint32_t benchmark_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void fill_operands(enum operand_class operand_class, uint16_t *operands, int count, uint32_t *seed) {
+    for (int i = 0; i < count; i++) {
+        switch (operand_class) {
+            case ZEROS:
+                operands[i] = 0x0000;
+                break;
+            case ONES:
+                operands[i] = 0xFFFF;
+                break;
+            case ALTERNATING:
+                operands[i] = 0xAAAA;
+                break;
+            case POWERS_OF_TWO:
+                operands[i] = (uint16_t) (1 << (benchmark_random(seed) & 0xF));
+                break;
+            default:
+                operands[i] = (uint16_t) benchmark_random(seed);
+        }
+    }
+}
+
+static double time_operation(binary_operation_t operation, const uint16_t *operands1, const uint16_t *operands2) {
+    uint16_t accumulator = 0;
+    uint64_t start = benchmark_nanoseconds();
+    for (int i = 0; i < TIMING_SAMPLES; i++) {
+        accumulator ^= operation(operands1[i], operands2[i]).result;
+    }
+    uint64_t elapsed = benchmark_nanoseconds() - start;
+    benchmark_sink = accumulator;
+    return (double) elapsed / TIMING_SAMPLES;
+}
+
+static double measure_operation(binary_operation_t operation, double latencies[NUMBER_OF_OPERAND_CLASSES]) {
+    uint16_t *operands1 = malloc(NUMBER_OF_OPERAND_CLASSES * TIMING_SAMPLES * sizeof(uint16_t));
+    uint16_t *operands2 = malloc(NUMBER_OF_OPERAND_CLASSES * TIMING_SAMPLES * sizeof(uint16_t));
+    uint32_t seed = 0x1D872B41;
+    for (int operand_class = 0; operand_class < NUMBER_OF_OPERAND_CLASSES; operand_class++) {
+        fill_operands(operand_class, operands1 + operand_class * TIMING_SAMPLES, TIMING_SAMPLES, &seed);
+        fill_operands(operand_class, operands2 + operand_class * TIMING_SAMPLES, TIMING_SAMPLES, &seed);
+        latencies[operand_class] = -1.0;
+    }
+    // interleave the operand classes so that clock-frequency drift affects each of them equally
+    for (int trial = 0; trial < TIMING_TRIALS; trial++) {
+        for (int operand_class = 0; operand_class < NUMBER_OF_OPERAND_CLASSES; operand_class++) {
+            double latency = time_operation(operation, operands1 + operand_class * TIMING_SAMPLES,
+                                            operands2 + operand_class * TIMING_SAMPLES);
+            if (latencies[operand_class] < 0 || latency < latencies[operand_class]) {
+                latencies[operand_class] = latency;
+            }
+        }
+    }
+    double fastest = latencies[0], slowest = latencies[0];
+    for (int operand_class = 1; operand_class < NUMBER_OF_OPERAND_CLASSES; operand_class++) {
+        fastest = latencies[operand_class] < fastest ? latencies[operand_class] : fastest;
+        slowest = latencies[operand_class] > slowest ? latencies[operand_class] : slowest;
+    }
+    free(operands1);
+    free(operands2);
+    return (slowest - fastest) / fastest;
+}
+
+static alu_result_t compare_as_result(uint16_t value1, uint16_t value2) {
+    alu_result_t flags = {};
+    flags.result = compare(value1, value2);
+    return flags;
+}
+
+static alu_result_t constant_time_compare_as_result(uint16_t value1, uint16_t value2) {
+    alu_result_t flags = {};
+    flags.result = constant_time_compare(value1, value2);
+    return flags;
+}
+
+/**
+ * Times each constant-time operation on several classes of operands and reports whether its latency stays within
+ * tolerance of its fastest class. The bitwise ALU's data-dependent operations are timed alongside for contrast.
+ */
+void evaluate_print_constant_time_check(void) {
+    struct {
+        const char *name;
+        binary_operation_t operation;
+        bool is_constant_time;
+    } operations[] = {
+            {"constant_time_add",               constant_time_add,               true},
+            {"constant_time_subtract",          constant_time_subtract,          true},
+            {"constant_time_unsigned_multiply", constant_time_unsigned_multiply, true},
+            {"constant_time_unsigned_divide",   constant_time_unsigned_divide,   true},
+            {"constant_time_compare",           constant_time_compare_as_result, true},
+            {"add (reference)",                 add,                             false},
+            {"unsigned_multiply (reference)",   unsigned_multiply,               false},
+            {"compare (reference)",             compare_as_result,               false},
+    };
+    int number_of_operations = sizeof(operations) / sizeof(operations[0]);
+    int failures = 0;
+    printf("LATENCY BY OPERAND CLASS (ns per call, best of %d trials of %d calls)\n", TIMING_TRIALS, TIMING_SAMPLES);
+    printf("\t%-34s", "operation");
+    for (int operand_class = 0; operand_class < NUMBER_OF_OPERAND_CLASSES; operand_class++) {
+        printf("%10s", operand_class_names[operand_class]);
+    }
+    printf("%11s\n", "spread");
+    for (int i = 0; i < number_of_operations; i++) {
+        double latencies[NUMBER_OF_OPERAND_CLASSES];
+        double spread = measure_operation(operations[i].operation, latencies);
+        // interference from other processes can only make the latencies look less uniform, never more,
+        // so a constant-time operation is re-measured before it is declared to have failed
+        for (int attempt = 1; operations[i].is_constant_time && attempt < TIMING_ATTEMPTS
+                              && spread > CONSTANT_TIME_TOLERANCE; attempt++) {
+            spread = measure_operation(operations[i].operation, latencies);
+        }
+        printf("\t%-34s", operations[i].name);
+        for (int operand_class = 0; operand_class < NUMBER_OF_OPERAND_CLASSES; operand_class++) {
+            printf("%10.1f", latencies[operand_class]);
+        }
+        printf("%10.1f%%", 100.0 * spread);
+        if (operations[i].is_constant_time) {
+            bool passed = spread <= CONSTANT_TIME_TOLERANCE;
+            failures += !passed;
+            printf("  %s\n", passed ? "PASS" : "FAIL");
+        } else {
+            printf("\n");
+        }
+    }
+    printf("%s: constant-time operations %s within %.0f%% of their fastest operand class\n",
+           failures ? "FAIL" : "PASS", failures ? "are not all" : "are all", 100.0 * CONSTANT_TIME_TOLERANCE);
+}
+
+/**
+ * Runs the named benchmark, or lists the available benchmarks.
+ * @param arguments the remainder of the driver's input line, starting with the benchmark's name
+ */
+void evaluate_print_benchmark(const char *arguments) {
+    char name[32] = "";
+    int number_of_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+    sscanf(arguments, "%31s", name);
+    for (int i = 0; i < number_of_benchmarks; i++) {
+        if (!strcmp(name, benchmarks[i].name)) {
+            benchmarks[i].run();
+            return;
+        }
+    }
+    printf("Available benchmarks:\n");
+    for (int i = 0; i < number_of_benchmarks; i++) {
+        printf("\t%-12s %s\n", benchmarks[i].name, benchmarks[i].description);
+    }
+}
+
+static void scalar_add_batch(const uint16_t *augends, const uint16_t *addends, uint16_t *sums,
+                             uint16_t *unsigned_overflows, uint16_t *signed_overflows, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t sum = (uint32_t) augends[i] + addends[i];
+        sums[i] = (uint16_t) sum;
+        unsigned_overflows[i] = (uint16_t) (sum >> 16);
+        signed_overflows[i] = (uint16_t) ((~(augends[i] ^ addends[i]) & (augends[i] ^ sum)) >> 15) & 0x1;
+    }
+}
+
+static void benchmark_swar(void) {
+    uint64_t *packed1 = malloc(THROUGHPUT_WORDS * sizeof(uint64_t));
+    uint64_t *packed2 = malloc(THROUGHPUT_WORDS * sizeof(uint64_t));
+    swar_result_t *packed_sums = malloc(THROUGHPUT_WORDS * sizeof(swar_result_t));
+    uint16_t *lanes1 = malloc(SWAR_LANES * THROUGHPUT_WORDS * sizeof(uint16_t));
+    uint16_t *lanes2 = malloc(SWAR_LANES * THROUGHPUT_WORDS * sizeof(uint16_t));
+    uint16_t *sums = malloc(SWAR_LANES * THROUGHPUT_WORDS * sizeof(uint16_t));
+    uint16_t *unsigned_overflows = malloc(SWAR_LANES * THROUGHPUT_WORDS * sizeof(uint16_t));
+    uint16_t *signed_overflows = malloc(SWAR_LANES * THROUGHPUT_WORDS * sizeof(uint16_t));
+    uint32_t seed = 0x2545F491;
+    int mismatches = 0;
+    for (int i = 0; i < THROUGHPUT_WORDS; i++) {
+        packed1[i] = (uint64_t) benchmark_random(&seed) << 32 | benchmark_random(&seed);
+        packed2[i] = (uint64_t) benchmark_random(&seed) << 32 | benchmark_random(&seed);
+        swar_unpack(packed1[i], lanes1 + SWAR_LANES * i);
+        swar_unpack(packed2[i], lanes2 + SWAR_LANES * i);
+    }
+    uint64_t start = benchmark_nanoseconds();
+    for (int repetition = 0; repetition < THROUGHPUT_REPETITIONS; repetition++) {
+        scalar_add_batch(lanes1, lanes2, sums, unsigned_overflows, signed_overflows, SWAR_LANES * THROUGHPUT_WORDS);
+    }
+    uint64_t scalar_time = benchmark_nanoseconds() - start;
+    start = benchmark_nanoseconds();
+    for (int repetition = 0; repetition < THROUGHPUT_REPETITIONS; repetition++) {
+        swar_add_batch(packed1, packed2, packed_sums, THROUGHPUT_WORDS);
+    }
+    uint64_t swar_time = benchmark_nanoseconds() - start;
+    uint16_t accumulator = 0;
+    start = benchmark_nanoseconds();
+    for (int i = 0; i < SWAR_LANES * THROUGHPUT_WORDS; i++) {
+        accumulator ^= add(lanes1[i], lanes2[i]).result;
+    }
+    uint64_t alu_time = benchmark_nanoseconds() - start;
+    benchmark_sink = accumulator;
+    for (int i = 0; i < THROUGHPUT_WORDS; i++) {
+        uint16_t actual_sums[SWAR_LANES];
+        swar_unpack(packed_sums[i].result, actual_sums);
+        for (int lane = 0; lane < SWAR_LANES; lane++) {
+            int j = SWAR_LANES * i + lane;
+            mismatches += (actual_sums[lane] != sums[j])
+                          || (((packed_sums[i].unsigned_overflow >> (16 * lane + 15)) & 0x1) != unsigned_overflows[j])
+                          || (((packed_sums[i].signed_overflow >> (16 * lane + 15)) & 0x1) != signed_overflows[j]);
+        }
+    }
+    double lanes = (double) SWAR_LANES * THROUGHPUT_WORDS * THROUGHPUT_REPETITIONS;
+    printf("SWAR ADDITION THROUGHPUT (%d lanes, %d repetitions)\n", SWAR_LANES * THROUGHPUT_WORDS,
+           THROUGHPUT_REPETITIONS);
+    printf("\tALU add:             %10.2f million lanes/s\n",
+           SWAR_LANES * THROUGHPUT_WORDS * 1000.0 / (double) alu_time);
+    printf("\tlane-at-a-time (C):  %10.2f million lanes/s\n", lanes * 1000.0 / (double) scalar_time);
+    printf("\tSWAR:                %10.2f million lanes/s\n", lanes * 1000.0 / (double) swar_time);
+    printf("\tSWAR speedup:        %10.2fx over lane-at-a-time C (which the compiler may itself vectorise)\n",
+           (double) scalar_time / (double) swar_time);
+    printf("\tmismatched lanes: %d\n", mismatches);
+    free(packed1);
+    free(packed2);
+    free(packed_sums);
+    free(lanes1);
+    free(lanes2);
+    free(sums);
+    free(unsigned_overflows);
+    free(signed_overflows);
+}
+
+static void benchmark_width(void) {
+    uint8_t *augends = malloc(THROUGHPUT_BYTES);
+    uint8_t *addends = malloc(THROUGHPUT_BYTES);
+    uint8_t *sums = malloc(THROUGHPUT_BYTES);
+    uint32_t seed = 0x6C078965;
+    for (int i = 0; i < THROUGHPUT_BYTES; i++) {
+        augends[i] = (uint8_t) benchmark_random(&seed);
+        addends[i] = (uint8_t) benchmark_random(&seed);
+    }
+    printf("WIDTH-GENERIC BATCH ADDITION (%d KiB of operands, %d repetitions)\n", THROUGHPUT_BYTES >> 10,
+           THROUGHPUT_REPETITIONS);
+    printf("\t%6s %14s %14s\n", "width", "million ops/s", "MiB/s");
+#define BENCHMARK_WIDTH(WIDTH, UTYPE)                                                                               \
+    do {                                                                                                            \
+        size_t count = THROUGHPUT_BYTES / sizeof(UTYPE);                                                            \
+        uint64_t start = benchmark_nanoseconds();                                                                   \
+        for (int repetition = 0; repetition < THROUGHPUT_REPETITIONS; repetition++) {                               \
+            alu##WIDTH##_add_batch((const UTYPE *) augends, (const UTYPE *) addends, (UTYPE *) sums, count);        \
+        }                                                                                                           \
+        double elapsed = (double) (benchmark_nanoseconds() - start);                                                \
+        printf("\t%6d %14.1f %14.1f\n", WIDTH, 1000.0 * count * THROUGHPUT_REPETITIONS / elapsed,                  \
+               1e9 * THROUGHPUT_BYTES * THROUGHPUT_REPETITIONS / elapsed / (1 << 20));                               \
+    } while (0)
+    BENCHMARK_WIDTH(8, uint8_t);
+    BENCHMARK_WIDTH(16, uint16_t);
+    BENCHMARK_WIDTH(32, uint32_t);
+    BENCHMARK_WIDTH(64, uint64_t);
+#undef BENCHMARK_WIDTH
+    free(augends);
+    free(addends);
+    free(sums);
+}
+
+static void benchmark_bignum(void) {
+    size_t largest_limbs = BIGNUM_LARGEST_BITS / BIGNUM_LIMB_BITS;
+    limb_t *dividend = malloc(largest_limbs * sizeof(limb_t));
+    limb_t *divisor = malloc(largest_limbs * sizeof(limb_t));
+    limb_t *sum = malloc(largest_limbs * sizeof(limb_t));
+    limb_t *quotient = malloc(largest_limbs * sizeof(limb_t));
+    limb_t *remainder = malloc(largest_limbs * sizeof(limb_t));
+    limb_t *schoolbook_product = malloc(2 * largest_limbs * sizeof(limb_t));
+    limb_t *karatsuba_product = malloc(2 * largest_limbs * sizeof(limb_t));
+    bignum_arena_t arena;
+    bignum_arena_initialize(&arena, (bignum_multiply_scratch_limbs(largest_limbs) + 2 * largest_limbs) * sizeof(limb_t));
+    uint32_t seed = 0x3C6EF372;
+    printf("MULTI-LIMB ARITHMETIC (%d-bit limbs; Karatsuba from %d limbs; times in microseconds)\n", BIGNUM_LIMB_BITS,
+           BIGNUM_KARATSUBA_THRESHOLD);
+    printf("\t%6s %10s %10s %12s %12s %12s %8s\n", "bits", "add", "subtract", "schoolbook", "multiply", "divide",
+           "verified");
+    for (int bits = BIGNUM_SMALLEST_BITS; bits <= BIGNUM_LARGEST_BITS; bits <<= 1) {
+        size_t limbs = (size_t) bits / BIGNUM_LIMB_BITS;
+        for (size_t i = 0; i < limbs; i++) {
+            dividend[i] = benchmark_random(&seed);
+            // the divisor is half as wide as the dividend, so that the quotient is not trivially small
+            divisor[i] = i < limbs / 2 ? benchmark_random(&seed) : 0;
+        }
+        bool verified = true;
+        uint64_t start = benchmark_nanoseconds();
+        uint8_t carry = bignum_add(sum, dividend, divisor, limbs);
+        double add_time = (double) (benchmark_nanoseconds() - start) / 1000.0;
+        start = benchmark_nanoseconds();
+        uint8_t borrow = bignum_subtract(sum, sum, divisor, limbs);
+        double subtract_time = (double) (benchmark_nanoseconds() - start) / 1000.0;
+        verified = verified && !carry == !borrow && !bignum_compare(sum, dividend, limbs);
+        double schoolbook_time = -1.0;
+        if (bits <= BIGNUM_SCHOOLBOOK_BITS) {
+            start = benchmark_nanoseconds();
+            bignum_schoolbook_multiply(schoolbook_product, dividend, divisor, limbs);
+            schoolbook_time = (double) (benchmark_nanoseconds() - start) / 1000.0;
+        }
+        start = benchmark_nanoseconds();
+        bool multiplied = bignum_multiply(karatsuba_product, dividend, divisor, limbs, &arena);
+        double multiply_time = (double) (benchmark_nanoseconds() - start) / 1000.0;
+        verified = verified && multiplied;
+        if (bits <= BIGNUM_SCHOOLBOOK_BITS) {
+            verified = verified && !bignum_compare(schoolbook_product, karatsuba_product, 2 * limbs);
+        }
+        start = benchmark_nanoseconds();
+        bool divided = bignum_divide(quotient, remainder, dividend, divisor, limbs, &arena);
+        double divide_time = (double) (benchmark_nanoseconds() - start) / 1000.0;
+        // quotient * divisor + remainder must reproduce the dividend, with the remainder less than the divisor
+        multiplied = bignum_multiply(karatsuba_product, quotient, divisor, limbs, &arena);
+        size_t mark = bignum_arena_mark(&arena);
+        limb_t *padded_remainder = bignum_arena_allocate(&arena, 2 * limbs);
+        if (padded_remainder) {
+            memcpy(padded_remainder, remainder, limbs * sizeof(limb_t));
+            bignum_add(karatsuba_product, karatsuba_product, padded_remainder, 2 * limbs);
+        }
+        bignum_arena_release(&arena, mark);
+        verified = verified && divided && multiplied && padded_remainder && !bignum_compare(karatsuba_product, dividend, limbs)
+                   && bignum_is_zero(karatsuba_product + limbs, limbs)
+                   && bignum_compare(remainder, divisor, limbs) < 0;
+        if (schoolbook_time < 0) {
+            printf("\t%6d %10.1f %10.1f %12s %12.1f %12.1f %8s\n", bits, add_time, subtract_time, "-",
+                   multiply_time, divide_time, verified ? "yes" : "NO");
+        } else {
+            printf("\t%6d %10.1f %10.1f %12.1f %12.1f %12.1f %8s\n", bits, add_time, subtract_time, schoolbook_time,
+                   multiply_time, divide_time, verified ? "yes" : "NO");
+        }
+    }
+    bignum_arena_destroy(&arena);
+    free(dividend);
+    free(divisor);
+    free(sum);
+    free(quotient);
+    free(remainder);
+    free(schoolbook_product);
+    free(karatsuba_product);
+}
+
+static void benchmark_expression(void) {
+    const char *source = "(a + b) * c - (a - d) * 3 + (b < c) + !d";
+    uint16_t *bindings = malloc(4 * EXPRESSION_BINDINGS * sizeof(uint16_t));
+    uint16_t *results = malloc(EXPRESSION_BINDINGS * sizeof(uint16_t));
+    uint32_t seed = 0x1B873593;
+    for (int i = 0; i < 4 * EXPRESSION_BINDINGS; i++) {
+        bindings[i] = (uint16_t) benchmark_random(&seed);
+    }
+    const expression_t *expression = expression_compile_cached(source, NULL);
+    int operations = expression->number_of_instructions;
+    // reparsing every time is what the driver's one-line-at-a-time evaluation amounts to
+    expression_t *recompiled = malloc(sizeof(expression_t));
+    uint16_t accumulator = 0;
+    uint64_t start = benchmark_nanoseconds();
+    for (int i = 0; i < EXPRESSION_RECOMPILATIONS; i++) {
+        expression_compile(source, recompiled);
+        accumulator ^= expression_evaluate(recompiled, bindings + 4 * i);
+    }
+    double recompiled_time = (double) (benchmark_nanoseconds() - start) / EXPRESSION_RECOMPILATIONS;
+    start = benchmark_nanoseconds();
+    for (int i = 0; i < EXPRESSION_RECOMPILATIONS; i++) {
+        accumulator ^= expression_evaluate(expression_compile_cached(source, NULL), bindings + 4 * i);
+    }
+    double cached_time = (double) (benchmark_nanoseconds() - start) / EXPRESSION_RECOMPILATIONS;
+    start = benchmark_nanoseconds();
+    expression_evaluate_batch(expression, bindings, results, EXPRESSION_BINDINGS);
+    double batch_time = (double) (benchmark_nanoseconds() - start) / EXPRESSION_BINDINGS;
+    benchmark_sink = accumulator;
+    int mismatches = 0;
+    start = benchmark_nanoseconds();
+    for (int i = 0; i < EXPRESSION_BINDINGS; i++) {
+        uint16_t expected_result;
+        expression_evaluate_reference(expression, bindings + 4 * i, &expected_result);
+        mismatches += expected_result != results[i];
+    }
+    double reference_time = (double) (benchmark_nanoseconds() - start) / EXPRESSION_BINDINGS;
+    printf("EXPRESSION EVALUATION: %s (%d operations)\n", expression->source, operations);
+    printf("\t%-32s %12s %14s\n", "", "ns/binding", "ns/operation");
+    printf("\t%-32s %12.1f %14.1f\n", "compile, then evaluate", recompiled_time, recompiled_time / operations);
+    printf("\t%-32s %12.1f %14.1f\n", "cache lookup, then evaluate", cached_time, cached_time / operations);
+    printf("\t%-32s %12.1f %14.1f\n", "batch evaluation", batch_time, batch_time / operations);
+    printf("\t%-32s %12.1f %14.1f\n", "same bytecode, C operators", reference_time, reference_time / operations);
+    printf("\t%d bindings; mismatched results: %d\n", EXPRESSION_BINDINGS, mismatches);
+    free(recompiled);
+    free(bindings);
+    free(results);
+}
+
+static void benchmark_cpu(void) {
+    cpu_t *cpu = malloc(sizeof(cpu_t));
+    if (!cpu) {
+        printf("CPU SIMULATION: not enough memory for the CPU\n");
+        return;
+    }
+    printf("CPU SIMULATION\n");
+    printf("\t%-12s %14s %12s %22s %9s\n", "workload", "instructions", "seconds", "million instructions/s",
+           "verified");
+    for (int i = 0; i < number_of_cpu_workloads; i++) {
+        char error[80];
+        if (!cpu_assemble(cpu, cpu_workloads[i].source, error, sizeof(error))) {
+            printf("\t%-12s cannot be assembled: %s\n", cpu_workloads[i].name, error);
+            continue;
+        }
+        uint64_t start = benchmark_nanoseconds();
+        cpu_status_t status = cpu_run(cpu, UINT64_MAX);
+        double elapsed = (double) (benchmark_nanoseconds() - start);
+        printf("\t%-12s %14llu %12.3f %22.3f %9s\n", cpu_workloads[i].name,
+               (unsigned long long) cpu->instructions_retired, elapsed / 1e9,
+               1000.0 * (double) cpu->instructions_retired / elapsed,
+               status == CPU_HALTED && cpu_workloads[i].verify(cpu) ? "yes" : "NO");
+    }
+    free(cpu);
+}
+
+static double time_workload(cpu_t *cpu, const cpu_workload_t *workload) {
+    char error[80];
+    cpu_assemble(cpu, workload->source, error, sizeof(error));
+    uint64_t start = benchmark_nanoseconds();
+    cpu_run(cpu, UINT64_MAX);
+    return (double) (benchmark_nanoseconds() - start);
+}
+
+static void benchmark_trace(void) {
+    const cpu_workload_t *workload = cpu_workloads + TRACE_BENCHMARK_WORKLOAD;
+    cpu_t *cpu = malloc(sizeof(cpu_t));
+    trace_replay_report_t report;
+    if (!cpu) {
+        printf("TRACE RECORDING AND REPLAY: not enough memory for the CPU\n");
+        return;
+    }
+    // take the faster of two runs each way, so that neither is penalized for warming the caches
+    double untraced_time = time_workload(cpu, workload);
+    double retry = time_workload(cpu, workload);
+    untraced_time = retry < untraced_time ? retry : untraced_time;
+    double traced_time = -1.0;
+    uint64_t records = 0;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!trace_start(TRACE_BENCHMARK_PATH)) {
+            printf("Cannot record to %s\n", TRACE_BENCHMARK_PATH);
+            free(cpu);
+            return;
+        }
+        double elapsed = time_workload(cpu, workload);
+        records = trace_stop();
+        traced_time = traced_time < 0 || elapsed < traced_time ? elapsed : traced_time;
+    }
+    bool replayed = trace_replay(TRACE_BENCHMARK_PATH, &report);
+    remove(TRACE_BENCHMARK_PATH);
+    printf("TRACE RECORDING AND REPLAY (CPU workload \"%s\", %" PRIu64 " ALU calls)\n", workload->name, records);
+    printf("\tuntraced run:   %10.3f ms\n", untraced_time / 1e6);
+    printf("\trecorded run:   %10.3f ms  (%+.1f%% overhead)\n", traced_time / 1e6,
+           100.0 * (traced_time - untraced_time) / untraced_time);
+    if (!replayed) {
+        printf("\treplay failed: %s\n", report.error);
+    } else {
+        uint64_t mismatches = 0;
+        for (int i = 0; i < NUMBER_OF_TRACE_FUNCTIONS; i++) {
+            mismatches += report.mismatches[i];
+        }
+        printf("\ttrace size:     %10" PRIu64 " bytes  (%.2f bytes per call)\n", report.bytes,
+               (double) report.bytes / (double) report.records);
+        printf("\treplay:         %10.3f ms  (%.1f ns per call; %" PRIu64 " differences)\n",
+               (double) report.nanoseconds / 1e6, (double) report.nanoseconds / (double) report.records, mismatches);
+    }
+    free(cpu);
+}
+
+static void *serve(void *path) {
+    server_run(path, 0);
+    return NULL;
+}
+
+static int connect_to_server(const char *path) {
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client >= 0 && connect(client, (struct sockaddr *) &address, sizeof(address)) < 0) {
+        close(client);
+        client = -1;
+    }
+    return client;
+}
+
+static bool transfer(int socket, void *buffer, size_t length, bool sending) {
+    uint8_t *bytes = buffer;
+    while (length) {
+        ssize_t moved = sending ? write(socket, bytes, length) : read(socket, bytes, length);
+        if (moved <= 0) {
+            return false;
+        }
+        bytes += moved;
+        length -= (size_t) moved;
+    }
+    return true;
+}
+
+static void *server_client(void *mismatches) {
+    static const size_t request_size = 9 + SERVER_BENCHMARK_OPERATIONS * SERVER_OPERATION_SIZE;
+    static const size_t response_size = 9 + SERVER_BENCHMARK_OPERATIONS * SERVER_RESULT_SIZE;
+    uint8_t *requests = malloc(SERVER_BENCHMARK_BATCHES * request_size);
+    uint8_t *response = malloc(response_size);
+    uint64_t *count = mismatches;
+    uint32_t seed = (uint32_t) *count + 1;  // each client starts with its own number, and reports its mismatches
+    int client = connect_to_server(SERVER_BENCHMARK_PATH);
+    *count = 0;
+    for (int batch = 0; batch < SERVER_BENCHMARK_BATCHES; batch++) {
+        uint8_t *request = requests + batch * request_size;
+        uint32_t length = (uint32_t) request_size - 4;
+        uint32_t operations = SERVER_BENCHMARK_OPERATIONS;
+        memcpy(request, &length, 4);        // the protocol is little-endian, as is every host this runs on
+        request[4] = SERVER_BATCH;
+        memcpy(request + 5, &operations, 4);
+        for (int i = 0; i < SERVER_BENCHMARK_OPERATIONS; i++) {
+            uint32_t random = benchmark_random(&seed);
+            request[9 + i * SERVER_OPERATION_SIZE] = (uint8_t) (random % NUMBER_OF_SERVER_OPERATIONS);
+            random = benchmark_random(&seed);
+            memcpy(request + 10 + i * SERVER_OPERATION_SIZE, &random, 4);
+        }
+    }
+    if (client < 0 || !transfer(client, requests, SERVER_BENCHMARK_BATCHES * request_size, true)) {
+        *count = UINT64_MAX;
+    }
+    for (int batch = 0; batch < SERVER_BENCHMARK_BATCHES && *count != UINT64_MAX; batch++) {
+        if (!transfer(client, response, response_size, false) || response[4] != SERVER_BATCH) {
+            *count = UINT64_MAX;
+            continue;
+        }
+        for (int i = 0; i < SERVER_BENCHMARK_OPERATIONS; i++) {
+            const uint8_t *operation = requests + batch * request_size + 9 + i * SERVER_OPERATION_SIZE;
+            const uint8_t *result = response + 9 + i * SERVER_RESULT_SIZE;
+            uint16_t operand1 = (uint16_t) (operation[1] | operation[2] << 8);
+            uint16_t operand2 = (uint16_t) (operation[3] | operation[4] << 8);
+            alu_result_t expected = {};
+            switch (operation[0]) {
+                case SERVER_ADD:
+                    expected = add(operand1, operand2);
+                    break;
+                case SERVER_SUBTRACT:
+                    expected = subtract(operand1, operand2);
+                    break;
+                case SERVER_UNSIGNED_MULTIPLY:
+                    expected = unsigned_multiply(operand1, operand2);
+                    break;
+                case SERVER_SIGNED_MULTIPLY:
+                    expected = signed_multiply(operand1, operand2);
+                    break;
+                case SERVER_UNSIGNED_DIVIDE:
+                    expected = unsigned_divide(operand1, operand2);
+                    break;
+                case SERVER_SIGNED_DIVIDE:
+                    expected = signed_divide(operand1, operand2);
+                    break;
+                default:
+                    expected.result = compare(operand1, operand2);
+            }
+            uint8_t flags = (uint8_t) ((expected.unsigned_overflow ? SERVER_UNSIGNED_OVERFLOW_BIT : 0)
+                                       | (expected.signed_overflow ? SERVER_SIGNED_OVERFLOW_BIT : 0)
+                                       | (expected.divide_by_zero ? SERVER_DIVIDE_BY_ZERO_BIT : 0));
+            *count += (uint16_t) (result[0] | result[1] << 8) != expected.result
+                      || (uint16_t) (result[2] | result[3] << 8) != expected.supplemental_result
+                      || result[4] != flags;
+        }
+    }
+    if (client >= 0) {
+        close(client);
+    }
+    free(requests);
+    free(response);
+    return NULL;
+}
+
+static void benchmark_server(void) {
+    pthread_t server, clients[SERVER_BENCHMARK_CLIENTS];
+    uint64_t mismatches[SERVER_BENCHMARK_CLIENTS] = {};
+    int probe = -1;
+    pthread_create(&server, NULL, serve, SERVER_BENCHMARK_PATH);
+    for (int attempt = 0; attempt < 100 && probe < 0; attempt++) {
+        nanosleep(&(struct timespec) {.tv_nsec = 10000000}, NULL);
+        probe = connect_to_server(SERVER_BENCHMARK_PATH);
+    }
+    if (probe < 0) {
+        printf("The server did not start on %s\n", SERVER_BENCHMARK_PATH);
+        server_request_stop();
+        pthread_join(server, NULL);
+        return;
+    }
+    uint64_t start = benchmark_nanoseconds();
+    for (int i = 0; i < SERVER_BENCHMARK_CLIENTS; i++) {
+        mismatches[i] = (uint64_t) i;
+        pthread_create(clients + i, NULL, server_client, mismatches + i);
+    }
+    for (int i = 0; i < SERVER_BENCHMARK_CLIENTS; i++) {
+        pthread_join(clients[i], NULL);
+    }
+    double elapsed = (double) (benchmark_nanoseconds() - start);
+    uint64_t operations = (uint64_t) SERVER_BENCHMARK_CLIENTS * SERVER_BENCHMARK_BATCHES * SERVER_BENCHMARK_OPERATIONS;
+    printf("ALU SERVER (%d clients, %d pipelined batches of %d operations each)\n", SERVER_BENCHMARK_CLIENTS,
+           SERVER_BENCHMARK_BATCHES, SERVER_BENCHMARK_OPERATIONS);
+    printf("\t%.3f ms for %" PRIu64 " operations: %.0f operations/s\n", elapsed / 1e6, operations,
+           1e9 * (double) operations / elapsed);
+    for (int i = 0; i < SERVER_BENCHMARK_CLIENTS; i++) {
+        if (mismatches[i] == UINT64_MAX) {
+            printf("\tclient %d lost its connection\n", i);
+        } else {
+            printf("\tclient %d: %" PRIu64 " results differ from the ALU\n", i, mismatches[i]);
+        }
+    }
+    // the probe connection asks for the server's own account of the run
+    uint8_t request[5] = {1, 0, 0, 0, SERVER_STATS};
+    uint8_t header[5];
+    uint32_t length;
+    if (transfer(probe, request, sizeof(request), true) && transfer(probe, header, sizeof(header), false)) {
+        memcpy(&length, header, 4);
+        char *text = calloc(1, length);
+        if (transfer(probe, text, length - 1, false)) {
+            printf("\tserver statistics:\n");
+            for (char *line = strtok(text, "\n"); line; line = strtok(NULL, "\n")) {
+                printf("\t\t%s\n", line);
+            }
+        }
+        free(text);
+    }
+    close(probe);
+    server_request_stop();
+    pthread_join(server, NULL);
+}
+
+static void benchmark_pipeline(void) {
+    static const char *operators[] = {"+", "-", "*", "/", "%", "==", "!=", "<", "<=", ">", ">=", "&&", "||"};
+    static const int evaluator_counts[] = {0, 1, 2, 4};
+    uint32_t seed = 0x5EED;
+    FILE *script = tmpfile();
+    FILE *sink = fopen("/dev/null", "w");
+    if (!script || !sink) {
+        printf("Cannot create the benchmark's script or open /dev/null\n");
+        return;
+    }
+    for (int i = 0; i < PIPELINE_BENCHMARK_LINES; i++) {
+        uint32_t random = benchmark_random(&seed);
+        fprintf(script, "%u %s %u\n", random & 0xFFFF, operators[benchmark_random(&seed) % 13], random >> 16);
+    }
+    printf("PIPELINED SCRIPT EVALUATION (%d lines)\n", PIPELINE_BENCHMARK_LINES);
+    printf("\t%-10s %12s %16s %9s %18s\n", "evaluators", "seconds", "expressions/s", "speedup", "same output");
+    double sequential = 0.0;
+    uint64_t expected_checksum = 0;
+    for (size_t i = 0; i < sizeof(evaluator_counts) / sizeof(evaluator_counts[0]); i++) {
+        pipeline_report_t report;
+        rewind(script);
+        pipeline_run(script, sink, evaluator_counts[i], FORMAT_FULL, &report);
+        double elapsed = (double) report.nanoseconds;
+        sequential = i ? sequential : elapsed;
+        expected_checksum = i ? expected_checksum : report.checksum;
+        printf("\t%-10d %12.3f %16.0f %8.2fx %18s\n", evaluator_counts[i], elapsed / 1e9,
+               1e9 * (double) report.operations / elapsed, sequential / elapsed,
+               report.checksum == expected_checksum && report.operations == PIPELINE_BENCHMARK_LINES ? "yes" : "NO");
+    }
+    fclose(script);
+    fclose(sink);
+}
+
+/* the printf calls that evaluate_print_arithmetic made for addition and subtraction before it used the formatter */
+static int print_sum_check(FILE *stream, const format_arithmetic_t *check) {
+    char operator = check->operator;
+    uint16_t operand1 = check->operand1, operand2 = check->operand2;
+    const struct authoritative_result *expected_result = check->expected;
+    alu_result_t actual_result = check->actual[0];
+    int length = 0;
+    length += fprintf(stream, "UNSIGNED %s\n", operator == '+' ? "ADDITION" : "SUBTRACTION");
+    length += fprintf(stream, "\texpected result (hexadecimal): 0x%04X %c 0x%04X = 0x%04X\n",
+            operand1, operator, operand2, expected_result->result);
+    length += fprintf(stream, "\texpected result (unsigned):    %u %c %u = %u\toverflow: %s\n",
+            operand1, operator, operand2, expected_result->result, expected_result->c_flag ? "true" : "false");
+    length += fprintf(stream, "\tactual result (hexadecimal):   0x%04X %c 0x%04X = 0x%04X\n",
+            operand1, operator, operand2, actual_result.result);
+    length += fprintf(stream, "\tactual result (unsigned):      %u %c %u = %u\toverflow: %s\n",
+            operand1, operator, operand2, actual_result.result, actual_result.unsigned_overflow ? "true" : "false");
+    length += fprintf(stream, "SIGNED %s\n", operator == '+' ? "ADDITION" : "SUBTRACTION");
+    length += fprintf(stream, "\texpected result (hexadecimal): 0x%04X %c 0x%04X = 0x%04X\n",
+            operand1, operator, operand2, expected_result->result);
+    length += fprintf(stream, "\texpected result (signed):      %d %c %d = %d\toverflow: %s\n",
+            (int16_t) operand1, operator, (int16_t) operand2, (int16_t) expected_result->result,
+            expected_result->o_flag ? "true" : "false");
+    length += fprintf(stream, "\tactual result (hexadecimal):   0x%04X %c 0x%04X = 0x%04X\n",
+            operand1, operator, operand2, actual_result.result);
+    length += fprintf(stream, "\tactual result (signed):        %d %c %d = %d\toverflow: %s\n",
+            (int16_t) operand1, operator, (int16_t) operand2, (int16_t) actual_result.result,
+            actual_result.signed_overflow ? "true" : "false");
+    length += fprintf(stream, "\t\tNumber of calls to ripple_carry_addition:    %d\n", check->addition_calls[0]);
+    return length;
+}
+
+static void benchmark_format(void) {
+    static const char *methods[] = {"printf", "formatter, full", "formatter, mismatches", "formatter, summary"};
+    format_arithmetic_t *checks = malloc(FORMAT_BENCHMARK_CHECKS * sizeof(format_arithmetic_t));
+    char *outputs[2] = {NULL, NULL};
+    size_t lengths[2] = {0, 0};
+    uint32_t seed = 0xF0F0;
+    uint64_t matched = 0;
+    FILE *sink = fopen("/dev/null", "w");
+    if (!checks || !sink) {
+        printf("Cannot allocate the checks or open /dev/null\n");
+        free(checks);
+        return;
+    }
+    // the ALU runs once, up front, so that only formatting is timed
+    for (int i = 0; i < FORMAT_BENCHMARK_CHECKS; i++) {
+        uint32_t random = benchmark_random(&seed);
+        format_arithmetic_t *check = checks + i;
+        *check = (format_arithmetic_t) {.operator = (random & 0x10000) ? '+' : '-', .operand1 = (uint16_t) random,
+                                        .operand2 = (uint16_t) benchmark_random(&seed),
+                                        .addition_calls = {1, -1}, .shift_calls = {-1, -1}};
+        if (check->operator == '+') {
+            evaluate_addition(check->operand1, check->operand2, check->expected);
+            check->actual[0] = add(check->operand1, check->operand2);
+        } else {
+            evaluate_subtraction(check->operand1, check->operand2, check->expected);
+            check->actual[0] = subtract(check->operand1, check->operand2);
+        }
+        check->expected[1] = check->expected[0];
+        check->actual[1] = check->actual[0];
+        matched += format_arithmetic_matches(check);
+    }
+    printf("RESULT FORMATTING (%d addition and subtraction checks, %" PRIu64 " of them passing)\n",
+           FORMAT_BENCHMARK_CHECKS, matched);
+    printf("\t%-22s %12s %14s %14s\n", "method", "seconds", "checks/s", "bytes");
+    for (int method = 0; method < 4; method++) {
+        format_buffer_t buffer;
+        uint64_t bytes = 0;
+        uint64_t start = benchmark_nanoseconds();
+        if (method == 0) {
+            for (int i = 0; i < FORMAT_BENCHMARK_CHECKS; i++) {
+                bytes += (uint64_t) print_sum_check(sink, checks + i);
+            }
+            fflush(sink);
+        } else {
+            format_open(&buffer, sink, 0);
+            for (int i = 0; i < FORMAT_BENCHMARK_CHECKS; i++) {
+                format_arithmetic(&buffer, (format_verbosity_t) (method - 1), checks + i);
+            }
+            format_close(&buffer);
+            bytes = buffer.bytes_written;
+        }
+        double elapsed = (double) (benchmark_nanoseconds() - start);
+        printf("\t%-22s %12.6f %14.0f %14" PRIu64 "\n", methods[method], elapsed / 1e9,
+               1e9 * FORMAT_BENCHMARK_CHECKS / elapsed, bytes);
+    }
+    // the formatter's full output must be byte-for-byte what printf wrote
+    for (int method = 0; method < 2; method++) {
+        FILE *memory = open_memstream(outputs + method, lengths + method);
+        format_buffer_t buffer;
+        format_open(&buffer, memory, 0);
+        for (int i = 0; i < FORMAT_BENCHMARK_CHECKS; i++) {
+            if (method == 0) {
+                print_sum_check(memory, checks + i);
+            } else {
+                format_arithmetic(&buffer, FORMAT_FULL, checks + i);
+            }
+        }
+        format_close(&buffer);
+        fclose(memory);
+    }
+    printf("\tfull output identical to printf's: %s\n",
+           lengths[0] == lengths[1] && !memcmp(outputs[0], outputs[1], lengths[0]) ? "yes" : "NO");
+    free(outputs[0]);
+    free(outputs[1]);
+    free(checks);
+    fclose(sink);
+}
+
+static void benchmark_table(void) {
+    static const struct {
+        const char *name;
+        binary_operation_t backends[3];
+    } operations[] = {
+            {"add",               {add, constant_time_add, table_add}},
+            {"subtract",          {subtract, constant_time_subtract, table_subtract}},
+            {"unsigned_multiply", {unsigned_multiply, constant_time_unsigned_multiply, table_unsigned_multiply}},
+    };
+    static const char *backend_names[] = {"ripple-carry", "constant-time", "table"};
+    uint16_t *operands1 = malloc(TABLE_BENCHMARK_OPERATIONS * sizeof(uint16_t));
+    uint16_t *operands2 = malloc(TABLE_BENCHMARK_OPERATIONS * sizeof(uint16_t));
+    uint32_t seed = 0x7AB1E;
+    uint64_t start = benchmark_nanoseconds();
+    table_alu_initialize();
+    double generation = (double) (benchmark_nanoseconds() - start);
+    printf("TABLE-DRIVEN ALU (%zu KiB of tables, generated in %.3f ms on first use; %d operations per run)\n",
+           table_alu_footprint() / 1024, generation / 1e6, TABLE_BENCHMARK_OPERATIONS);
+    printf("\t%-18s %-14s %20s %20s %10s\n", "operation", "backend", "full-range ns/op", "narrow ns/op",
+           "verified");
+    for (size_t operation = 0; operation < sizeof(operations) / sizeof(operations[0]); operation++) {
+        for (int backend = 0; backend < 3; backend++) {
+            double nanoseconds[2];
+            int mismatches = 0;
+            for (int narrow = 0; narrow < 2; narrow++) {
+                uint16_t mask = narrow ? TABLE_NARROW_OPERAND : 0xFFFF;
+                uint16_t accumulator = 0;
+                for (int i = 0; i < TABLE_BENCHMARK_OPERATIONS; i++) {
+                    operands1[i] = (uint16_t) benchmark_random(&seed) & mask;
+                    operands2[i] = (uint16_t) benchmark_random(&seed) & mask;
+                }
+                start = benchmark_nanoseconds();
+                for (int i = 0; i < TABLE_BENCHMARK_OPERATIONS; i++) {
+                    accumulator ^= operations[operation].backends[backend](operands1[i], operands2[i]).result;
+                }
+                nanoseconds[narrow] = (double) (benchmark_nanoseconds() - start) / TABLE_BENCHMARK_OPERATIONS;
+                benchmark_sink = accumulator;
+                // every backend is checked against the host's arithmetic, including its flags
+                for (int i = 0; i < TABLE_BENCHMARK_OPERATIONS; i++) {
+                    uint32_t a = operands1[i], b = operands2[i];
+                    alu_result_t actual = operations[operation].backends[backend](operands1[i], operands2[i]);
+                    uint32_t expected = operation == 0 ? a + b : operation == 1 ? a - b : a * b;
+                    int16_t signed_result = (int16_t) expected;
+                    int32_t signed_expected = operation == 0 ? (int16_t) a + (int16_t) b : (int16_t) a - (int16_t) b;
+                    mismatches += operation == 2
+                                  ? actual.result != (uint16_t) expected
+                                    || actual.supplemental_result != (uint16_t) (expected >> 16)
+                                  : actual.result != (uint16_t) expected
+                                    || actual.unsigned_overflow != (expected > 0xFFFF)
+                                    || actual.signed_overflow != (signed_result != signed_expected);
+                }
+            }
+            printf("\t%-18s %-14s %20.1f %20.1f %10s\n", backend ? "" : operations[operation].name,
+                   backend_names[backend], nanoseconds[0], nanoseconds[1], mismatches ? "NO" : "yes");
+        }
+    }
+    free(operands1);
+    free(operands2);
+}
+
+static bool alu_relation(predicate_t predicate, uint16_t value1, uint16_t value2) {
+    switch (predicate) {
+        case PREDICATE_EQUAL:
+            return equal(value1, value2);
+        case PREDICATE_NOT_EQUAL:
+            return not_equal(value1, value2);
+        case PREDICATE_LESS_THAN:
+            return less_than(value1, value2);
+        case PREDICATE_AT_MOST:
+            return at_most(value1, value2);
+        case PREDICATE_GREATER_THAN:
+            return greater_than(value1, value2);
+        case PREDICATE_AT_LEAST:
+            return at_least(value1, value2);
+        case PREDICATE_UNSIGNED_LESS_THAN:
+            return unsigned_less_than(value1, value2);
+        case PREDICATE_UNSIGNED_AT_MOST:
+            return unsigned_at_most(value1, value2);
+        case PREDICATE_UNSIGNED_GREATER_THAN:
+            return unsigned_greater_than(value1, value2);
+        default:
+            return unsigned_at_least(value1, value2);
+    }
+}
+
+static void benchmark_predicate(void) {
+    size_t count = PREDICATE_BENCHMARK_VALUES;
+    size_t words = predicate_mask_words(count);
+    uint16_t *column1 = malloc(count * sizeof(uint16_t));
+    uint16_t *column2 = malloc(count * sizeof(uint16_t));
+    uint64_t *reference = malloc(2 * NUMBER_OF_PREDICATES * words * sizeof(uint64_t));
+    uint64_t *mask = malloc(words * sizeof(uint64_t));
+    uint32_t *indices = malloc(count * sizeof(uint32_t));
+    uint16_t constant = 0x1234;
+    uint32_t seed = 0xC0FFEE;
+    predicate_kernel_t chosen = predicate_kernel();
+    int alu_mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        column1[i] = (uint16_t) benchmark_random(&seed);
+        // a few repeats, so that equality is sometimes true
+        column2[i] = (i % 7) ? (uint16_t) benchmark_random(&seed) : column1[i];
+    }
+    column1[1] = constant;
+    printf("BATCH COMPARISON TO BITMASKS (%zu values; the widest supported kernel is %s)\n", count,
+           predicate_kernel_name(chosen));
+    printf("\t%-8s %22s %22s %10s\n", "kernel", "column vs constant", "column vs column", "verified");
+    for (predicate_kernel_t kernel = PREDICATE_SCALAR; kernel < NUMBER_OF_PREDICATE_KERNELS; kernel++) {
+        if (!predicate_select_kernel(kernel)) {
+            printf("\t%-8s %22s\n", predicate_kernel_name(kernel), "not supported");
+            continue;
+        }
+        double nanoseconds[2] = {0.0, 0.0};
+        int mismatches = 0;
+        for (int columns = 0; columns < 2; columns++) {
+            for (predicate_t predicate = PREDICATE_EQUAL; predicate < NUMBER_OF_PREDICATES; predicate++) {
+                uint64_t *expected = reference + (2 * predicate + columns) * words;
+                uint64_t *output = kernel == PREDICATE_SCALAR ? expected : mask;
+                uint64_t start = benchmark_nanoseconds();
+                if (columns) {
+                    predicate_compare_columns(predicate, column1, column2, output, count);
+                } else {
+                    predicate_compare_constant(predicate, column1, constant, output, count);
+                }
+                nanoseconds[columns] += (double) (benchmark_nanoseconds() - start);
+                mismatches += memcmp(output, expected, words * sizeof(uint64_t)) != 0;
+            }
+        }
+        printf("\t%-8s %17.3f ns/v %17.3f ns/v %10s\n", predicate_kernel_name(kernel),
+               nanoseconds[0] / NUMBER_OF_PREDICATES / (double) count,
+               nanoseconds[1] / NUMBER_OF_PREDICATES / (double) count, mismatches ? "NO" : "yes");
+    }
+    predicate_select_kernel(chosen);
+    // the scalar kernel is the reference for the others; it is checked in turn against the ALU
+    for (predicate_t predicate = PREDICATE_EQUAL; predicate < NUMBER_OF_PREDICATES; predicate++) {
+        for (int columns = 0; columns < 2; columns++) {
+            const uint64_t *expected = reference + (2 * predicate + columns) * words;
+            for (size_t i = 0; i < PREDICATE_ALU_CHECKS; i++) {
+                bool holds = alu_relation(predicate, column1[i], columns ? column2[i] : constant);
+                alu_mismatches += holds != ((expected[i / 64] >> (i % 64)) & 0x1);
+            }
+        }
+    }
+    printf("\tscalar kernel against the ALU's relations (%d values per predicate): %d differences\n",
+           PREDICATE_ALU_CHECKS, alu_mismatches);
+    predicate_compare_constant(PREDICATE_UNSIGNED_LESS_THAN, column1, constant, mask, count);
+    uint64_t start = benchmark_nanoseconds();
+    size_t selected = predicate_count(mask, count);
+    double counting = (double) (benchmark_nanoseconds() - start);
+    start = benchmark_nanoseconds();
+    size_t compacted = predicate_compact(mask, count, indices);
+    double compaction = (double) (benchmark_nanoseconds() - start);
+    bool compacted_correctly = compacted == selected;
+    for (size_t i = 0; i < compacted; i++) {
+        compacted_correctly = compacted_correctly && column1[indices[i]] < constant && (i == 0 || indices[i - 1] < indices[i]);
+    }
+    printf("\tvalues <u 0x%04X: %zu selected; counted in %.3f ms, compacted to indices in %.3f ms (%s)\n",
+           constant, selected, counting / 1e6, compaction / 1e6, compacted_correctly ? "verified" : "WRONG");
+    free(column1);
+    free(column2);
+    free(reference);
+    free(mask);
+    free(indices);
+}
+
+static void benchmark_shift(void) {
+    uint16_t *values = malloc(SHIFT_BENCHMARK_VALUES * sizeof(uint16_t));
+    uint8_t *amounts = malloc(SHIFT_BENCHMARK_VALUES * sizeof(uint8_t));
+    uint16_t *results = malloc(SHIFT_BENCHMARK_VALUES * sizeof(uint16_t));
+    uint16_t *shifted_out = malloc(SHIFT_BENCHMARK_VALUES * sizeof(uint16_t));
+    uint32_t seed = 0x5EED5;
+    int exhaustive_mismatches = 0;
+    for (uint32_t value = 0; value <= UINT16_MAX; value++) {
+        for (uint8_t amount = 0; amount < ALU_WIDTH; amount++) {
+            for (alu_shift_t operation = ALU_SHIFT_LEFT; operation <= ALU_ROTATE_RIGHT; operation++) {
+                alu_result_t expected = host_shift((uint16_t) value, amount, operation);
+                alu_result_t actual = barrel_shift((uint16_t) value, amount, operation);
+                exhaustive_mismatches += expected.result != actual.result
+                                         || expected.supplemental_result != actual.supplemental_result
+                                         || expected.unsigned_overflow != actual.unsigned_overflow
+                                         || expected.signed_overflow != actual.signed_overflow;
+            }
+        }
+    }
+    printf("BARREL SHIFTER (%d stages; every value, amount, and operation checked against the host: %d differences)\n",
+           ALU_SHIFT_STAGES, exhaustive_mismatches);
+    for (size_t i = 0; i < SHIFT_BENCHMARK_VALUES; i++) {
+        values[i] = (uint16_t) benchmark_random(&seed);
+        amounts[i] = (uint8_t) benchmark_random(&seed);
+    }
+    printf("\t%-12s %14s %14s %14s %10s\n", "operation", "barrel_shift", "batch", "host", "verified");
+    for (alu_shift_t operation = ALU_SHIFT_LEFT; operation <= ALU_ROTATE_RIGHT; operation++) {
+        uint16_t accumulator = 0;
+        uint64_t start = benchmark_nanoseconds();
+        for (size_t i = 0; i < SHIFT_BENCHMARK_VALUES; i++) {
+            accumulator ^= barrel_shift(values[i], amounts[i], operation).result;
+        }
+        double scalar = (double) (benchmark_nanoseconds() - start);
+        start = benchmark_nanoseconds();
+        barrel_shift_batch(operation, values, amounts, results, shifted_out, SHIFT_BENCHMARK_VALUES);
+        double batch = (double) (benchmark_nanoseconds() - start);
+        start = benchmark_nanoseconds();
+        for (size_t i = 0; i < SHIFT_BENCHMARK_VALUES; i++) {
+            accumulator ^= host_shift(values[i], amounts[i], operation).result;
+        }
+        double host = (double) (benchmark_nanoseconds() - start);
+        benchmark_sink = accumulator;
+        bool verified = true;
+        for (size_t i = 0; i < SHIFT_BENCHMARK_VALUES; i++) {
+            alu_result_t expected = barrel_shift(values[i], amounts[i], operation);
+            verified = verified && results[i] == expected.result && shifted_out[i] == expected.supplemental_result;
+        }
+        printf("\t%-12s %9.2f ns/v %9.2f ns/v %9.2f ns/v %10s\n", barrel_shift_name(operation),
+               scalar / SHIFT_BENCHMARK_VALUES, batch / SHIFT_BENCHMARK_VALUES, host / SHIFT_BENCHMARK_VALUES,
+               verified ? "yes" : "NO");
+    }
+    // unsigned_divide now shifts by the divisor's logarithm instead of leaving the quotient out
+    int division_mismatches = 0;
+    uint64_t start = benchmark_nanoseconds();
+    for (size_t i = 0; i < SHIFT_BENCHMARK_VALUES; i++) {
+        uint16_t divisor = (uint16_t) (1u << (amounts[i] & 0xF));
+        alu_result_t quotient = unsigned_divide(values[i], divisor);
+        division_mismatches += quotient.result != values[i] / divisor
+                               || quotient.supplemental_result != values[i] % divisor || quotient.divide_by_zero;
+    }
+    double division = (double) (benchmark_nanoseconds() - start);
+    division_mismatches += !unsigned_divide(values[0], 0).divide_by_zero;
+    printf("\tunsigned_divide by powers of two: %.2f ns/op, %d differences (including the divide-by-zero flag)\n",
+           division / SHIFT_BENCHMARK_VALUES, division_mismatches);
+    free(values);
+    free(amounts);
+    free(results);
+    free(shifted_out);
+}
+
+static void benchmark_gates(void) {
+    uint32_t seed = 0x6A7E5;
+    printf("GATE-LEVEL COST (%d random operand pairs per design; divisors are powers of two)\n", GATE_BENCHMARK_PAIRS);
+    printf("\t%-18s %8s %8s %8s %7s %7s %7s %9s %10s\n", "design", "min", "mean", "max",
+           "min", "mean", "max", "verified", "model");
+    printf("\t%-18s %26s %23s\n", "", "gates", "depth");
+    for (gate_design_t design = GATE_DESIGN_ADD; design < NUMBER_OF_GATE_DESIGNS; design++) {
+        uint32_t fewest_gates = UINT32_MAX, most_gates = 0, shallowest = UINT32_MAX, deepest = 0;
+        uint64_t all_gates = 0, all_depths = 0;
+        int mismatches = 0;
+        double nanoseconds = 0.0;
+        for (int pair = 0; pair < GATE_BENCHMARK_PAIRS; pair++) {
+            uint16_t operand1 = (uint16_t) benchmark_random(&seed);
+            uint16_t operand2 = (uint16_t) benchmark_random(&seed);
+            if (design == GATE_DESIGN_UNSIGNED_DIVIDE) {
+                operand2 = (uint16_t) (1u << (operand2 & 0xF));
+            }
+            gate_cost_t cost;
+            uint64_t start = benchmark_nanoseconds();
+            alu_result_t actual = gate_evaluate(design, operand1, operand2, &cost);
+            nanoseconds += (double) (benchmark_nanoseconds() - start);
+            alu_result_t expected = gate_expected(design, operand1, operand2);
+            mismatches += actual.result != expected.result
+                          || actual.supplemental_result != expected.supplemental_result
+                          || actual.unsigned_overflow != expected.unsigned_overflow
+                          || actual.signed_overflow != expected.signed_overflow
+                          || actual.divide_by_zero != expected.divide_by_zero;
+            uint32_t gates = gate_total(&cost);
+            fewest_gates = gates < fewest_gates ? gates : fewest_gates;
+            most_gates = gates > most_gates ? gates : most_gates;
+            shallowest = cost.depth < shallowest ? cost.depth : shallowest;
+            deepest = cost.depth > deepest ? cost.depth : deepest;
+            all_gates += gates;
+            all_depths += cost.depth;
+        }
+        printf("\t%-18s %8u %8.1f %8u %7u %7.1f %7u %9s %7.2f us\n", gate_design_name(design),
+               fewest_gates, (double) all_gates / GATE_BENCHMARK_PAIRS, most_gates,
+               shallowest, (double) all_depths / GATE_BENCHMARK_PAIRS, deepest,
+               mismatches ? "NO" : "yes", nanoseconds / GATE_BENCHMARK_PAIRS / 1e3);
+    }
+}
+
+/* lg() as it was written before it was made branch-free */
+static int switch_lg(uint32_t power_of_two) {
+    switch (power_of_two) {
+        case 0x1: return 0;
+        case 0x2: return 1;
+        case 0x4: return 2;
+        case 0x8: return 3;
+        case 0x10: return 4;
+        case 0x20: return 5;
+        case 0x40: return 6;
+        case 0x80: return 7;
+        case 0x100: return 8;
+        case 0x200: return 9;
+        case 0x400: return 10;
+        case 0x800: return 11;
+        case 0x1000: return 12;
+        case 0x2000: return 13;
+        case 0x4000: return 14;
+        case 0x8000: return 15;
+        case 0x10000: return 16;
+        case 0x20000: return 17;
+        case 0x40000: return 18;
+        case 0x80000: return 19;
+        case 0x100000: return 20;
+        case 0x200000: return 21;
+        case 0x400000: return 22;
+        case 0x800000: return 23;
+        case 0x1000000: return 24;
+        case 0x2000000: return 25;
+        case 0x4000000: return 26;
+        case 0x8000000: return 27;
+        case 0x10000000: return 28;
+        case 0x20000000: return 29;
+        case 0x40000000: return 30;
+        case 0x80000000: return 31;
+        default: return 0;
+    }
+}
+
+static int reference_floor_lg(uint64_t value) {
+    int exponent = 0;
+    while (value > 1) {
+        value >>= 1;
+        exponent++;
+    }
+    return exponent;
+}
+
+static void benchmark_lg(void) {
+    uint32_t *values = malloc(LG_BENCHMARK_VALUES * sizeof(uint32_t));
+    int32_t *exponents = malloc(LG_BENCHMARK_VALUES * sizeof(int32_t));
+    int32_t *batch_exponents = malloc(LG_BENCHMARK_VALUES * sizeof(int32_t));
+    uint32_t *powers = malloc(LG_BENCHMARK_VALUES * sizeof(uint32_t));
+    uint32_t seed = 0x1091;
+    int lg_mismatches = 0, exponentiate_mismatches = 0, rounding_mismatches = 0;
+    int accumulator = 0;
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        uint32_t random = benchmark_random(&seed);
+        // mostly powers of two, with every eighth value arbitrary
+        values[i] = (i % 8) ? UINT32_C(1) << (random % 32) : random;
+        exponents[i] = (int32_t) (random % 32);
+    }
+    printf("BASE-TWO LOGARITHMS AND POWERS (%d values; one in eight is not a power of two)\n", LG_BENCHMARK_VALUES);
+    uint64_t start = benchmark_nanoseconds();
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        accumulator += switch_lg(values[i]);
+    }
+    double switched = (double) (benchmark_nanoseconds() - start);
+    start = benchmark_nanoseconds();
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        accumulator += lg(values[i]);
+    }
+    double branch_free = (double) (benchmark_nanoseconds() - start);
+    start = benchmark_nanoseconds();
+    lg_batch(values, batch_exponents, LG_BENCHMARK_VALUES);
+    double batched = (double) (benchmark_nanoseconds() - start);
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        int expected = switch_lg(values[i]);
+        lg_mismatches += (lg(values[i]) != expected) + (batch_exponents[i] != expected);
+    }
+    printf("\tlg:           switch %6.2f ns/call    branch-free %6.2f ns/call    batch %6.2f ns/value    %d differences\n",
+           switched / LG_BENCHMARK_VALUES, branch_free / LG_BENCHMARK_VALUES, batched / LG_BENCHMARK_VALUES,
+           lg_mismatches);
+    start = benchmark_nanoseconds();
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        accumulator += (int) exponentiate(exponents[i]);
+    }
+    double scalar = (double) (benchmark_nanoseconds() - start);
+    start = benchmark_nanoseconds();
+    exponentiate_batch(exponents, powers, LG_BENCHMARK_VALUES);
+    batched = (double) (benchmark_nanoseconds() - start);
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        exponentiate_mismatches += powers[i] != exponentiate(exponents[i]);
+    }
+    printf("\texponentiate: scalar %6.2f ns/call    batch %6.2f ns/value    %d differences\n",
+           scalar / LG_BENCHMARK_VALUES, batched / LG_BENCHMARK_VALUES, exponentiate_mismatches);
+    // every power of two and its neighbours, then the random values
+    for (int exponent = 0; exponent < 32; exponent++) {
+        uint32_t power = UINT32_C(1) << exponent;
+        uint32_t neighbours[] = {power - 1, power, power + 1};
+        for (int j = 0; j < 3; j++) {
+            uint32_t value = neighbours[j];
+            int expected_floor = reference_floor_lg(value);
+            int expected_ceil = value > 1 ? reference_floor_lg((uint64_t) value - 1) + 1 : 0;
+            rounding_mismatches += (floor_lg(value) != expected_floor) + (ceil_lg(value) != expected_ceil);
+        }
+    }
+    start = benchmark_nanoseconds();
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i++) {
+        accumulator += floor_lg(values[i]) + ceil_lg(values[i]);
+    }
+    double rounding = (double) (benchmark_nanoseconds() - start);
+    for (size_t i = 0; i < LG_BENCHMARK_VALUES; i += 8) {
+        uint32_t value = values[i];
+        int expected_ceil = value > 1 ? reference_floor_lg((uint64_t) value - 1) + 1 : 0;
+        rounding_mismatches += (floor_lg(value) != reference_floor_lg(value)) + (ceil_lg(value) != expected_ceil);
+    }
+    printf("\tfloor_lg and ceil_lg: %6.2f ns/call    %d differences\n", rounding / LG_BENCHMARK_VALUES / 2,
+           rounding_mismatches);
+    benchmark_sink = (uint16_t) accumulator;
+    free(values);
+    free(exponents);
+    free(batch_exponents);
+    free(powers);
+}
+
+static void benchmark_float16(void) {
+    float16_t operands1[FLOAT16_BENCHMARK_PAIRS], operands2[FLOAT16_BENCHMARK_PAIRS];
+    float16_t results[FLOAT16_BENCHMARK_PAIRS], expected[FLOAT16_BENCHMARK_PAIRS];
+    uint32_t seed = 0xF16;
+    for (int i = 0; i < FLOAT16_BENCHMARK_PAIRS; i++) {
+        operands1[i] = (float16_t) benchmark_random(&seed);
+        operands2[i] = (float16_t) benchmark_random(&seed);
+    }
+    printf("16-BIT FLOATING POINT ON THE ALU (%d random encodings per operation)\n", FLOAT16_BENCHMARK_PAIRS);
+    printf("\t%-9s %-9s %14s %14s %12s\n", "format", "operation", "ALU", "host", "differences");
+    for (float16_format_t format = FLOAT16_BINARY16; format < NUMBER_OF_FLOAT16_FORMATS; format++) {
+        for (float16_operation_t operation = FLOAT16_ADD; operation < NUMBER_OF_FLOAT16_OPERATIONS; operation++) {
+            uint64_t start = benchmark_nanoseconds();
+            float16_batch(format, operation, operands1, operands2, results, FLOAT16_BENCHMARK_PAIRS);
+            double alu = (double) (benchmark_nanoseconds() - start);
+            start = benchmark_nanoseconds();
+            for (int i = 0; i < FLOAT16_BENCHMARK_PAIRS; i++) {
+                expected[i] = float16_host(format, operation, operands1[i], operands2[i]);
+            }
+            double host = (double) (benchmark_nanoseconds() - start);
+            int mismatches = 0;
+            for (int i = 0; i < FLOAT16_BENCHMARK_PAIRS; i++) {
+                bool both_nan = operation != FLOAT16_COMPARE && float16_is_nan(format, expected[i])
+                                && float16_is_nan(format, results[i]);
+                mismatches += expected[i] != results[i] && !both_nan;
+            }
+            printf("\t%-9s %-9s %7.3f MFLOP/s %7.3f MFLOP/s %12d\n", float16_format_name(format),
+                   float16_operation_name(operation), FLOAT16_BENCHMARK_PAIRS / alu * 1e3,
+                   FLOAT16_BENCHMARK_PAIRS / host * 1e3, mismatches);
+        }
+    }
+}
+
+static ripple_carry_adder_t unrolled_adder(int adder, uint32_t value1, uint32_t value2, uint8_t carry_in) {
+    switch (adder) {
+        case 0:
+            return ripple_carry_addition_with_carry_out(value1, value2, carry_in);
+        case 1:
+            return unrolled_addition32(value1, value2, carry_in);
+        case 2:
+            return unrolled_addition32_carry0(value1, value2);
+        case 3:
+            return unrolled_addition32_carry1(value1, value2);
+        case 4:
+            return unrolled_addition16(value1, value2, carry_in);
+        case 5:
+            return unrolled_addition16_carry0(value1, value2);
+        case 6:
+            return unrolled_addition16_carry1(value1, value2);
+        case 7:
+            return unrolled_addition8(value1, value2, carry_in);
+        case 8:
+            return unrolled_addition8_carry0(value1, value2);
+        default:
+            return unrolled_addition8_carry1(value1, value2);
+    }
+}
+
+static void benchmark_unrolled(void) {
+    static const struct {
+        const char *name;
+        int width;
+        int carry_in;                   // -1 when the carry-in is an argument
+    } adders[UNROLLED_BENCHMARK_ADDERS] = {
+            {"ripple_carry_addition", 32, -1},
+            {"unrolled_addition32", 32, -1}, {"unrolled_addition32_carry0", 32, 0}, {"unrolled_addition32_carry1", 32, 1},
+            {"unrolled_addition16", 16, -1}, {"unrolled_addition16_carry0", 16, 0}, {"unrolled_addition16_carry1", 16, 1},
+            {"unrolled_addition8", 8, -1}, {"unrolled_addition8_carry0", 8, 0}, {"unrolled_addition8_carry1", 8, 1},
+    };
+    uint32_t *operands1 = malloc(UNROLLED_BENCHMARK_PAIRS * sizeof(uint32_t));
+    uint32_t *operands2 = malloc(UNROLLED_BENCHMARK_PAIRS * sizeof(uint32_t));
+    uint8_t *carries = malloc(UNROLLED_BENCHMARK_PAIRS);
+    ripple_carry_adder_t *sums = malloc(UNROLLED_BENCHMARK_PAIRS * sizeof(ripple_carry_adder_t));
+    uint32_t seed = 0xADD;
+    for (int i = 0; i < UNROLLED_BENCHMARK_PAIRS; i++) {
+        operands1[i] = benchmark_random(&seed);
+        operands2[i] = benchmark_random(&seed);
+        carries[i] = (uint8_t) (benchmark_random(&seed) & 0x1);
+    }
+    printf("UNROLLED RIPPLE-CARRY ADDERS (%d random pairs)\n", UNROLLED_BENCHMARK_PAIRS);
+    printf("\t%-27s %12s %20s %12s\n", "adder", "ns/addition", "one-bit calls/add", "differences");
+    for (int adder = 0; adder < UNROLLED_BENCHMARK_ADDERS; adder++) {
+        int width = adders[adder].width;
+        uint64_t mask = (UINT64_C(1) << width) - 1;
+        reset_call_counts();
+        uint64_t start = benchmark_nanoseconds();
+        for (int i = 0; i < UNROLLED_BENCHMARK_PAIRS; i++) {
+            sums[i] = unrolled_adder(adder, operands1[i], operands2[i], carries[i]);
+        }
+        double elapsed = (double) (benchmark_nanoseconds() - start);
+        int calls = get_call_counts(one_bit_full_addition);
+        int mismatches = 0;
+        for (int i = 0; i < UNROLLED_BENCHMARK_PAIRS; i++) {
+            uint8_t carry_in = adders[adder].carry_in < 0 ? carries[i] : (uint8_t) adders[adder].carry_in;
+            uint64_t expected = (operands1[i] & mask) + (operands2[i] & mask) + carry_in;
+            mismatches += (sums[i].sum != (expected & mask)) + (sums[i].c_out != ((expected >> width) & 0x1));
+        }
+        printf("\t%-27s %12.2f %20.2f %12d\n", adders[adder].name, elapsed / UNROLLED_BENCHMARK_PAIRS,
+               (double) calls / UNROLLED_BENCHMARK_PAIRS, mismatches);
+    }
+    // the 16-bit operations, which the unrolled 16-bit adder completes in half of the one-bit additions
+    static const struct {
+        const char *name;
+        binary_operation_t loop;
+        binary_operation_t unrolled;
+    } operations[] = {{"add", add, unrolled_add}, {"subtract", subtract, unrolled_subtract}};
+    for (size_t operation = 0; operation < sizeof(operations) / sizeof(operations[0]); operation++) {
+        uint16_t accumulator = 0;
+        int mismatches = 0;
+        uint64_t start = benchmark_nanoseconds();
+        for (int i = 0; i < UNROLLED_BENCHMARK_PAIRS; i++) {
+            accumulator ^= operations[operation].loop((uint16_t) operands1[i], (uint16_t) operands2[i]).result;
+        }
+        double loop = (double) (benchmark_nanoseconds() - start);
+        start = benchmark_nanoseconds();
+        for (int i = 0; i < UNROLLED_BENCHMARK_PAIRS; i++) {
+            accumulator ^= operations[operation].unrolled((uint16_t) operands1[i], (uint16_t) operands2[i]).result;
+        }
+        double unrolled = (double) (benchmark_nanoseconds() - start);
+        for (int i = 0; i < UNROLLED_BENCHMARK_PAIRS; i++) {
+            alu_result_t expected = operations[operation].loop((uint16_t) operands1[i], (uint16_t) operands2[i]);
+            alu_result_t actual = operations[operation].unrolled((uint16_t) operands1[i], (uint16_t) operands2[i]);
+            mismatches += expected.result != actual.result || expected.unsigned_overflow != actual.unsigned_overflow
+                          || expected.signed_overflow != actual.signed_overflow;
+        }
+        benchmark_sink = accumulator;
+        printf("\t%-8s loop %8.2f ns/call    unrolled %8.2f ns/call    %d differences\n", operations[operation].name,
+               loop / UNROLLED_BENCHMARK_PAIRS, unrolled / UNROLLED_BENCHMARK_PAIRS, mismatches);
+    }
+    free(operands1);
+    free(operands2);
+    free(carries);
+    free(sums);
+}
+
+/* saturates at each step, as the Q15 kernels' 32-bit accumulator does */
+static int64_t reference_accumulate(int64_t accumulator, int64_t addend) {
+    int64_t total = accumulator + addend;
+    return total > INT32_MAX ? INT32_MAX : total < INT32_MIN ? INT32_MIN : total;
+}
+
+static q15_t reference_narrow(int64_t accumulator, int places) {
+    int64_t quotient = reference_accumulate(accumulator, (INT64_C(1) << places) >> 1) >> places;
+    return (q15_t) (quotient > INT16_MAX ? INT16_MAX : quotient < INT16_MIN ? INT16_MIN : quotient);
+}
+
+static void reference_butterfly(q15_complex_t *top, q15_complex_t *bottom, q15_complex_t twiddle) {
+    int64_t twiddle_real = (int16_t) twiddle.real, twiddle_imaginary = (int16_t) twiddle.imaginary;
+    int64_t bottom_real = (int16_t) bottom->real, bottom_imaginary = (int16_t) bottom->imaginary;
+    int64_t rotated_real = reference_accumulate(twiddle_real * bottom_real, -(twiddle_imaginary * bottom_imaginary));
+    int64_t rotated_imaginary = reference_accumulate(twiddle_real * bottom_imaginary, twiddle_imaginary * bottom_real);
+    int64_t top_real = (int64_t) (int16_t) top->real << Q15_FRACTION;
+    int64_t top_imaginary = (int64_t) (int16_t) top->imaginary << Q15_FRACTION;
+    top->real = reference_narrow(reference_accumulate(top_real, rotated_real), Q15_FRACTION + 1);
+    top->imaginary = reference_narrow(reference_accumulate(top_imaginary, rotated_imaginary), Q15_FRACTION + 1);
+    bottom->real = reference_narrow(reference_accumulate(top_real, -rotated_real), Q15_FRACTION + 1);
+    bottom->imaginary = reference_narrow(reference_accumulate(top_imaginary, -rotated_imaginary), Q15_FRACTION + 1);
+}
+
+static void benchmark_q15(void) {
+    q15_t signal[Q15_BENCHMARK_SAMPLES], other[Q15_BENCHMARK_SAMPLES];
+    q15_t results[Q15_BENCHMARK_SAMPLES], expected[Q15_BENCHMARK_SAMPLES];
+    q15_t coefficients[Q15_BENCHMARK_TAPS];
+    q15_complex_t spectrum[Q15_BENCHMARK_FFT_POINTS], reference_spectrum[Q15_BENCHMARK_FFT_POINTS];
+    q15_complex_t twiddles[Q15_BENCHMARK_FFT_POINTS / 2];
+    uint32_t seed = 0x015;
+    for (int i = 0; i < Q15_BENCHMARK_SAMPLES; i++) {
+        // a sine wave with noise, and an arbitrary second signal that drives the saturating operations into both bounds
+        signal[i] = q15_from_double(0.6 * sin(i * 0.05) + 0.3 * ((int16_t) benchmark_random(&seed) / 32768.0));
+        other[i] = (q15_t) benchmark_random(&seed);
+    }
+    for (int k = 0; k < Q15_BENCHMARK_TAPS; k++) {
+        // a windowed low-pass filter whose coefficients sum to a little under 1
+        coefficients[k] = q15_from_double((1 - cos(2 * Q15_BENCHMARK_PI * (k + 1) / (Q15_BENCHMARK_TAPS + 1)))
+                                          / (Q15_BENCHMARK_TAPS + 1));
+    }
+    q15_fft_twiddles(twiddles, Q15_BENCHMARK_FFT_POINTS);
+    printf("Q15 FIXED-POINT SIGNAL PROCESSING (%d samples; %d-tap FIR; %d-sample moving average; %d-point FFT)\n",
+           Q15_BENCHMARK_SAMPLES, Q15_BENCHMARK_TAPS, Q15_BENCHMARK_WINDOW, Q15_BENCHMARK_FFT_POINTS);
+    printf("\t%-15s %16s %16s %12s\n", "kernel", "ALU", "adder passes", "differences");
+    for (int kernel = 0; kernel < 7; kernel++) {
+        static const char *names[] = {"add", "subtract", "multiply", "dot product", "FIR", "moving average", "FFT"};
+        int samples = kernel == 6 ? Q15_BENCHMARK_FFT_POINTS : Q15_BENCHMARK_SAMPLES;
+        int mismatches = 0;
+        reset_call_counts();
+        uint64_t start = benchmark_nanoseconds();
+        switch (kernel) {
+            case 0:
+                for (int i = 0; i < samples; i++) {
+                    results[i] = q15_add(signal[i], other[i]);
+                }
+                break;
+            case 1:
+                for (int i = 0; i < samples; i++) {
+                    results[i] = q15_subtract(signal[i], other[i]);
+                }
+                break;
+            case 2:
+                for (int i = 0; i < samples; i++) {
+                    results[i] = q15_multiply(signal[i], other[i]);
+                }
+                break;
+            case 3:
+                results[0] = q15_dot_product(signal, other, (size_t) samples);
+                break;
+            case 4:
+                q15_fir(coefficients, Q15_BENCHMARK_TAPS, signal, results, (size_t) samples);
+                break;
+            case 5:
+                mismatches += !q15_moving_average(signal, results, (size_t) samples, Q15_BENCHMARK_WINDOW);
+                break;
+            default:
+                for (int i = 0; i < samples; i++) {
+                    spectrum[i].real = signal[i];
+                    spectrum[i].imaginary = 0;
+                }
+                q15_fft(spectrum, twiddles, (size_t) samples);
+        }
+        double elapsed = (double) (benchmark_nanoseconds() - start);
+        int passes = get_call_counts(ripple_carry_addition);
+        // the references compute the same saturating, once-rounded results in 64-bit host arithmetic
+        int64_t accumulator = 0;
+        switch (kernel) {
+            case 0:
+            case 1:
+            case 2:
+                for (int i = 0; i < samples; i++) {
+                    int64_t value1 = (int16_t) signal[i], value2 = (int16_t) other[i];
+                    int64_t exact = kernel == 0 ? value1 + value2 : value1 - value2;
+                    expected[i] = kernel == 2 ? reference_narrow(value1 * value2, Q15_FRACTION)
+                                              : (q15_t) (exact > INT16_MAX ? INT16_MAX
+                                                                           : exact < INT16_MIN ? INT16_MIN : exact);
+                    mismatches += results[i] != expected[i];
+                }
+                break;
+            case 3:
+                for (int i = 0; i < samples; i++) {
+                    accumulator = reference_accumulate(accumulator, (int64_t) (int16_t) signal[i] * (int16_t) other[i]);
+                }
+                mismatches += results[0] != reference_narrow(accumulator, Q15_FRACTION);
+                break;
+            case 4:
+                for (int i = 0; i < samples; i++) {
+                    accumulator = 0;
+                    for (int k = 0; k < Q15_BENCHMARK_TAPS && k <= i; k++) {
+                        accumulator = reference_accumulate(accumulator,
+                                                           (int64_t) (int16_t) coefficients[k] * (int16_t) signal[i - k]);
+                    }
+                    mismatches += results[i] != reference_narrow(accumulator, Q15_FRACTION);
+                }
+                break;
+            case 5:
+                for (int i = 0; i < samples; i++) {
+                    accumulator += (int16_t) signal[i];
+                    accumulator -= i >= Q15_BENCHMARK_WINDOW ? (int16_t) signal[i - Q15_BENCHMARK_WINDOW] : 0;
+                    mismatches += results[i] != reference_narrow(accumulator, floor_lg(Q15_BENCHMARK_WINDOW));
+                }
+                break;
+            default:
+                // the same bit-reversed, in-place schedule, with the same twiddles, but host butterflies
+                for (int i = 0; i < samples; i++) {
+                    int j = 0;
+                    for (int bit = 1; bit < samples; bit <<= 1) {
+                        j = j << 1 | ((i & bit) != 0);
+                    }
+                    reference_spectrum[j].real = signal[i];
+                    reference_spectrum[j].imaginary = 0;
+                }
+                for (int span = 1; span < samples; span <<= 1) {
+                    for (int base = 0; base < samples; base += span << 1) {
+                        for (int k = 0; k < span; k++) {
+                            double angle = 2 * Q15_BENCHMARK_PI * k * (samples / (span << 1)) / samples;
+                            q15_complex_t twiddle = {q15_from_double(cos(angle)), q15_from_double(-sin(angle))};
+                            reference_butterfly(reference_spectrum + base + k, reference_spectrum + base + k + span,
+                                                twiddle);
+                        }
+                    }
+                }
+                for (int i = 0; i < samples; i++) {
+                    mismatches += spectrum[i].real != reference_spectrum[i].real
+                                  || spectrum[i].imaginary != reference_spectrum[i].imaginary;
+                }
+        }
+        printf("\t%-15s %8.1f samples/s %9.1f/sample %12d\n", names[kernel], samples / elapsed * 1e9,
+               (double) passes / samples, mismatches);
+    }
+}
+
+static alu_result_t out_of_line(alu_batch_operation_t operation, uint16_t operand1, uint16_t operand2) {
+    switch (operation) {
+        case ALU_BATCH_ADD:
+            return add(operand1, operand2);
+        case ALU_BATCH_SUBTRACT:
+            return subtract(operand1, operand2);
+        case ALU_BATCH_UNSIGNED_MULTIPLY:
+            return unsigned_multiply(operand1, operand2);
+        case ALU_BATCH_SIGNED_MULTIPLY:
+            return signed_multiply(operand1, operand2);
+        case ALU_BATCH_UNSIGNED_DIVIDE:
+            return unsigned_divide(operand1, operand2);
+        case ALU_BATCH_COMPARE:
+            return (alu_result_t) {.result = compare(operand1, operand2)};
+        case ALU_BATCH_EQUAL:
+            return (alu_result_t) {.result = equal(operand1, operand2)};
+        default:
+            return (alu_result_t) {.result = is_negative(operand1)};
+    }
+}
+
+static void benchmark_inline(void) {
+    uint16_t operands1[INLINE_BENCHMARK_PAIRS], operands2[INLINE_BENCHMARK_PAIRS], divisors[INLINE_BENCHMARK_PAIRS];
+    alu_result_t expected[INLINE_BENCHMARK_PAIRS], actual[INLINE_BENCHMARK_PAIRS];
+    uint32_t seed = 0x1411;
+    for (int i = 0; i < INLINE_BENCHMARK_PAIRS; i++) {
+        operands1[i] = (uint16_t) benchmark_random(&seed);
+        operands2[i] = (uint16_t) benchmark_random(&seed);
+        // one divisor in seventeen is zero
+        divisors[i] = (uint16_t) (i % 17 ? 1 << (benchmark_random(&seed) & 0xF) : 0);
+    }
+    printf("INLINED ALU (%d random pairs; calls are the profiler's count of ripple_carry_addition)\n",
+           INLINE_BENCHMARK_PAIRS);
+    printf("\t%-18s %14s %8s %14s %8s %10s %12s\n", "operation", "out-of-line", "calls", "inlined", "calls",
+           "speedup", "differences");
+    for (alu_batch_operation_t operation = ALU_BATCH_ADD; operation < NUMBER_OF_ALU_BATCH_OPERATIONS; operation++) {
+        const uint16_t *second = operation == ALU_BATCH_UNSIGNED_DIVIDE ? divisors : operands2;
+        reset_call_counts();
+        uint64_t start = benchmark_nanoseconds();
+        for (int i = 0; i < INLINE_BENCHMARK_PAIRS; i++) {
+            expected[i] = out_of_line(operation, operands1[i], second[i]);
+        }
+        double called = (double) (benchmark_nanoseconds() - start);
+        int out_of_line_calls = get_call_counts(ripple_carry_addition);
+        reset_call_counts();
+        start = benchmark_nanoseconds();
+        alu_batch(operation, operands1, second, actual, INLINE_BENCHMARK_PAIRS);
+        double inlined = (double) (benchmark_nanoseconds() - start);
+        int inlined_calls = get_call_counts(ripple_carry_addition);
+        int mismatches = 0;
+        for (int i = 0; i < INLINE_BENCHMARK_PAIRS; i++) {
+            // a division by zero makes no promises about the quotient and remainder
+            bool defined = operation != ALU_BATCH_UNSIGNED_DIVIDE || second[i];
+            mismatches += expected[i].divide_by_zero != actual[i].divide_by_zero
+                          || (defined && (expected[i].result != actual[i].result
+                                          || expected[i].supplemental_result != actual[i].supplemental_result
+                                          || expected[i].unsigned_overflow != actual[i].unsigned_overflow
+                                          || expected[i].signed_overflow != actual[i].signed_overflow));
+        }
+        printf("\t%-18s %8.2f ns/op %8d %8.2f ns/op %8d %9.1fx %12d\n", alu_batch_operation_name(operation),
+               called / INLINE_BENCHMARK_PAIRS, out_of_line_calls, inlined / INLINE_BENCHMARK_PAIRS, inlined_calls,
+               called / inlined, mismatches);
+    }
+}
+
+/* a mix of the ALU's operations, so that the report has several ALU functions to tell apart */
+static uint16_t sampled_workload(const uint16_t *operands1, const uint16_t *operands2) {
+    uint16_t accumulator = 0;
+    for (int i = 0; i < SAMPLER_BENCHMARK_PAIRS * SAMPLER_BENCHMARK_PASSES; i++) {
+        uint16_t operand1 = operands1[i % SAMPLER_BENCHMARK_PAIRS], operand2 = operands2[i % SAMPLER_BENCHMARK_PAIRS];
+        accumulator ^= add(operand1, operand2).result;
+        accumulator ^= subtract(operand1, operand2).result;
+        accumulator ^= unsigned_multiply(operand1, operand2 & 0xFF).result;
+        accumulator ^= compare(operand1, operand2);
+    }
+    return accumulator;
+}
+
+static void benchmark_sampler(void) {
+    uint16_t operands1[SAMPLER_BENCHMARK_PAIRS], operands2[SAMPLER_BENCHMARK_PAIRS];
+    uint32_t seed = 0x5A3;
+    for (int i = 0; i < SAMPLER_BENCHMARK_PAIRS; i++) {
+        operands1[i] = (uint16_t) benchmark_random(&seed);
+        operands2[i] = (uint16_t) benchmark_random(&seed);
+    }
+    printf("SAMPLING PROFILER (add, subtract, 8-bit multiply, and compare on %d random pairs, %d times)\n",
+           SAMPLER_BENCHMARK_PAIRS, SAMPLER_BENCHMARK_PASSES);
+    benchmark_sink = sampled_workload(operands1, operands2);     // warm up, so that both timed runs start alike
+    uint64_t start = benchmark_nanoseconds();
+    benchmark_sink = sampled_workload(operands1, operands2);
+    double unsampled = (double) (benchmark_nanoseconds() - start);
+    if (!sampler_start(SAMPLER_DEFAULT_INTERVAL, NULL)) {
+        printf("\tCannot start the sampler (is it already running?)\n");
+        return;
+    }
+    start = benchmark_nanoseconds();
+    benchmark_sink = sampled_workload(operands1, operands2);
+    double sampled = (double) (benchmark_nanoseconds() - start);
+    sampler_summary_t summary;
+    sampler_stop(&summary);
+    // the kernel may round the interval up to its own timer tick
+    printf("\tunsampled %.2f ms    sampled %.2f ms    overhead %+.1f%%    one sample per %.2f ms (%d us requested)\n",
+           unsampled / 1e6, sampled / 1e6, 100.0 * (sampled - unsampled) / unsampled,
+           summary.samples ? sampled / 1e6 / (double) summary.samples : 0.0, SAMPLER_DEFAULT_INTERVAL);
+    printf("\tthe %d functions with the most samples:\n", SAMPLER_BENCHMARK_FUNCTIONS);
+    sampler_report(stdout, NULL, SAMPLER_BENCHMARK_FUNCTIONS, NULL);
+}
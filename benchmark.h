@@ -0,0 +1,28 @@
+/**************************************************************************//**
+ *
+ * @file benchmark.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for IntegerLab's timing helpers and for the
+ *      benchmarks that the driver can run.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+
+uint64_t benchmark_nanoseconds(void) __attribute__ ((no_instrument_function));
+uint32_t benchmark_random(uint32_t *state) __attribute__ ((no_instrument_function));
+
+void evaluate_print_constant_time_check(void) __attribute__ ((no_instrument_function));
+void evaluate_print_benchmark(const char *arguments) __attribute__ ((no_instrument_function));
+
+#endif //BENCHMARK_H
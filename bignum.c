@@ -0,0 +1,392 @@
+/**************************************************************************//**
+ *
+ * @file bignum.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Arbitrary-precision unsigned arithmetic built on the ALU's
+ *      primitives.
+ *
+ * Limbs are added by chaining ripple_carry_addition_with_carry_out, and limb
+ * products are assembled from four of the ALU's 16x16-bit unsigned_multiply
+ * products. Temporaries come from a caller-supplied arena rather than from
+ * malloc.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "alu_extensions.h"
+#include "bignum.h"
+
+static void limb_multiply(limb_t multiplicand, limb_t multiplier, limb_t *low, limb_t *high);
+static uint32_t full_product(alu_result_t product);
+static uint8_t add_into(limb_t *target, size_t target_limbs, const limb_t *value, size_t value_limbs);
+static uint8_t subtract_from(limb_t *target, size_t target_limbs, const limb_t *value, size_t value_limbs);
+static bool karatsuba_multiply(limb_t *product, const limb_t *multiplicand, const limb_t *multiplier,
+                               size_t number_of_limbs, bignum_arena_t *arena);
+
+/*
+ * ARENA
+ */
+
+/**
+ * Prepares an arena from which temporaries can be allocated without calling malloc for each of them.
+ * @param arena the arena to be prepared
+ * @param capacity the number of bytes that the arena can hold
+ * @return 1 if the arena's memory was obtained; 0 otherwise
+ */
+bool bignum_arena_initialize(bignum_arena_t *arena, size_t capacity) {
+    arena->memory = malloc(capacity);
+    arena->capacity = arena->memory ? capacity : 0;
+    arena->used = 0;
+    return arena->memory != NULL;
+}
+
+/**
+ * Releases an arena's memory.
+ * @param arena the arena to be destroyed
+ */
+void bignum_arena_destroy(bignum_arena_t *arena) {
+    free(arena->memory);
+    arena->memory = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+/**
+ * Records how much of the arena is in use, so that everything allocated afterward can be released at once.
+ * @param arena the arena
+ * @return the mark to be passed to <code>bignum_arena_release</code>
+ */
+size_t bignum_arena_mark(const bignum_arena_t *arena) {
+    return arena->used;
+}
+
+/**
+ * Releases everything allocated from the arena since the mark was taken.
+ * @param arena the arena
+ * @param mark a value previously returned by <code>bignum_arena_mark</code>
+ */
+void bignum_arena_release(bignum_arena_t *arena, size_t mark) {
+    arena->used = mark;
+}
+
+/**
+ * Allocates zero-filled limbs from the arena.
+ * @param arena the arena
+ * @param number_of_limbs the number of limbs to allocate
+ * @return the limbs, or NULL if the arena is exhausted
+ */
+limb_t *bignum_arena_allocate(bignum_arena_t *arena, size_t number_of_limbs) {
+    size_t bytes = number_of_limbs * sizeof(limb_t);
+    if (bytes > arena->capacity - arena->used) {
+        return NULL;
+    }
+    limb_t *limbs = (limb_t *) (arena->memory + arena->used);
+    arena->used += bytes;
+    memset(limbs, 0, bytes);
+    return limbs;
+}
+
+/**
+ * Determines how many limbs of arena space <code>bignum_multiply</code> needs for operands of a given length.
+ * @param number_of_limbs the number of limbs in each operand
+ * @return an upper bound on the number of scratch limbs that the multiplication will allocate
+ */
+size_t bignum_multiply_scratch_limbs(size_t number_of_limbs) {
+    size_t scratch = 0;
+    while (number_of_limbs >= BIGNUM_KARATSUBA_THRESHOLD) {
+        size_t upper_half = number_of_limbs - number_of_limbs / 2;
+        scratch += 4 * upper_half + 2;
+        number_of_limbs = upper_half;
+    }
+    return scratch;
+}
+
+/*
+ * LIMB ARITHMETIC
+ */
+
+static uint32_t full_product(alu_result_t product) {
+    return ((uint32_t) product.supplemental_result << 16) | product.result;
+}
+
+/**
+ * Multiplies two limbs by combining four 16x16-bit products from the ALU.
+ * @param multiplicand the limb to be multiplied
+ * @param multiplier the limb that the first is to be multiplied by
+ * @param low receives the low limb of the 64-bit product
+ * @param high receives the high limb of the 64-bit product
+ */
+static void limb_multiply(limb_t multiplicand, limb_t multiplier, limb_t *low, limb_t *high) {
+    uint32_t low_low = full_product(unsigned_multiply((uint16_t) multiplicand, (uint16_t) multiplier));
+    uint32_t low_high = full_product(unsigned_multiply((uint16_t) multiplicand, (uint16_t) (multiplier >> 16)));
+    uint32_t high_low = full_product(unsigned_multiply((uint16_t) (multiplicand >> 16), (uint16_t) multiplier));
+    uint32_t high_high = full_product(unsigned_multiply((uint16_t) (multiplicand >> 16),
+                                                        (uint16_t) (multiplier >> 16)));
+    ripple_carry_adder_t middle = ripple_carry_addition_with_carry_out(low_high, high_low, 0);
+    ripple_carry_adder_t low_sum = ripple_carry_addition_with_carry_out(low_low, middle.sum << 16, 0);
+    uint32_t high_sum = ripple_carry_addition(high_high, middle.sum >> 16, low_sum.c_out);
+    *low = low_sum.sum;
+    *high = ripple_carry_addition(high_sum, (uint32_t) middle.c_out << 16, 0);
+}
+
+/**
+ * Adds a value into a possibly-longer target, propagating the carry through the target's remaining limbs.
+ * @return the carry out of the target's most-significant limb
+ */
+static uint8_t add_into(limb_t *target, size_t target_limbs, const limb_t *value, size_t value_limbs) {
+    uint8_t carry = 0;
+    for (size_t i = 0; i < target_limbs && (i < value_limbs || carry); i++) {
+        ripple_carry_adder_t sum = ripple_carry_addition_with_carry_out(target[i], i < value_limbs ? value[i] : 0,
+                                                                        carry);
+        target[i] = sum.sum;
+        carry = sum.c_out;
+    }
+    return carry;
+}
+
+/**
+ * Subtracts a value from a possibly-longer target, propagating the borrow through the target's remaining limbs.
+ * @return the borrow out of the target's most-significant limb
+ */
+static uint8_t subtract_from(limb_t *target, size_t target_limbs, const limb_t *value, size_t value_limbs) {
+    uint8_t borrow = 0;
+    for (size_t i = 0; i < target_limbs && (i < value_limbs || borrow); i++) {
+        // a - b - borrow == a + ~b + !borrow
+        ripple_carry_adder_t difference = ripple_carry_addition_with_carry_out(
+                target[i], ~(i < value_limbs ? value[i] : 0), !borrow);
+        target[i] = difference.sum;
+        borrow = !difference.c_out;
+    }
+    return borrow;
+}
+
+/*
+ * ARBITRARY-PRECISION ARITHMETIC
+ */
+
+/**
+ * Compares two numbers of the same length.
+ * @param value1 the number on the left side of the comparison
+ * @param value2 the number on the right side of the comparison
+ * @param number_of_limbs the number of limbs in each number
+ * @return a negative value, zero, or a positive value if the first number is less than, equal to, or greater than the second
+ */
+int bignum_compare(const limb_t *value1, const limb_t *value2, size_t number_of_limbs) {
+    for (size_t i = number_of_limbs; i > 0; i--) {
+        if (value1[i - 1] != value2[i - 1]) {
+            return value1[i - 1] < value2[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Determines whether a number is zero.
+ * @param value the number to be evaluated
+ * @param number_of_limbs the number of limbs in the number
+ * @return 1 if every limb is zero; 0 otherwise
+ */
+bool bignum_is_zero(const limb_t *value, size_t number_of_limbs) {
+    limb_t any_bits = 0;
+    for (size_t i = 0; i < number_of_limbs; i++) {
+        any_bits |= value[i];
+    }
+    return is_zero(any_bits);
+}
+
+/**
+ * Adds two numbers of the same length. The sum may be stored over either operand.
+ * @param sum receives the sum's <code>number_of_limbs</code> limbs
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @param number_of_limbs the number of limbs in each number
+ * @return the carry out of the most-significant limb
+ */
+uint8_t bignum_add(limb_t *sum, const limb_t *augend, const limb_t *addend, size_t number_of_limbs) {
+    uint8_t carry = 0;
+    for (size_t i = 0; i < number_of_limbs; i++) {
+        ripple_carry_adder_t limb_sum = ripple_carry_addition_with_carry_out(augend[i], addend[i], carry);
+        sum[i] = limb_sum.sum;
+        carry = limb_sum.c_out;
+    }
+    return carry;
+}
+
+/**
+ * Subtracts two numbers of the same length. The difference may be stored over either operand.
+ * @param difference receives the difference's <code>number_of_limbs</code> limbs
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @param number_of_limbs the number of limbs in each number
+ * @return 1 if the subtraction borrowed out of the most-significant limb (the subtrahend was larger); 0 otherwise
+ */
+uint8_t bignum_subtract(limb_t *difference, const limb_t *menuend, const limb_t *subtrahend, size_t number_of_limbs) {
+    uint8_t carry = 1;
+    for (size_t i = 0; i < number_of_limbs; i++) {
+        ripple_carry_adder_t limb_difference = ripple_carry_addition_with_carry_out(menuend[i], ~subtrahend[i], carry);
+        difference[i] = limb_difference.sum;
+        carry = limb_difference.c_out;
+    }
+    return !carry;
+}
+
+/**
+ * Multiplies two numbers of the same length, one limb of the multiplier at a time.
+ * @param product receives the product's <code>2 * number_of_limbs</code> limbs; it must not overlap either operand
+ * @param multiplicand the number to be multiplied
+ * @param multiplier the number that the first is to be multiplied by
+ * @param number_of_limbs the number of limbs in each operand
+ */
+void bignum_schoolbook_multiply(limb_t *product, const limb_t *multiplicand, const limb_t *multiplier,
+                                size_t number_of_limbs) {
+    memset(product, 0, 2 * number_of_limbs * sizeof(limb_t));
+    for (size_t i = 0; i < number_of_limbs; i++) {
+        limb_t carry = 0;
+        if (is_zero(multiplier[i])) {
+            continue;
+        }
+        for (size_t j = 0; j < number_of_limbs; j++) {
+            limb_t low, high;
+            limb_multiply(multiplicand[j], multiplier[i], &low, &high);
+            // high:low + product[i + j] + carry never exceeds 64 bits
+            ripple_carry_adder_t partial = ripple_carry_addition_with_carry_out(low, product[i + j], 0);
+            high = ripple_carry_addition(high, 0, partial.c_out);
+            partial = ripple_carry_addition_with_carry_out(partial.sum, carry, 0);
+            high = ripple_carry_addition(high, 0, partial.c_out);
+            product[i + j] = partial.sum;
+            carry = high;
+        }
+        product[i + number_of_limbs] = carry;
+    }
+}
+
+/**
+ * Multiplies two numbers of the same length, using Karatsuba's method when the operands have at least
+ * <code>BIGNUM_KARATSUBA_THRESHOLD</code> limbs and schoolbook multiplication otherwise.
+ * @param product receives the product's <code>2 * number_of_limbs</code> limbs; it must not overlap either operand
+ * @param multiplicand the number to be multiplied
+ * @param multiplier the number that the first is to be multiplied by
+ * @param number_of_limbs the number of limbs in each operand
+ * @param arena the arena from which temporaries are allocated; it needs at least
+ *      <code>bignum_multiply_scratch_limbs(number_of_limbs)</code> limbs available
+ * @return 0 if the arena is exhausted (leaving the product's contents unspecified); 1 otherwise
+ */
+bool bignum_multiply(limb_t *product, const limb_t *multiplicand, const limb_t *multiplier, size_t number_of_limbs,
+                     bignum_arena_t *arena) {
+    size_t mark = bignum_arena_mark(arena);
+    bool multiplied = karatsuba_multiply(product, multiplicand, multiplier, number_of_limbs, arena);
+    bignum_arena_release(arena, mark);
+    return multiplied;
+}
+
+static bool karatsuba_multiply(limb_t *product, const limb_t *multiplicand, const limb_t *multiplier,
+                               size_t number_of_limbs, bignum_arena_t *arena) {
+    if (number_of_limbs < BIGNUM_KARATSUBA_THRESHOLD) {
+        bignum_schoolbook_multiply(product, multiplicand, multiplier, number_of_limbs);
+        return true;
+    }
+    // x = x1 * B^h + x0, where x0 has h limbs and x1 has m >= h limbs
+    size_t h = number_of_limbs / 2;
+    size_t m = number_of_limbs - h;
+    size_t mark = bignum_arena_mark(arena);
+    limb_t *multiplicand_sum = bignum_arena_allocate(arena, m);
+    limb_t *multiplier_sum = bignum_arena_allocate(arena, m);
+    limb_t *middle = bignum_arena_allocate(arena, 2 * m + 2);
+    if (!multiplicand_sum || !multiplier_sum || !middle) {
+        bignum_arena_release(arena, mark);
+        return false;
+    }
+    // (x0 + x1), (y0 + y1)
+    memcpy(multiplicand_sum, multiplicand + h, m * sizeof(limb_t));
+    memcpy(multiplier_sum, multiplier + h, m * sizeof(limb_t));
+    uint8_t multiplicand_carry = add_into(multiplicand_sum, m, multiplicand, h);
+    uint8_t multiplier_carry = add_into(multiplier_sum, m, multiplier, h);
+    // (x0 + x1)(y0 + y1), including the contributions of the sums' carry-out bits
+    if (!karatsuba_multiply(middle, multiplicand_sum, multiplier_sum, m, arena)) {
+        bignum_arena_release(arena, mark);
+        return false;
+    }
+    if (multiplicand_carry) {
+        add_into(middle + m, m + 2, multiplier_sum, m);
+    }
+    if (multiplier_carry) {
+        add_into(middle + m, m + 2, multiplicand_sum, m);
+    }
+    if (multiplicand_carry && multiplier_carry) {
+        limb_t one = 1;
+        add_into(middle + 2 * m, 2, &one, 1);
+    }
+    // x0 y0 occupies the low 2h limbs and x1 y1 the high 2m limbs
+    if (!karatsuba_multiply(product, multiplicand, multiplier, h, arena)
+        || !karatsuba_multiply(product + 2 * h, multiplicand + h, multiplier + h, m, arena)) {
+        bignum_arena_release(arena, mark);
+        return false;
+    }
+    // the middle term is (x0 + x1)(y0 + y1) - x0 y0 - x1 y1
+    subtract_from(middle, 2 * m + 2, product, 2 * h);
+    subtract_from(middle, 2 * m + 2, product + 2 * h, 2 * m);
+    size_t middle_limbs = 2 * m + 2 < 2 * number_of_limbs - h ? 2 * m + 2 : 2 * number_of_limbs - h;
+    add_into(product + h, 2 * number_of_limbs - h, middle, middle_limbs);
+    bignum_arena_release(arena, mark);
+    return true;
+}
+
+/**
+ * <p>Divides two numbers of the same length by shift-and-subtract long division, one bit of the dividend at a
+ * time.</p>
+ *
+ * <p>The quotient and remainder must not overlap the operands or each other.</p>
+ *
+ * @param quotient receives the quotient's <code>number_of_limbs</code> limbs
+ * @param remainder receives the remainder's <code>number_of_limbs</code> limbs
+ * @param dividend the number to be divided
+ * @param divisor the number that divides the first
+ * @param number_of_limbs the number of limbs in each number
+ * @param arena the arena from which the trial difference is allocated; it needs at least
+ *      <code>number_of_limbs</code> limbs available
+ * @return 0 if the divisor is zero or the arena is exhausted (leaving the quotient and remainder unmodified); 1
+ *      otherwise
+ */
+bool bignum_divide(limb_t *quotient, limb_t *remainder, const limb_t *dividend, const limb_t *divisor,
+                   size_t number_of_limbs, bignum_arena_t *arena) {
+    if (bignum_is_zero(divisor, number_of_limbs)) {
+        return false;
+    }
+    size_t divisor_limbs = number_of_limbs;
+    while (is_zero(divisor[divisor_limbs - 1])) {
+        divisor_limbs--;
+    }
+    // the remainder stays below twice the divisor, so it never needs more than one limb beyond the divisor's
+    size_t active_limbs = divisor_limbs < number_of_limbs ? divisor_limbs + 1 : number_of_limbs;
+    size_t mark = bignum_arena_mark(arena);
+    limb_t *trial = bignum_arena_allocate(arena, active_limbs);
+    if (trial == NULL) {
+        return false;
+    }
+    memset(quotient, 0, number_of_limbs * sizeof(limb_t));
+    memset(remainder, 0, number_of_limbs * sizeof(limb_t));
+    for (size_t bit = number_of_limbs * BIGNUM_LIMB_BITS; bit > 0; bit--) {
+        size_t limb = (bit - 1) / BIGNUM_LIMB_BITS;
+        int position = (int) ((bit - 1) % BIGNUM_LIMB_BITS);
+        limb_t shifted_out = remainder[active_limbs - 1] >> (BIGNUM_LIMB_BITS - 1);
+        for (size_t i = active_limbs - 1; i > 0; i--) {
+            remainder[i] = (remainder[i] << 1) | (remainder[i - 1] >> (BIGNUM_LIMB_BITS - 1));
+        }
+        remainder[0] = (remainder[0] << 1) | ((dividend[limb] >> position) & 0x1);
+        uint8_t borrow = bignum_subtract(trial, remainder, divisor, active_limbs);
+        if (shifted_out || !borrow) {
+            memcpy(remainder, trial, active_limbs * sizeof(limb_t));
+            quotient[limb] |= (limb_t) 1 << position;
+        }
+    }
+    bignum_arena_release(arena, mark);
+    return true;
+}
@@ -0,0 +1,57 @@
+/**************************************************************************//**
+ *
+ * @file bignum.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes and type declarations for arbitrary-precision
+ *      unsigned arithmetic built on the ALU's primitives.
+ *
+ * A number is a contiguous array of 32-bit limbs, least-significant limb
+ * first. Operands of a binary operation have the same number of limbs; pad
+ * the shorter one with zero limbs.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BIGNUM_LIMB_BITS            32
+#define BIGNUM_KARATSUBA_THRESHOLD  16      // operands of at least this many limbs use Karatsuba multiplication
+
+typedef uint32_t limb_t;
+
+typedef struct {
+    uint8_t *memory;
+    size_t capacity;
+    size_t used;
+} bignum_arena_t;
+
+bool bignum_arena_initialize(bignum_arena_t *arena, size_t capacity) __attribute__ ((no_instrument_function));
+void bignum_arena_destroy(bignum_arena_t *arena) __attribute__ ((no_instrument_function));
+size_t bignum_arena_mark(const bignum_arena_t *arena) __attribute__ ((no_instrument_function));
+void bignum_arena_release(bignum_arena_t *arena, size_t mark) __attribute__ ((no_instrument_function));
+limb_t *bignum_arena_allocate(bignum_arena_t *arena, size_t number_of_limbs) __attribute__ ((no_instrument_function));
+size_t bignum_multiply_scratch_limbs(size_t number_of_limbs) __attribute__ ((no_instrument_function));
+
+int bignum_compare(const limb_t *value1, const limb_t *value2, size_t number_of_limbs);
+bool bignum_is_zero(const limb_t *value, size_t number_of_limbs);
+uint8_t bignum_add(limb_t *sum, const limb_t *augend, const limb_t *addend, size_t number_of_limbs);
+uint8_t bignum_subtract(limb_t *difference, const limb_t *menuend, const limb_t *subtrahend, size_t number_of_limbs);
+void bignum_schoolbook_multiply(limb_t *product, const limb_t *multiplicand, const limb_t *multiplier,
+                                size_t number_of_limbs);
+bool bignum_multiply(limb_t *product, const limb_t *multiplicand, const limb_t *multiplier, size_t number_of_limbs,
+                     bignum_arena_t *arena);
+bool bignum_divide(limb_t *quotient, limb_t *remainder, const limb_t *dividend, const limb_t *divisor,
+                   size_t number_of_limbs, bignum_arena_t *arena);
+
+#endif //BIGNUM_H
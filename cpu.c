@@ -0,0 +1,687 @@
+/**************************************************************************//**
+ *
+ * @file cpu.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief A 16-bit CPU whose arithmetic is performed by the ALU, its
+ *      two-pass assembler, and a few workloads for it.
+ *
+ * The interpreter decodes each instruction the first time it is executed and
+ * caches the decoded form by address; a store into code invalidates the
+ * cached instructions that it overlaps. Each handler ends with its own
+ * computed goto to the next instruction's handler (a GNU C extension that gcc
+ * and clang both support).
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "trace.h"
+#include "cpu.h"
+
+#define CPU_LABELS          256
+#define CPU_LABEL_LENGTH    32
+#define CPU_LINE_LENGTH     256
+
+/* decoded-instruction opcodes that never appear in memory */
+#define UNDECODED           NUMBER_OF_CPU_OPCODES
+#define ILLEGAL             (NUMBER_OF_CPU_OPCODES + 1)
+
+typedef struct {
+    char name[CPU_LABEL_LENGTH];
+    uint16_t address;
+} label_t;
+
+typedef struct {
+    cpu_t *cpu;
+    label_t labels[CPU_LABELS];
+    int number_of_labels;
+    int pass;
+    int line_number;
+    uint16_t address;
+    char *error;
+    size_t error_size;
+} assembler_t;
+
+static bool fail(assembler_t *assembler, const char *message) __attribute__ ((no_instrument_function));
+static const char *skip_spaces(const char *text) __attribute__ ((no_instrument_function));
+static const char *parse_identifier(const char *text, char name[CPU_LABEL_LENGTH]) __attribute__ ((no_instrument_function));
+static bool parse_register(assembler_t *assembler, const char **text, uint8_t *number) __attribute__ ((no_instrument_function));
+static bool parse_value(assembler_t *assembler, const char **text, uint16_t *value) __attribute__ ((no_instrument_function));
+static bool expect(assembler_t *assembler, const char **text, char expected) __attribute__ ((no_instrument_function));
+static void emit_byte(assembler_t *assembler, uint8_t byte) __attribute__ ((no_instrument_function));
+static void emit_word(assembler_t *assembler, uint16_t word) __attribute__ ((no_instrument_function));
+static bool assemble_directive(assembler_t *assembler, const char *directive, const char *text) __attribute__ ((no_instrument_function));
+static bool assemble_line(assembler_t *assembler, const char *line) __attribute__ ((no_instrument_function));
+static void decode(cpu_t *cpu, uint16_t address) __attribute__ ((no_instrument_function));
+static bool verify_reduce(const cpu_t *cpu) __attribute__ ((no_instrument_function));
+static bool verify_sort(const cpu_t *cpu) __attribute__ ((no_instrument_function));
+static bool verify_fibonacci(const cpu_t *cpu) __attribute__ ((no_instrument_function));
+
+/*
+ * Each operand signature character names one operand: 'r' is a register (the first goes to the destination field,
+ * the second to source1, the third to source2), 'i' is an immediate value, and 'm' is an immediate offset and a
+ * base register written as "offset(register)", the register going to source1.
+ */
+static const struct {
+    const char *mnemonic;
+    const char *operands;
+} instruction_set[NUMBER_OF_CPU_OPCODES] = {
+        [CPU_HALT] = {"halt", ""},
+        [CPU_LOAD_IMMEDIATE] = {"li", "ri"},
+        [CPU_MOVE] = {"mov", "rr"},
+        [CPU_LOAD] = {"ld", "rm"},
+        [CPU_STORE] = {"st", "rm"},
+        [CPU_ADD] = {"add", "rrr"},
+        [CPU_ADD_IMMEDIATE] = {"addi", "rri"},
+        [CPU_SUBTRACT] = {"sub", "rrr"},
+        [CPU_MULTIPLY] = {"mul", "rrr"},
+        [CPU_DIVIDE] = {"div", "rrr"},
+        [CPU_REMAINDER] = {"rem", "rrr"},
+        [CPU_COMPARE] = {"cmp", "rr"},
+        [CPU_COMPARE_IMMEDIATE] = {"cmpi", "ri"},
+        [CPU_JUMP] = {"jmp", "i"},
+        [CPU_BRANCH_EQUAL] = {"beq", "i"},
+        [CPU_BRANCH_NOT_EQUAL] = {"bne", "i"},
+        [CPU_BRANCH_LESS_THAN] = {"blt", "i"},
+        [CPU_BRANCH_AT_MOST] = {"ble", "i"},
+        [CPU_BRANCH_GREATER_THAN] = {"bgt", "i"},
+        [CPU_BRANCH_AT_LEAST] = {"bge", "i"},
+        [CPU_BRANCH_UNSIGNED_LESS_THAN] = {"blo", "i"},
+        [CPU_BRANCH_UNSIGNED_AT_MOST] = {"bls", "i"},
+        [CPU_BRANCH_UNSIGNED_GREATER_THAN] = {"bhi", "i"},
+        [CPU_BRANCH_UNSIGNED_AT_LEAST] = {"bhs", "i"},
+};
+
+/*
+ * MACHINE STATE
+ */
+
+/**
+ * Clears the registers, flags, program counter, and instruction count, and discards the decoded instructions. Memory
+ * is left as it is.
+ * @param cpu the CPU to be reset
+ */
+void cpu_reset(cpu_t *cpu) {
+    memset(cpu->registers, 0, sizeof(cpu->registers));
+    cpu->program_counter = 0;
+    cpu->flags = 0;
+    cpu->instructions_retired = 0;
+    for (int i = 0; i < CPU_MEMORY_SIZE / 2; i++) {
+        cpu->decoded[i].opcode = UNDECODED;
+    }
+}
+
+/**
+ * Reads a little-endian word from the CPU's memory.
+ * @param cpu the CPU
+ * @param address the address of the word's low byte; the high byte's address wraps around to 0
+ * @return the word
+ */
+uint16_t cpu_read_word(const cpu_t *cpu, uint16_t address) {
+    return (uint16_t) (cpu->memory[address] | cpu->memory[(uint16_t) (address + 1)] << 8);
+}
+
+/**
+ * Describes why <code>cpu_run</code> stopped.
+ * @param status the value returned by <code>cpu_run</code>
+ * @return a short description
+ */
+const char *cpu_status_name(cpu_status_t status) {
+    switch (status) {
+        case CPU_HALTED:
+            return "halted";
+        case CPU_LIMIT_REACHED:
+            return "instruction limit reached";
+        case CPU_ILLEGAL_INSTRUCTION:
+            return "illegal instruction";
+        default:
+            return "divide by zero";
+    }
+}
+
+/*
+ * ASSEMBLER
+ */
+
+static bool fail(assembler_t *assembler, const char *message) {
+    snprintf(assembler->error, assembler->error_size, "line %d: %s", assembler->line_number, message);
+    return false;
+}
+
+static const char *skip_spaces(const char *text) {
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+    return text;
+}
+
+static const char *parse_identifier(const char *text, char name[CPU_LABEL_LENGTH]) {
+    int length = 0;
+    if (!isalpha((unsigned char) *text) && *text != '_' && *text != '.') {
+        return NULL;
+    }
+    while ((isalnum((unsigned char) *text) || *text == '_' || *text == '.') && length < CPU_LABEL_LENGTH - 1) {
+        name[length++] = *text++;
+    }
+    name[length] = '\0';
+    return text;
+}
+
+static bool parse_register(assembler_t *assembler, const char **text, uint8_t *number) {
+    const char *next = skip_spaces(*text);
+    char *end;
+    if (*next != 'r' || !isdigit((unsigned char) next[1])) {
+        return fail(assembler, "expected a register");
+    }
+    long value = strtol(next + 1, &end, 10);
+    if (value >= CPU_REGISTERS) {
+        return fail(assembler, "no such register");
+    }
+    *number = (uint8_t) value;
+    *text = end;
+    return true;
+}
+
+static bool parse_value(assembler_t *assembler, const char **text, uint16_t *value) {
+    const char *next = skip_spaces(*text);
+    bool negative = *next == '-';
+    char name[CPU_LABEL_LENGTH];
+    next = skip_spaces(next + negative);
+    if (isdigit((unsigned char) *next)) {
+        char *end;
+        *value = (uint16_t) strtoul(next, &end, (strncmp(next, "0x", 2) ? 10 : 16));
+        next = end;
+    } else if ((next = parse_identifier(next, name))) {
+        int i = 0;
+        while (i < assembler->number_of_labels && strcmp(assembler->labels[i].name, name)) {
+            i++;
+        }
+        if (i == assembler->number_of_labels && assembler->pass == 2) {
+            return fail(assembler, "undefined label");
+        }
+        // during the first pass, forward references only need to occupy space
+        *value = i < assembler->number_of_labels ? assembler->labels[i].address : 0;
+    } else {
+        return fail(assembler, "expected a number or a label");
+    }
+    *value = negative ? (uint16_t) -*value : *value;
+    *text = next;
+    return true;
+}
+
+static bool expect(assembler_t *assembler, const char **text, char expected) {
+    const char *next = skip_spaces(*text);
+    if (*next != expected) {
+        char message[32];
+        snprintf(message, sizeof(message), "expected '%c'", expected);
+        return fail(assembler, message);
+    }
+    *text = next + 1;
+    return true;
+}
+
+static void emit_byte(assembler_t *assembler, uint8_t byte) {
+    if (assembler->pass == 2) {
+        assembler->cpu->memory[assembler->address] = byte;
+    }
+    assembler->address++;
+}
+
+static void emit_word(assembler_t *assembler, uint16_t word) {
+    emit_byte(assembler, (uint8_t) word);
+    emit_byte(assembler, (uint8_t) (word >> 8));
+}
+
+static bool assemble_directive(assembler_t *assembler, const char *directive, const char *text) {
+    uint16_t value;
+    if (!strcmp(directive, ".org")) {
+        if (!parse_value(assembler, &text, &value)) {
+            return false;
+        }
+        assembler->address = value;
+    } else if (!strcmp(directive, ".word")) {
+        do {
+            if (!parse_value(assembler, &text, &value)) {
+                return false;
+            }
+            emit_word(assembler, value);
+            text = skip_spaces(text);
+        } while (*text++ == ',');
+        text--;
+    } else if (!strcmp(directive, ".zero")) {
+        if (!parse_value(assembler, &text, &value)) {
+            return false;
+        }
+        for (int i = 0; i < value; i++) {
+            emit_word(assembler, 0);
+        }
+    } else {
+        return fail(assembler, "unknown directive");
+    }
+    return *skip_spaces(text) == '\0' || fail(assembler, "unexpected text after the operands");
+}
+
+static bool assemble_line(assembler_t *assembler, const char *line) {
+    char name[CPU_LABEL_LENGTH];
+    const char *text = skip_spaces(line);
+    const char *after_name = parse_identifier(text, name);
+    // a label
+    if (after_name && *skip_spaces(after_name) == ':') {
+        if (assembler->pass == 1) {
+            for (int i = 0; i < assembler->number_of_labels; i++) {
+                if (!strcmp(assembler->labels[i].name, name)) {
+                    return fail(assembler, "label is already defined");
+                }
+            }
+            if (assembler->number_of_labels == CPU_LABELS) {
+                return fail(assembler, "too many labels");
+            }
+            strcpy(assembler->labels[assembler->number_of_labels].name, name);
+            assembler->labels[assembler->number_of_labels++].address = assembler->address;
+        }
+        text = skip_spaces(skip_spaces(after_name) + 1);
+        after_name = parse_identifier(text, name);
+    }
+    if (!after_name) {
+        return *text == '\0' || fail(assembler, "expected an instruction");
+    }
+    if (name[0] == '.') {
+        return assemble_directive(assembler, name, after_name);
+    }
+    int opcode = 0;
+    while (opcode < NUMBER_OF_CPU_OPCODES && strcmp(instruction_set[opcode].mnemonic, name)) {
+        opcode++;
+    }
+    if (opcode == NUMBER_OF_CPU_OPCODES) {
+        return fail(assembler, "unknown instruction");
+    }
+    text = after_name;
+    uint8_t registers[3] = {0, 0, 0};
+    int number_of_registers = 0;
+    uint16_t immediate = 0;
+    for (const char *operand = instruction_set[opcode].operands; *operand; operand++) {
+        if (operand != instruction_set[opcode].operands && !expect(assembler, &text, ',')) {
+            return false;
+        }
+        if (*operand == 'r') {
+            if (!parse_register(assembler, &text, registers + number_of_registers++)) {
+                return false;
+            }
+        } else if (*operand == 'i') {
+            if (!parse_value(assembler, &text, &immediate)) {
+                return false;
+            }
+        } else {
+            // offset(register); the offset may be omitted
+            if (*skip_spaces(text) != '(' && !parse_value(assembler, &text, &immediate)) {
+                return false;
+            }
+            if (!expect(assembler, &text, '(') || !parse_register(assembler, &text, registers + number_of_registers++)
+                || !expect(assembler, &text, ')')) {
+                return false;
+            }
+        }
+    }
+    if (*skip_spaces(text) != '\0') {
+        return fail(assembler, "unexpected text after the operands");
+    }
+    emit_byte(assembler, (uint8_t) opcode);
+    emit_byte(assembler, (uint8_t) (registers[0] << 4 | registers[1]));
+    if (number_of_registers == 3) {
+        emit_word(assembler, registers[2]);
+    } else {
+        emit_word(assembler, immediate);
+    }
+    return true;
+}
+
+/**
+ * Assembles a program into the CPU's memory, starting at address 0 unless a <code>.org</code> directive says
+ * otherwise, and resets the CPU so that execution starts at address 0. The rest of memory is cleared.
+ * @param cpu the CPU whose memory receives the program
+ * @param source the program's text, one instruction, label, or directive per line
+ * @param error receives a message naming the first offending line if the program cannot be assembled
+ * @param error_size the size of the error buffer
+ * @return 1 if the program was assembled; 0 otherwise
+ */
+bool cpu_assemble(cpu_t *cpu, const char *source, char *error, size_t error_size) {
+    assembler_t assembly = {.cpu = cpu, .error = error, .error_size = error_size};
+    assembler_t *assembler = &assembly;
+    bool assembled = true;
+    memset(cpu->memory, 0, CPU_MEMORY_SIZE);
+    for (assembler->pass = 1; assembled && assembler->pass <= 2; assembler->pass++) {
+        const char *line_start = source;
+        assembler->line_number = 1;
+        assembler->address = 0;
+        while (assembled && *line_start) {
+            char line[CPU_LINE_LENGTH];
+            size_t length = strcspn(line_start, "\n");
+            size_t comment = strcspn(line_start, ";\n");
+            if (comment >= CPU_LINE_LENGTH) {
+                assembled = fail(assembler, "line is too long");
+            } else {
+                memcpy(line, line_start, comment);
+                line[comment] = '\0';
+                assembled = assemble_line(assembler, line);
+            }
+            line_start += length + (line_start[length] == '\n');
+            assembler->line_number++;
+        }
+    }
+    cpu_reset(cpu);
+    return assembled;
+}
+
+/*
+ * INTERPRETER
+ */
+
+static void decode(cpu_t *cpu, uint16_t address) {
+    cpu_decoded_instruction_t *instruction = cpu->decoded + (address >> 1);
+    uint8_t opcode = cpu->memory[address];
+    uint8_t registers = cpu->memory[(uint16_t) (address + 1)];
+    instruction->destination = registers >> 4;
+    instruction->source1 = registers & 0xF;
+    instruction->immediate = cpu_read_word(cpu, (uint16_t) (address + 2));
+    instruction->source2 = instruction->immediate & 0xF;
+    instruction->opcode = opcode;
+    if (opcode >= NUMBER_OF_CPU_OPCODES || (opcode >= CPU_JUMP && (instruction->immediate & 0x1))) {
+        // every instruction is at an even address, so nothing at run time needs to check the program counter
+        instruction->opcode = ILLEGAL;
+    }
+}
+
+/**
+ * Executes instructions until the CPU halts, faults, or reaches the instruction limit. The CPU's state is preserved
+ * across calls, so a program can be run in slices.
+ * @param cpu the CPU
+ * @param instruction_limit the largest number of instructions to execute
+ * @return why execution stopped; on a fault, the program counter addresses the faulting instruction
+ */
+cpu_status_t cpu_run(cpu_t *cpu, uint64_t instruction_limit) {
+    static const void *handlers[NUMBER_OF_CPU_OPCODES + 2] = {
+            [CPU_HALT] = &&halt,
+            [CPU_LOAD_IMMEDIATE] = &&load_immediate,
+            [CPU_MOVE] = &&move,
+            [CPU_LOAD] = &&load,
+            [CPU_STORE] = &&store,
+            [CPU_ADD] = &&add,
+            [CPU_ADD_IMMEDIATE] = &&add_immediate,
+            [CPU_SUBTRACT] = &&subtract,
+            [CPU_MULTIPLY] = &&multiply,
+            [CPU_DIVIDE] = &&divide,
+            [CPU_REMAINDER] = &&remainder,
+            [CPU_COMPARE] = &&compare,
+            [CPU_COMPARE_IMMEDIATE] = &&compare_immediate,
+            [CPU_JUMP] = &&jump,
+            [CPU_BRANCH_EQUAL] = &&branch_equal,
+            [CPU_BRANCH_NOT_EQUAL] = &&branch_not_equal,
+            [CPU_BRANCH_LESS_THAN] = &&branch_less_than,
+            [CPU_BRANCH_AT_MOST] = &&branch_at_most,
+            [CPU_BRANCH_GREATER_THAN] = &&branch_greater_than,
+            [CPU_BRANCH_AT_LEAST] = &&branch_at_least,
+            [CPU_BRANCH_UNSIGNED_LESS_THAN] = &&branch_unsigned_less_than,
+            [CPU_BRANCH_UNSIGNED_AT_MOST] = &&branch_unsigned_at_most,
+            [CPU_BRANCH_UNSIGNED_GREATER_THAN] = &&branch_unsigned_greater_than,
+            [CPU_BRANCH_UNSIGNED_AT_LEAST] = &&branch_unsigned_at_least,
+            [UNDECODED] = &&undecoded,
+            [ILLEGAL] = &&illegal,
+    };
+    uint16_t *registers = cpu->registers;
+    uint16_t program_counter = cpu->program_counter;
+    alu_flags_t flags = cpu->flags;
+    uint64_t remaining = instruction_limit;
+    const cpu_decoded_instruction_t *instruction;
+    cpu_status_t status;
+    alu_result_t quotient;
+    uint16_t address;
+#define D           registers[instruction->destination]
+#define S1          registers[instruction->source1]
+#define S2          registers[instruction->source2]
+#define IMMEDIATE   instruction->immediate
+#define DISPATCH()                                                          \
+    do {                                                                    \
+        if (!remaining) {                                                   \
+            status = CPU_LIMIT_REACHED;                                     \
+            goto stop;                                                      \
+        }                                                                   \
+        remaining--;                                                        \
+        instruction = cpu->decoded + (program_counter >> 1);                \
+        goto *handlers[instruction->opcode];                                \
+    } while (0)
+#define NEXT()      do { program_counter += CPU_INSTRUCTION_SIZE; DISPATCH(); } while (0)
+#define BRANCH(condition)                                                   \
+    do {                                                                    \
+        program_counter = (condition) ? IMMEDIATE                           \
+                                      : (uint16_t) (program_counter + CPU_INSTRUCTION_SIZE); \
+        DISPATCH();                                                         \
+    } while (0)
+    DISPATCH();
+    undecoded:
+    decode(cpu, program_counter);
+    goto *handlers[instruction->opcode];
+    load_immediate:
+    D = IMMEDIATE;
+    NEXT();
+    move:
+    D = S1;
+    NEXT();
+    load:
+    D = cpu_read_word(cpu, (uint16_t) (S1 + IMMEDIATE));
+    NEXT();
+    store:
+    address = (uint16_t) (S1 + IMMEDIATE);
+    cpu->memory[address] = (uint8_t) D;
+    cpu->memory[(uint16_t) (address + 1)] = (uint8_t) (D >> 8);
+    // the store may overwrite any of the instructions that overlap its two bytes
+    cpu->decoded[((address >> 1) + 0x7FFF) & 0x7FFF].opcode = UNDECODED;
+    cpu->decoded[address >> 1].opcode = UNDECODED;
+    cpu->decoded[((address + 1) >> 1) & 0x7FFF].opcode = UNDECODED;
+    NEXT();
+    add:
+    D = traced_add(S1, S2).result;
+    NEXT();
+    add_immediate:
+    D = traced_add(S1, IMMEDIATE).result;
+    NEXT();
+    subtract:
+    D = traced_subtract(S1, S2).result;
+    NEXT();
+    multiply:
+    D = traced_unsigned_multiply(S1, S2).result;
+    NEXT();
+    divide:
+    quotient = traced_unsigned_divide(S1, S2);
+    if (quotient.divide_by_zero) {
+        goto divide_by_zero;
+    }
+    D = quotient.result;
+    NEXT();
+    remainder:
+    quotient = traced_unsigned_divide(S1, S2);
+    if (quotient.divide_by_zero) {
+        goto divide_by_zero;
+    }
+    D = quotient.supplemental_result;
+    NEXT();
+    compare:
+    flags = traced_compare(D, S1);
+    NEXT();
+    compare_immediate:
+    flags = traced_compare(D, IMMEDIATE);
+    NEXT();
+    jump:
+    BRANCH(true);
+    branch_equal:
+    BRANCH(flags_equal(flags));
+    branch_not_equal:
+    BRANCH(flags_not_equal(flags));
+    branch_less_than:
+    BRANCH(flags_less_than(flags));
+    branch_at_most:
+    BRANCH(flags_at_most(flags));
+    branch_greater_than:
+    BRANCH(flags_greater_than(flags));
+    branch_at_least:
+    BRANCH(flags_at_least(flags));
+    branch_unsigned_less_than:
+    BRANCH(flags_unsigned_less_than(flags));
+    branch_unsigned_at_most:
+    BRANCH(flags_unsigned_at_most(flags));
+    branch_unsigned_greater_than:
+    BRANCH(flags_unsigned_greater_than(flags));
+    branch_unsigned_at_least:
+    BRANCH(flags_unsigned_at_least(flags));
+    halt:
+    status = CPU_HALTED;
+    goto stop;
+    divide_by_zero:
+    status = CPU_DIVIDE_BY_ZERO;
+    remaining++;
+    goto stop;
+    illegal:
+    status = CPU_ILLEGAL_INSTRUCTION;
+    remaining++;
+    stop:
+    cpu->program_counter = program_counter;
+    cpu->flags = flags;
+    cpu->instructions_retired += instruction_limit - remaining;
+    return status;
+#undef D
+#undef S1
+#undef S2
+#undef IMMEDIATE
+#undef DISPATCH
+#undef NEXT
+#undef BRANCH
+}
+
+/*
+ * WORKLOADS
+ */
+
+#define REDUCE_LENGTH       1024
+#define SORT_LENGTH         256
+#define SORT_BASE           0x8000
+#define FIBONACCI_STEPS     20000
+
+static bool verify_reduce(const cpu_t *cpu) {
+    uint16_t sum = 0;
+    for (uint16_t i = 0; i < REDUCE_LENGTH; i++) {
+        sum = (uint16_t) (sum + 3 * i);
+    }
+    return cpu->registers[2] == sum;
+}
+
+static bool verify_sort(const cpu_t *cpu) {
+    // regenerate the pseudorandom values, and check that the sorted array holds the same multiset in order
+    uint16_t expected[SORT_LENGTH];
+    uint16_t seed = 12345;
+    for (int i = 0; i < SORT_LENGTH; i++) {
+        seed = (uint16_t) (seed * 25173u + 13849u);
+        int j = i;
+        while (j > 0 && expected[j - 1] > seed) {
+            expected[j] = expected[j - 1];
+            j--;
+        }
+        expected[j] = seed;
+    }
+    for (int i = 0; i < SORT_LENGTH; i++) {
+        if (cpu_read_word(cpu, (uint16_t) (SORT_BASE + 2 * i)) != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool verify_fibonacci(const cpu_t *cpu) {
+    uint16_t previous = 0, current = 1;
+    for (int i = 0; i < FIBONACCI_STEPS; i++) {
+        uint16_t next = (uint16_t) (previous + current);
+        previous = current;
+        current = next;
+    }
+    return cpu->registers[1] == previous;
+}
+
+const cpu_workload_t cpu_workloads[] = {
+        {"reduce", "store 3i into a 1024-word array, then sum the array",
+         "        li   r1, 0x8000      ; base\n"
+         "        li   r2, 0           ; i\n"
+         "        li   r3, 1024        ; length\n"
+         "        li   r4, 3\n"
+         "fill:   mul  r5, r2, r4\n"
+         "        add  r6, r2, r2\n"
+         "        add  r6, r6, r1\n"
+         "        st   r5, 0(r6)\n"
+         "        addi r2, r2, 1\n"
+         "        cmp  r2, r3\n"
+         "        blo  fill\n"
+         "        li   r2, 0           ; sum\n"
+         "        mov  r6, r1\n"
+         "        add  r7, r3, r3\n"
+         "        add  r7, r7, r1      ; end\n"
+         "sum:    ld   r5, (r6)\n"
+         "        add  r2, r2, r5\n"
+         "        addi r6, r6, 2\n"
+         "        cmp  r6, r7\n"
+         "        bne  sum\n"
+         "        halt\n",
+         verify_reduce},
+        {"sort", "generate 256 pseudorandom words, then insertion-sort them",
+         "        li   r1, 0x8000      ; base\n"
+         "        li   r2, 256         ; length\n"
+         "        li   r3, 12345       ; seed\n"
+         "        li   r4, 0           ; i\n"
+         "        li   r6, 25173\n"
+         "fill:   mul  r3, r3, r6\n"
+         "        addi r3, r3, 13849\n"
+         "        add  r5, r4, r4\n"
+         "        add  r5, r5, r1\n"
+         "        st   r3, (r5)\n"
+         "        addi r4, r4, 1\n"
+         "        cmp  r4, r2\n"
+         "        blo  fill\n"
+         "        li   r4, 1           ; i\n"
+         "outer:  cmp  r4, r2\n"
+         "        bhs  done\n"
+         "        add  r5, r4, r4\n"
+         "        add  r5, r5, r1      ; &a[j], starting with j = i\n"
+         "        ld   r7, (r5)        ; key\n"
+         "inner:  cmp  r5, r1\n"
+         "        bls  place\n"
+         "        ld   r8, -2(r5)      ; a[j - 1]\n"
+         "        cmp  r8, r7\n"
+         "        bls  place\n"
+         "        st   r8, (r5)\n"
+         "        addi r5, r5, -2\n"
+         "        jmp  inner\n"
+         "place:  st   r7, (r5)\n"
+         "        addi r4, r4, 1\n"
+         "        jmp  outer\n"
+         "done:   halt\n",
+         verify_sort},
+        {"fibonacci", "iterate the Fibonacci recurrence 20000 times, modulo 2^16",
+         "        li   r1, 0\n"
+         "        li   r2, 1\n"
+         "        li   r3, 20000\n"
+         "loop:   add  r4, r1, r2\n"
+         "        mov  r1, r2\n"
+         "        mov  r2, r4\n"
+         "        addi r3, r3, -1\n"
+         "        cmpi r3, 0\n"
+         "        bne  loop\n"
+         "        halt\n",
+         verify_fibonacci},
+};
+
+const int number_of_cpu_workloads = sizeof(cpu_workloads) / sizeof(cpu_workloads[0]);
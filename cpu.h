@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ *
+ * @file cpu.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for a 16-bit CPU whose
+ *      arithmetic is performed by the ALU, and for its assembler.
+ *
+ * The CPU has sixteen 16-bit registers, r0 through r15, and a flat 64 KiB
+ * byte-addressed memory that holds both code and data. Words are
+ * little-endian. Every instruction is four bytes: the opcode, then the
+ * destination register in the high nibble and the first source register in
+ * the low nibble, then either a 16-bit immediate value or (in the low nibble
+ * of the third byte) the second source register.
+ *
+ *      halt                    stop
+ *      li   rd, imm            rd = imm
+ *      mov  rd, rs             rd = rs
+ *      ld   rd, imm(rs)        rd = memory[rs + imm]
+ *      st   rd, imm(rs)        memory[rs + imm] = rd
+ *      add  rd, rs, rt         rd = rs + rt                (likewise sub, mul, div, rem)
+ *      addi rd, rs, imm        rd = rs + imm
+ *      cmp  rd, rs             set the flags from rd - rs
+ *      cmpi rd, imm            set the flags from rd - imm
+ *      jmp  label              branch unconditionally
+ *      beq  label              branch if equal             (likewise bne, and the signed blt, ble, bgt, bge
+ *                                                           and unsigned blo, bls, bhi, bhs)
+ *
+ * Only cmp and cmpi change the flags, which are those produced by compare().
+ * The assembler also accepts labels ("name:"), comments (from ';' to the end
+ * of the line), and the directives .org address, .word value[, value...],
+ * and .zero count (that many zero words).
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef CPU_H
+#define CPU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "alu_extensions.h"
+
+#define CPU_REGISTERS           16
+#define CPU_MEMORY_SIZE         65536
+#define CPU_INSTRUCTION_SIZE    4
+
+typedef enum {
+    CPU_HALT = 0,
+    CPU_LOAD_IMMEDIATE,
+    CPU_MOVE,
+    CPU_LOAD,
+    CPU_STORE,
+    CPU_ADD,
+    CPU_ADD_IMMEDIATE,
+    CPU_SUBTRACT,
+    CPU_MULTIPLY,
+    CPU_DIVIDE,
+    CPU_REMAINDER,
+    CPU_COMPARE,
+    CPU_COMPARE_IMMEDIATE,
+    CPU_JUMP,
+    CPU_BRANCH_EQUAL,
+    CPU_BRANCH_NOT_EQUAL,
+    CPU_BRANCH_LESS_THAN,
+    CPU_BRANCH_AT_MOST,
+    CPU_BRANCH_GREATER_THAN,
+    CPU_BRANCH_AT_LEAST,
+    CPU_BRANCH_UNSIGNED_LESS_THAN,
+    CPU_BRANCH_UNSIGNED_AT_MOST,
+    CPU_BRANCH_UNSIGNED_GREATER_THAN,
+    CPU_BRANCH_UNSIGNED_AT_LEAST,
+    NUMBER_OF_CPU_OPCODES
+} cpu_opcode_t;
+
+typedef enum {
+    CPU_HALTED,
+    CPU_LIMIT_REACHED,              // executed the requested number of instructions without halting
+    CPU_ILLEGAL_INSTRUCTION,        // an unknown opcode, or a branch to an odd address
+    CPU_DIVIDE_BY_ZERO
+} cpu_status_t;
+
+/* an instruction after decoding, cached for each even address */
+typedef struct {
+    uint8_t opcode;
+    uint8_t destination;
+    uint8_t source1;
+    uint8_t source2;
+    uint16_t immediate;
+} cpu_decoded_instruction_t;
+
+typedef struct {
+    uint16_t registers[CPU_REGISTERS];
+    uint16_t program_counter;
+    alu_flags_t flags;
+    uint64_t instructions_retired;
+    uint8_t memory[CPU_MEMORY_SIZE];
+    cpu_decoded_instruction_t decoded[CPU_MEMORY_SIZE / 2];
+} cpu_t;
+
+typedef struct {
+    const char *name;
+    const char *description;
+    const char *source;
+    bool (*verify)(const cpu_t *cpu);   // checks the registers and memory after the workload halts
+} cpu_workload_t;
+
+extern const cpu_workload_t cpu_workloads[];
+extern const int number_of_cpu_workloads;
+
+void cpu_reset(cpu_t *cpu) __attribute__ ((no_instrument_function));
+bool cpu_assemble(cpu_t *cpu, const char *source, char *error, size_t error_size) __attribute__ ((no_instrument_function));
+cpu_status_t cpu_run(cpu_t *cpu, uint64_t instruction_limit) __attribute__ ((no_instrument_function));
+uint16_t cpu_read_word(const cpu_t *cpu, uint16_t address) __attribute__ ((no_instrument_function));
+const char *cpu_status_name(cpu_status_t status) __attribute__ ((no_instrument_function));
+
+#endif //CPU_H
@@ -0,0 +1,535 @@
+/**************************************************************************//**
+ *
+ * @file expression.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief A compiler from infix expressions to register bytecode, and a
+ *      threaded-dispatch interpreter that evaluates the bytecode with the ALU.
+ *
+ * Compilation happens once per distinct source text: the compiled expressions
+ * are cached, so evaluating a formula repeatedly costs one dispatch per
+ * operator and no parsing. Each handler in the interpreter ends with its own
+ * indirect jump to the next instruction's handler (a GNU C extension that gcc
+ * and clang both support), which lets the branch predictor learn the sequence
+ * of operations in an expression.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <ctype.h>
+#include "alu_extensions.h"
+#include "trace.h"
+#include "expression.h"
+
+typedef enum {
+    TOKEN_END,
+    TOKEN_NUMBER,
+    TOKEN_VARIABLE,
+    TOKEN_OPERATOR,
+    TOKEN_LEFT_PARENTHESIS,
+    TOKEN_RIGHT_PARENTHESIS
+} token_kind_t;
+
+typedef struct {
+    token_kind_t kind;
+    uint16_t value;             // the number's value, the variable's letter index, or the operator's opcode
+} token_t;
+
+typedef struct {
+    token_t tokens[EXPRESSION_SOURCE_LENGTH];
+    int position;
+    int variable_registers[EXPRESSION_VARIABLES];
+    expression_t *expression;
+} parser_t;
+
+static bool normalize(const char *source, char normalized[EXPRESSION_SOURCE_LENGTH]) __attribute__ ((no_instrument_function));
+static bool tokenize(parser_t *parser) __attribute__ ((no_instrument_function));
+static int parse_binary(parser_t *parser, int minimum_precedence) __attribute__ ((no_instrument_function));
+static int parse_unary(parser_t *parser) __attribute__ ((no_instrument_function));
+static int allocate_register(expression_t *expression) __attribute__ ((no_instrument_function));
+static int emit(expression_t *expression, expression_opcode_t opcode, int source1, int source2) __attribute__ ((no_instrument_function));
+static void execute(const expression_instruction_t *code, uint16_t *registers) __attribute__ ((no_instrument_function));
+
+/* binary operators' precedence; zero marks an operator that is only unary */
+static const int precedence[NUMBER_OF_EXPRESSION_OPCODES] = {
+        [EXPRESSION_MULTIPLY] = 6, [EXPRESSION_DIVIDE] = 6, [EXPRESSION_REMAINDER] = 6,
+        [EXPRESSION_ADD] = 5, [EXPRESSION_SUBTRACT] = 5,
+        [EXPRESSION_LESS_THAN] = 4, [EXPRESSION_AT_MOST] = 4, [EXPRESSION_GREATER_THAN] = 4, [EXPRESSION_AT_LEAST] = 4,
+        [EXPRESSION_EQUAL] = 3, [EXPRESSION_NOT_EQUAL] = 3,
+        [EXPRESSION_LOGICAL_AND] = 2,
+        [EXPRESSION_LOGICAL_OR] = 1,
+};
+
+static const char *mnemonics[NUMBER_OF_EXPRESSION_OPCODES] = {
+        [EXPRESSION_HALT] = "halt",
+        [EXPRESSION_ADD] = "add", [EXPRESSION_SUBTRACT] = "sub", [EXPRESSION_MULTIPLY] = "mul",
+        [EXPRESSION_DIVIDE] = "div", [EXPRESSION_REMAINDER] = "rem", [EXPRESSION_NEGATE] = "neg",
+        [EXPRESSION_EQUAL] = "eq", [EXPRESSION_NOT_EQUAL] = "ne", [EXPRESSION_LESS_THAN] = "lt",
+        [EXPRESSION_AT_MOST] = "le", [EXPRESSION_GREATER_THAN] = "gt", [EXPRESSION_AT_LEAST] = "ge",
+        [EXPRESSION_LOGICAL_AND] = "and", [EXPRESSION_LOGICAL_OR] = "or", [EXPRESSION_LOGICAL_NOT] = "not",
+};
+
+static expression_t cache[EXPRESSION_CACHE_SIZE];
+static bool cache_occupied[EXPRESSION_CACHE_SIZE];
+
+/*
+ * COMPILER
+ */
+
+static bool normalize(const char *source, char normalized[EXPRESSION_SOURCE_LENGTH]) {
+    int length = 0;
+    for (; *source; source++) {
+        if (!isspace((unsigned char) *source)) {
+            if (length == EXPRESSION_SOURCE_LENGTH - 1) {
+                normalized[length] = '\0';
+                return false;
+            }
+            normalized[length++] = (char) tolower((unsigned char) *source);
+        }
+    }
+    normalized[length] = '\0';
+    return true;
+}
+
+static bool tokenize(parser_t *parser) {
+    const char *next = parser->expression->source;
+    int count = 0;
+    do {
+        token_t *token = parser->tokens + count++;
+        char c = *next;
+        if (c == '\0') {
+            token->kind = TOKEN_END;
+        } else if (isdigit((unsigned char) c)) {
+            char *end;
+            errno = 0;
+            unsigned long value = strtoul(next, &end, (strncmp(next, "0x", 2) ? 10 : 16));
+            if (errno == ERANGE || value > UINT16_MAX) {
+                parser->expression->error = "number does not fit in 16 bits";
+                return false;
+            }
+            token->kind = TOKEN_NUMBER;
+            token->value = (uint16_t) value;
+            next = end;
+        } else if (isalpha((unsigned char) c)) {
+            if (isalnum((unsigned char) next[1]) || next[1] == '_') {
+                parser->expression->error = "variables are single letters, a through z";
+                return false;
+            }
+            token->kind = TOKEN_VARIABLE;
+            token->value = (uint16_t) (c - 'a');
+            next++;
+        } else if (c == '(' || c == ')') {
+            token->kind = c == '(' ? TOKEN_LEFT_PARENTHESIS : TOKEN_RIGHT_PARENTHESIS;
+            next++;
+        } else {
+            // like the driver, accept "&", "|", and "=" as well as "&&", "||", and "=="
+            static const struct {
+                const char *text;
+                expression_opcode_t opcode;
+            } operators[] = {
+                    {"<=", EXPRESSION_AT_MOST}, {">=", EXPRESSION_AT_LEAST}, {"==", EXPRESSION_EQUAL},
+                    {"!=", EXPRESSION_NOT_EQUAL}, {"&&", EXPRESSION_LOGICAL_AND}, {"||", EXPRESSION_LOGICAL_OR},
+                    {"+", EXPRESSION_ADD}, {"-", EXPRESSION_SUBTRACT}, {"*", EXPRESSION_MULTIPLY},
+                    {"/", EXPRESSION_DIVIDE}, {"%", EXPRESSION_REMAINDER}, {"<", EXPRESSION_LESS_THAN},
+                    {">", EXPRESSION_GREATER_THAN}, {"!", EXPRESSION_LOGICAL_NOT}, {"&", EXPRESSION_LOGICAL_AND},
+                    {"|", EXPRESSION_LOGICAL_OR}, {"=", EXPRESSION_EQUAL},
+            };
+            int number_of_operators = sizeof(operators) / sizeof(operators[0]);
+            int i = 0;
+            while (i < number_of_operators && strncmp(next, operators[i].text, strlen(operators[i].text))) {
+                i++;
+            }
+            if (i == number_of_operators) {
+                parser->expression->error = "unrecognized character";
+                return false;
+            }
+            token->kind = TOKEN_OPERATOR;
+            token->value = (uint16_t) operators[i].opcode;
+            next += strlen(operators[i].text);
+        }
+    } while (parser->tokens[count - 1].kind != TOKEN_END);
+    return true;
+}
+
+static int allocate_register(expression_t *expression) {
+    if (expression->number_of_registers == EXPRESSION_REGISTERS) {
+        expression->error = "expression needs too many registers";
+        return -1;
+    }
+    expression->registers[expression->number_of_registers] = 0;
+    return expression->number_of_registers++;
+}
+
+static int emit(expression_t *expression, expression_opcode_t opcode, int source1, int source2) {
+    // leave room for the final EXPRESSION_HALT
+    if (expression->number_of_instructions == EXPRESSION_INSTRUCTIONS - 1) {
+        expression->error = "expression has too many operators";
+        return -1;
+    }
+    int destination = allocate_register(expression);
+    if (destination < 0) {
+        return -1;
+    }
+    expression_instruction_t *instruction = expression->code + expression->number_of_instructions++;
+    instruction->opcode = (uint8_t) opcode;
+    instruction->destination = (uint8_t) destination;
+    instruction->source1 = (uint8_t) source1;
+    instruction->source2 = (uint8_t) source2;
+    return destination;
+}
+
+static int parse_unary(parser_t *parser) {
+    token_t token = parser->tokens[parser->position++];
+    int operand;
+    switch (token.kind) {
+        case TOKEN_NUMBER:
+            operand = allocate_register(parser->expression);
+            if (operand >= 0) {
+                parser->expression->registers[operand] = token.value;
+            }
+            return operand;
+        case TOKEN_VARIABLE:
+            return parser->variable_registers[token.value];
+        case TOKEN_LEFT_PARENTHESIS:
+            operand = parse_binary(parser, 1);
+            if (operand >= 0 && parser->tokens[parser->position++].kind != TOKEN_RIGHT_PARENTHESIS) {
+                parser->expression->error = "missing closing parenthesis";
+                return -1;
+            }
+            return operand;
+        case TOKEN_OPERATOR:
+            if (token.value == EXPRESSION_SUBTRACT || token.value == EXPRESSION_LOGICAL_NOT) {
+                operand = parse_unary(parser);
+                return operand < 0 ? -1 : emit(parser->expression, token.value == EXPRESSION_SUBTRACT
+                                                                   ? EXPRESSION_NEGATE : EXPRESSION_LOGICAL_NOT,
+                                               operand, 0);
+            }
+            parser->expression->error = "operator is missing its left operand";
+            return -1;
+        case TOKEN_END:
+            parser->expression->error = "expression ends where an operand was expected";
+            return -1;
+        default:
+            parser->expression->error = "unexpected closing parenthesis";
+            return -1;
+    }
+}
+
+/* precedence climbing: consumes operators whose precedence is at least minimum_precedence */
+static int parse_binary(parser_t *parser, int minimum_precedence) {
+    int left = parse_unary(parser);
+    while (left >= 0 && parser->tokens[parser->position].kind == TOKEN_OPERATOR
+           && precedence[parser->tokens[parser->position].value] >= minimum_precedence) {
+        expression_opcode_t opcode = (expression_opcode_t) parser->tokens[parser->position++].value;
+        // all of the binary operators are left-associative
+        int right = parse_binary(parser, precedence[opcode] + 1);
+        left = right < 0 ? -1 : emit(parser->expression, opcode, left, right);
+    }
+    return left;
+}
+
+/**
+ * Compiles an infix expression into register bytecode.
+ * @param source the expression's text
+ * @param expression receives the compiled expression; if compilation fails, its <code>error</code> field explains why
+ * @return 1 if the expression compiled; 0 otherwise
+ */
+bool expression_compile(const char *source, expression_t *expression) {
+    parser_t parse = {.expression = expression};
+    parser_t *parser = &parse;
+    expression->number_of_instructions = 0;
+    expression->number_of_variables = 0;
+    expression->number_of_registers = 0;
+    expression->result_register = 0;
+    expression->error = NULL;
+    if (!normalize(source, expression->source)) {
+        expression->error = "expression is too long";
+    }
+    if (!expression->error && tokenize(parser)) {
+        // the variables take the lowest registers, in alphabetical order
+        bool used[EXPRESSION_VARIABLES] = {false};
+        for (int i = 0; parser->tokens[i].kind != TOKEN_END; i++) {
+            if (parser->tokens[i].kind == TOKEN_VARIABLE) {
+                used[parser->tokens[i].value] = true;
+            }
+        }
+        for (int letter = 0; letter < EXPRESSION_VARIABLES; letter++) {
+            if (used[letter]) {
+                expression->variable_names[expression->number_of_variables] = (char) ('a' + letter);
+                parser->variable_registers[letter] = allocate_register(expression);
+                expression->number_of_variables++;
+            }
+        }
+        expression->result_register = parse_binary(parser, 1);
+        if (expression->result_register >= 0 && parser->tokens[parser->position].kind != TOKEN_END) {
+            expression->error = parser->tokens[parser->position].kind == TOKEN_RIGHT_PARENTHESIS
+                                ? "unexpected closing parenthesis" : "operand is missing an operator";
+        }
+    }
+    expression->code[expression->number_of_instructions].opcode = EXPRESSION_HALT;
+    if (expression->error) {
+        expression->number_of_instructions = 0;
+        expression->code[0].opcode = EXPRESSION_HALT;
+        expression->result_register = 0;
+    }
+    return !expression->error;
+}
+
+/**
+ * Looks up a compiled expression by its source text, compiling it only if it is not already in the cache. Two
+ * sources that differ only in whitespace or letter case share a compiled expression.
+ * @param source the expression's text
+ * @param was_cached if not NULL, receives 1 if the compiled expression was found in the cache; 0 otherwise
+ * @return the compiled expression, which remains valid until another source text displaces it from the cache;
+ *      if compilation failed, its <code>error</code> field explains why
+ */
+const expression_t *expression_compile_cached(const char *source, bool *was_cached) {
+    char normalized[EXPRESSION_SOURCE_LENGTH];
+    normalize(source, normalized);
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const char *c = normalized; *c; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619u;
+    }
+    int slot = (int) (hash % EXPRESSION_CACHE_SIZE);
+    bool hit = cache_occupied[slot] && !strcmp(cache[slot].source, normalized);
+    if (!hit) {
+        cache_occupied[slot] = expression_compile(source, cache + slot);
+    }
+    if (was_cached) {
+        *was_cached = hit;
+    }
+    return cache + slot;
+}
+
+/**
+ * Prints a compiled expression's registers and bytecode.
+ * @param expression the compiled expression
+ */
+void expression_disassemble(const expression_t *expression) {
+    // the registers that no instruction writes hold the variables and the literals
+    bool written[EXPRESSION_REGISTERS] = {false};
+    for (int i = 0; i < expression->number_of_instructions; i++) {
+        written[expression->code[i].destination] = true;
+    }
+    printf("\tregisters:");
+    for (int i = 0; i < expression->number_of_registers; i++) {
+        if (i < expression->number_of_variables) {
+            printf(" r%d=%c", i, expression->variable_names[i]);
+        } else if (!written[i]) {
+            printf(" r%d=0x%04X", i, expression->registers[i]);
+        }
+    }
+    printf("\n");
+    for (int i = 0; i <= expression->number_of_instructions; i++) {
+        const expression_instruction_t *instruction = expression->code + i;
+        if (instruction->opcode == EXPRESSION_HALT) {
+            printf("\t%3d: %-4s r%d\n", i, mnemonics[instruction->opcode], expression->result_register);
+        } else if (instruction->opcode == EXPRESSION_NEGATE || instruction->opcode == EXPRESSION_LOGICAL_NOT) {
+            printf("\t%3d: %-4s r%d, r%d\n", i, mnemonics[instruction->opcode], instruction->destination,
+                   instruction->source1);
+        } else {
+            printf("\t%3d: %-4s r%d, r%d, r%d\n", i, mnemonics[instruction->opcode], instruction->destination,
+                   instruction->source1, instruction->source2);
+        }
+    }
+}
+
+/*
+ * INTERPRETER
+ */
+
+static void execute(const expression_instruction_t *code, uint16_t *registers) {
+    static const void *handlers[NUMBER_OF_EXPRESSION_OPCODES] = {
+            [EXPRESSION_HALT] = &&halt,
+            [EXPRESSION_ADD] = &&add,
+            [EXPRESSION_SUBTRACT] = &&subtract,
+            [EXPRESSION_MULTIPLY] = &&multiply,
+            [EXPRESSION_DIVIDE] = &&divide,
+            [EXPRESSION_REMAINDER] = &&remainder,
+            [EXPRESSION_NEGATE] = &&negate,
+            [EXPRESSION_EQUAL] = &&equal,
+            [EXPRESSION_NOT_EQUAL] = &&not_equal,
+            [EXPRESSION_LESS_THAN] = &&less_than,
+            [EXPRESSION_AT_MOST] = &&at_most,
+            [EXPRESSION_GREATER_THAN] = &&greater_than,
+            [EXPRESSION_AT_LEAST] = &&at_least,
+            [EXPRESSION_LOGICAL_AND] = &&logical_and,
+            [EXPRESSION_LOGICAL_OR] = &&logical_or,
+            [EXPRESSION_LOGICAL_NOT] = &&logical_not,
+    };
+    const expression_instruction_t *instruction = code;
+#define DESTINATION registers[instruction->destination]
+#define SOURCE1     registers[instruction->source1]
+#define SOURCE2     registers[instruction->source2]
+#define DISPATCH()  goto *handlers[instruction->opcode]
+#define NEXT()      do { instruction++; DISPATCH(); } while (0)
+    DISPATCH();
+    add:
+    DESTINATION = traced_add(SOURCE1, SOURCE2).result;
+    NEXT();
+    subtract:
+    DESTINATION = traced_subtract(SOURCE1, SOURCE2).result;
+    NEXT();
+    multiply:
+    DESTINATION = traced_unsigned_multiply(SOURCE1, SOURCE2).result;
+    NEXT();
+    divide:
+    DESTINATION = traced_unsigned_divide(SOURCE1, SOURCE2).result;
+    NEXT();
+    remainder:
+    DESTINATION = traced_unsigned_divide(SOURCE1, SOURCE2).supplemental_result;
+    NEXT();
+    negate:
+    DESTINATION = traced_subtract(0, SOURCE1).result;
+    NEXT();
+    equal:
+    DESTINATION = flags_equal(traced_compare(SOURCE1, SOURCE2));
+    NEXT();
+    not_equal:
+    DESTINATION = flags_not_equal(traced_compare(SOURCE1, SOURCE2));
+    NEXT();
+    less_than:
+    DESTINATION = flags_less_than(traced_compare(SOURCE1, SOURCE2));
+    NEXT();
+    at_most:
+    DESTINATION = flags_at_most(traced_compare(SOURCE1, SOURCE2));
+    NEXT();
+    greater_than:
+    DESTINATION = flags_greater_than(traced_compare(SOURCE1, SOURCE2));
+    NEXT();
+    at_least:
+    DESTINATION = flags_at_least(traced_compare(SOURCE1, SOURCE2));
+    NEXT();
+    logical_and:
+    DESTINATION = logical_and(SOURCE1, SOURCE2);
+    NEXT();
+    logical_or:
+    DESTINATION = logical_or(SOURCE1, SOURCE2);
+    NEXT();
+    logical_not:
+    DESTINATION = logical_not(SOURCE1);
+    NEXT();
+    halt:
+    return;
+#undef DESTINATION
+#undef SOURCE1
+#undef SOURCE2
+#undef DISPATCH
+#undef NEXT
+}
+
+/**
+ * Evaluates a compiled expression with the ALU.
+ * @param expression the compiled expression
+ * @param binding the values of the expression's variables, in the order given by its <code>variable_names</code>
+ * @return the expression's value; a division by zero contributes whatever <code>unsigned_divide</code> reports
+ */
+uint16_t expression_evaluate(const expression_t *expression, const uint16_t *binding) {
+    uint16_t registers[EXPRESSION_REGISTERS];
+    memcpy(registers, expression->registers, expression->number_of_registers * sizeof(uint16_t));
+    memcpy(registers, binding, expression->number_of_variables * sizeof(uint16_t));
+    execute(expression->code, registers);
+    return registers[expression->result_register];
+}
+
+/**
+ * Evaluates a compiled expression once for each of several bindings of its variables. The registers are set up
+ * once, so each evaluation only copies in its variables before running the bytecode.
+ * @param expression the compiled expression
+ * @param bindings <code>count</code> consecutive bindings, each holding the values of the expression's variables in
+ *      the order given by its <code>variable_names</code>
+ * @param results the array that receives the <code>count</code> values of the expression
+ * @param count the number of bindings
+ */
+void expression_evaluate_batch(const expression_t *expression, const uint16_t *bindings, uint16_t *results,
+                               size_t count) {
+    uint16_t registers[EXPRESSION_REGISTERS];
+    size_t binding_size = expression->number_of_variables * sizeof(uint16_t);
+    memcpy(registers, expression->registers, expression->number_of_registers * sizeof(uint16_t));
+    for (size_t i = 0; i < count; i++) {
+        memcpy(registers, bindings, binding_size);
+        execute(expression->code, registers);
+        results[i] = registers[expression->result_register];
+        bindings += expression->number_of_variables;
+    }
+}
+
+/**
+ * Evaluates a compiled expression with C's operators instead of the ALU, to provide the expected value against which
+ * <code>expression_evaluate</code> can be checked.
+ * @param expression the compiled expression
+ * @param binding the values of the expression's variables, in the order given by its <code>variable_names</code>
+ * @param value receives the expression's value
+ * @return 0 if the expression divides by zero; 1 otherwise
+ */
+bool expression_evaluate_reference(const expression_t *expression, const uint16_t *binding, uint16_t *value) {
+    uint16_t registers[EXPRESSION_REGISTERS];
+    memcpy(registers, expression->registers, expression->number_of_registers * sizeof(uint16_t));
+    memcpy(registers, binding, expression->number_of_variables * sizeof(uint16_t));
+    for (const expression_instruction_t *instruction = expression->code;
+         instruction->opcode != EXPRESSION_HALT; instruction++) {
+        uint16_t source1 = registers[instruction->source1];
+        uint16_t source2 = registers[instruction->source2];
+        uint16_t result;
+        switch (instruction->opcode) {
+            case EXPRESSION_ADD:
+                result = (uint16_t) (source1 + source2);
+                break;
+            case EXPRESSION_SUBTRACT:
+                result = (uint16_t) (source1 - source2);
+                break;
+            case EXPRESSION_MULTIPLY:
+                result = (uint16_t) (source1 * source2);
+                break;
+            case EXPRESSION_DIVIDE:
+            case EXPRESSION_REMAINDER:
+                if (source2 == 0) {
+                    return false;
+                }
+                result = (uint16_t) (instruction->opcode == EXPRESSION_DIVIDE ? source1 / source2 : source1 % source2);
+                break;
+            case EXPRESSION_NEGATE:
+                result = (uint16_t) -source1;
+                break;
+            case EXPRESSION_EQUAL:
+                result = source1 == source2;
+                break;
+            case EXPRESSION_NOT_EQUAL:
+                result = source1 != source2;
+                break;
+            case EXPRESSION_LESS_THAN:
+                result = (int16_t) source1 < (int16_t) source2;
+                break;
+            case EXPRESSION_AT_MOST:
+                result = (int16_t) source1 <= (int16_t) source2;
+                break;
+            case EXPRESSION_GREATER_THAN:
+                result = (int16_t) source1 > (int16_t) source2;
+                break;
+            case EXPRESSION_AT_LEAST:
+                result = (int16_t) source1 >= (int16_t) source2;
+                break;
+            case EXPRESSION_LOGICAL_AND:
+                result = source1 && source2;
+                break;
+            case EXPRESSION_LOGICAL_OR:
+                result = source1 || source2;
+                break;
+            default:
+                result = !source1;
+        }
+        registers[instruction->destination] = result;
+    }
+    *value = registers[expression->result_register];
+    return true;
+}
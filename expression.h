@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ *
+ * @file expression.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for compiling infix
+ *      expressions into register bytecode and evaluating them with the ALU.
+ *
+ * An expression combines 16-bit literals (decimal or 0x-prefixed hexadecimal),
+ * the single-letter variables a through z, and parentheses with the operators
+ * that the driver understands, from highest to lowest precedence:
+ *
+ *      -  !               (unary)
+ *      *  /  %
+ *      +  -
+ *      <  <=  >  >=       (signed)
+ *      ==  !=
+ *      &&
+ *      ||
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define EXPRESSION_SOURCE_LENGTH    256
+#define EXPRESSION_INSTRUCTIONS     128
+#define EXPRESSION_REGISTERS        256
+#define EXPRESSION_VARIABLES        26
+#define EXPRESSION_CACHE_SIZE       64
+
+typedef enum {
+    EXPRESSION_HALT = 0,
+    EXPRESSION_ADD,
+    EXPRESSION_SUBTRACT,
+    EXPRESSION_MULTIPLY,
+    EXPRESSION_DIVIDE,
+    EXPRESSION_REMAINDER,
+    EXPRESSION_NEGATE,
+    EXPRESSION_EQUAL,
+    EXPRESSION_NOT_EQUAL,
+    EXPRESSION_LESS_THAN,
+    EXPRESSION_AT_MOST,
+    EXPRESSION_GREATER_THAN,
+    EXPRESSION_AT_LEAST,
+    EXPRESSION_LOGICAL_AND,
+    EXPRESSION_LOGICAL_OR,
+    EXPRESSION_LOGICAL_NOT,
+    NUMBER_OF_EXPRESSION_OPCODES
+} expression_opcode_t;
+
+typedef struct {
+    uint8_t opcode;
+    uint8_t destination;
+    uint8_t source1;
+    uint8_t source2;            // unused by the unary operations
+} expression_instruction_t;
+
+/*
+ * The registers hold, in order, the variables that the expression uses (in alphabetical order), its literals, and
+ * its intermediate results. Only the variables change from one evaluation to the next, so a binding supplies
+ * number_of_variables values, one for each name in variable_names.
+ */
+typedef struct {
+    char source[EXPRESSION_SOURCE_LENGTH];                  // with whitespace removed
+    expression_instruction_t code[EXPRESSION_INSTRUCTIONS]; // ends with EXPRESSION_HALT
+    uint16_t registers[EXPRESSION_REGISTERS];               // the literals' values, at their registers
+    char variable_names[EXPRESSION_VARIABLES];
+    int number_of_instructions;                             // excluding the EXPRESSION_HALT
+    int number_of_variables;
+    int number_of_registers;
+    int result_register;
+    const char *error;                                      // NULL if the expression compiled
+} expression_t;
+
+bool expression_compile(const char *source, expression_t *expression) __attribute__ ((no_instrument_function));
+const expression_t *expression_compile_cached(const char *source, bool *was_cached) __attribute__ ((no_instrument_function));
+void expression_disassemble(const expression_t *expression) __attribute__ ((no_instrument_function));
+
+uint16_t expression_evaluate(const expression_t *expression, const uint16_t *binding) __attribute__ ((no_instrument_function));
+void expression_evaluate_batch(const expression_t *expression, const uint16_t *bindings, uint16_t *results,
+                               size_t count) __attribute__ ((no_instrument_function));
+bool expression_evaluate_reference(const expression_t *expression, const uint16_t *binding, uint16_t *value) __attribute__ ((no_instrument_function));
+
+#endif //EXPRESSION_H
@@ -0,0 +1,460 @@
+/**************************************************************************//**
+ *
+ * @file float16.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief binary16 and bfloat16 addition, subtraction, multiplication, and
+ *      comparison on the ALU.
+ *
+ * Both formats share one implementation, parameterized by the widths of the
+ * exponent and fraction fields. Fields are unpacked and packed with bitwise
+ * operators and fixed shifts, which are only wiring; everything that is
+ * arithmetic -- exponent sums and differences, significand sums, differences,
+ * and products, rounding increments, variable alignment and normalization
+ * shifts, and comparisons -- goes through the ALU's add, subtract,
+ * unsigned_multiply, barrel_shift, compare, and relations, with floor_lg
+ * standing in for a leading-zero counter.
+ *
+ * While an operation is in progress its significand carries three extra bits
+ * below the fraction (guard, round, and sticky), which are enough to round the
+ * sum, difference, or product to nearest, ties to even, in one step.
+ *
+ * The host reference computes binary16 with _Float16 where the compiler has
+ * it, and otherwise (and for bfloat16, which C has no type for) in double
+ * precision, which is exact for products and precise enough for sums that a
+ * single rounding to 16 bits is correct.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <math.h>
+#include <string.h>
+#include "float16.h"
+
+#ifdef __FLT16_MANT_DIG__
+#define FLOAT16_HOST_TYPE
+#endif
+
+#define SIGN_MASK           0x8000
+#define MAGNITUDE_MASK      0x7FFF
+#define GUARD_BITS          3
+#define GUARD_MASK          0x7
+#define HALFWAY             0x4         // the guard bit alone: exactly halfway between two representable values
+
+typedef struct {
+    const char *name;
+    uint16_t fraction_bits;
+    uint16_t exponent_mask;             // the exponent field's value for infinities and NaNs
+    uint16_t bias;
+    float16_t quiet_nan;
+} format_t;
+
+typedef struct {
+    uint16_t sign;                      // SIGN_MASK or 0
+    uint16_t exponent;                  // biased; 1 for subnormals, as for the smallest normal numbers
+    uint16_t significand;               // with the hidden bit for normal numbers
+} unpacked_t;
+
+static uint16_t sum(uint16_t value1, uint16_t value2);
+static uint16_t difference(uint16_t value1, uint16_t value2);
+static uint16_t hidden_bit(const format_t *format) __attribute__ ((no_instrument_function));
+static uint16_t fraction_mask(const format_t *format) __attribute__ ((no_instrument_function));
+static bool is_infinity(const format_t *format, float16_t value) __attribute__ ((no_instrument_function));
+static unpacked_t unpack(const format_t *format, float16_t value) __attribute__ ((no_instrument_function));
+static unpacked_t normalize(const format_t *format, unpacked_t value);
+static float16_t round_and_pack(const format_t *format, uint16_t sign, uint16_t exponent, uint16_t significand,
+                                bool sticky);
+static float16_t generic_from_double(const format_t *format, double value) __attribute__ ((no_instrument_function));
+
+static const format_t formats[NUMBER_OF_FLOAT16_FORMATS] = {
+        [FLOAT16_BINARY16] = {"binary16", 10, 0x1F, 15, 0x7E00},
+        [FLOAT16_BFLOAT16] = {"bfloat16", 7, 0xFF, 127, 0x7FC0},
+};
+
+static const char *operation_names[NUMBER_OF_FLOAT16_OPERATIONS] = {"add", "subtract", "multiply", "compare"};
+
+static uint16_t sum(uint16_t value1, uint16_t value2) {
+    return add(value1, value2).result;
+}
+
+static uint16_t difference(uint16_t value1, uint16_t value2) {
+    return subtract(value1, value2).result;
+}
+
+static uint16_t hidden_bit(const format_t *format) {
+    return (uint16_t) (1 << format->fraction_bits);
+}
+
+static uint16_t fraction_mask(const format_t *format) {
+    return (uint16_t) (hidden_bit(format) - 1);
+}
+
+static bool is_infinity(const format_t *format, float16_t value) {
+    return (value & MAGNITUDE_MASK) == (format->exponent_mask << format->fraction_bits);
+}
+
+static unpacked_t unpack(const format_t *format, float16_t value) {
+    uint16_t exponent = (value & MAGNITUDE_MASK) >> format->fraction_bits;
+    unpacked_t unpacked = {value & SIGN_MASK, exponent ? exponent : 1, value & fraction_mask(format)};
+    if (exponent) {
+        unpacked.significand |= hidden_bit(format);
+    }
+    return unpacked;
+}
+
+/* shifts a subnormal significand up to the hidden bit, letting the exponent go below 1 */
+static unpacked_t normalize(const format_t *format, unpacked_t value) {
+    if (!(value.significand & hidden_bit(format))) {
+        uint16_t places = difference(format->fraction_bits, (uint16_t) floor_lg(value.significand));
+        value.significand = barrel_shift(value.significand, (uint8_t) places, ALU_SHIFT_LEFT).result;
+        value.exponent = difference(value.exponent, places);
+    }
+    return value;
+}
+
+/*
+ * Rounds and encodes a result whose significand carries the guard bits. The significand's leading bit may be one
+ * place above the hidden bit (a carry out of a sum, or a product of two significands near 2), below it (after a
+ * difference cancels), or the exponent may be below 1 (a product of small values); each is normalized first.
+ * sticky records nonzero bits that have already been shifted out below the guard bits.
+ */
+static float16_t round_and_pack(const format_t *format, uint16_t sign, uint16_t exponent, uint16_t significand,
+                                bool sticky) {
+    uint16_t top = sum(format->fraction_bits, GUARD_BITS);     // the hidden bit's place with the guard bits attached
+    uint16_t leading = (uint16_t) floor_lg(significand);
+    if (unsigned_greater_than(leading, top)) {
+        alu_result_t shifted = barrel_shift(significand, 1, ALU_SHIFT_RIGHT);
+        significand = shifted.result;
+        sticky = sticky || shifted.supplemental_result;
+        exponent = sum(exponent, 1);
+    } else if (significand && unsigned_less_than(leading, top) && greater_than(exponent, 1)) {
+        // a cancellation is shifted back up, but not below the smallest exponent, where it becomes subnormal
+        uint16_t places = difference(top, leading);
+        uint16_t room = difference(exponent, 1);
+        places = unsigned_less_than(room, places) ? room : places;
+        significand = barrel_shift(significand, (uint8_t) places, ALU_SHIFT_LEFT).result;
+        exponent = difference(exponent, places);
+    }
+    if (less_than(exponent, 1)) {
+        uint16_t places = difference(1, exponent);
+        if (unsigned_less_than(places, ALU_WIDTH)) {
+            alu_result_t shifted = barrel_shift(significand, (uint8_t) places, ALU_SHIFT_RIGHT);
+            significand = shifted.result;
+            sticky = sticky || shifted.supplemental_result;
+        } else {
+            sticky = sticky || significand;
+            significand = 0;
+        }
+        exponent = 1;
+    }
+    uint16_t guard = significand & GUARD_MASK;
+    significand >>= GUARD_BITS;
+    // round up above the halfway point, and at it when that makes the significand even
+    if ((guard & HALFWAY) && ((guard & (GUARD_MASK ^ HALFWAY)) || sticky || (significand & 0x1))) {
+        significand = sum(significand, 1);
+        if (significand & (hidden_bit(format) << 1)) {
+            significand >>= 1;
+            exponent = sum(exponent, 1);
+        }
+    }
+    if (!less_than(exponent, format->exponent_mask)) {
+        return sign | (format->exponent_mask << format->fraction_bits);
+    }
+    // a subnormal significand has no hidden bit, and is encoded with an exponent field of 0
+    uint16_t exponent_field = (significand & hidden_bit(format)) ? exponent : 0;
+    return sign | (uint16_t) (exponent_field << format->fraction_bits) | (significand & fraction_mask(format));
+}
+
+/**
+ * Adds two 16-bit floating-point values, rounding to nearest, ties to even.
+ * @param format binary16 or bfloat16
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @return the rounded sum; the format's quiet NaN if either operand is a NaN or the sum is infinity - infinity
+ */
+float16_t float16_add(float16_format_t format, float16_t augend, float16_t addend) {
+    const format_t *f = formats + format;
+    if (float16_is_nan(format, augend) || float16_is_nan(format, addend)) {
+        return f->quiet_nan;
+    }
+    if (is_infinity(f, augend)) {
+        return (is_infinity(f, addend) && ((augend ^ addend) & SIGN_MASK)) ? f->quiet_nan : augend;
+    }
+    if (is_infinity(f, addend)) {
+        return addend;
+    }
+    // the larger magnitude goes first, so that the exponent difference and a significand difference are not negative
+    if (unsigned_less_than(augend & MAGNITUDE_MASK, addend & MAGNITUDE_MASK)) {
+        float16_t larger = addend;
+        addend = augend;
+        augend = larger;
+    }
+    if (!(addend & MAGNITUDE_MASK)) {
+        // x + 0 is x, except that the sum of zeroes is -0 only when both are -0
+        return (augend & MAGNITUDE_MASK) ? augend : (augend & addend);
+    }
+    unpacked_t larger = unpack(f, augend);
+    unpacked_t smaller = unpack(f, addend);
+    uint16_t larger_significand = (uint16_t) (larger.significand << GUARD_BITS);
+    uint16_t smaller_significand = (uint16_t) (smaller.significand << GUARD_BITS);
+    uint16_t places = difference(larger.exponent, smaller.exponent);
+    uint16_t aligned;
+    if (unsigned_less_than(places, ALU_WIDTH)) {
+        alu_result_t shifted = barrel_shift(smaller_significand, (uint8_t) places, ALU_SHIFT_RIGHT);
+        // everything shifted past the guard bits collapses into the sticky bit
+        aligned = shifted.result | is_not_zero(shifted.supplemental_result);
+    } else {
+        aligned = is_not_zero(smaller_significand);
+    }
+    uint16_t significand = (larger.sign == smaller.sign) ? sum(larger_significand, aligned)
+                                                         : difference(larger_significand, aligned);
+    if (!significand) {
+        return 0;       // x - x is +0
+    }
+    return round_and_pack(f, larger.sign, larger.exponent, significand, false);
+}
+
+/**
+ * Subtracts two 16-bit floating-point values, rounding to nearest, ties to even.
+ * @param format binary16 or bfloat16
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @return the rounded difference; the format's quiet NaN if either operand is a NaN or the difference is
+ * infinity - infinity
+ */
+float16_t float16_subtract(float16_format_t format, float16_t menuend, float16_t subtrahend) {
+    return float16_add(format, menuend, subtrahend ^ SIGN_MASK);
+}
+
+/**
+ * Multiplies two 16-bit floating-point values, rounding to nearest, ties to even.
+ * @param format binary16 or bfloat16
+ * @param multiplicand the number to be multiplied
+ * @param multiplier the number that the first is to be multiplied by
+ * @return the rounded product; the format's quiet NaN if either operand is a NaN or the product is infinity * 0
+ */
+float16_t float16_multiply(float16_format_t format, float16_t multiplicand, float16_t multiplier) {
+    const format_t *f = formats + format;
+    uint16_t sign = (multiplicand ^ multiplier) & SIGN_MASK;
+    if (float16_is_nan(format, multiplicand) || float16_is_nan(format, multiplier)) {
+        return f->quiet_nan;
+    }
+    if (is_infinity(f, multiplicand) || is_infinity(f, multiplier)) {
+        bool zero = !(multiplicand & MAGNITUDE_MASK) || !(multiplier & MAGNITUDE_MASK);
+        return zero ? f->quiet_nan : sign | (f->exponent_mask << f->fraction_bits);
+    }
+    if (!(multiplicand & MAGNITUDE_MASK) || !(multiplier & MAGNITUDE_MASK)) {
+        return sign;
+    }
+    unpacked_t first = normalize(f, unpack(f, multiplicand));
+    unpacked_t second = normalize(f, unpack(f, multiplier));
+    // the product of two significands with their hidden bits set has its leading bit 2F or 2F+1 places up
+    alu_result_t product = unsigned_multiply(first.significand, second.significand);
+    uint16_t exponent = difference(sum(first.exponent, second.exponent), f->bias);
+    // bring the leading bit down to the hidden bit's place with the guard bits attached, across both halves
+    uint8_t places = (uint8_t) difference(f->fraction_bits, GUARD_BITS);
+    alu_result_t lower = barrel_shift(product.result, places, ALU_SHIFT_RIGHT);
+    alu_result_t upper = barrel_shift(product.supplemental_result, places, ALU_SHIFT_RIGHT);
+    uint16_t significand = lower.result | upper.supplemental_result;
+    return round_and_pack(f, sign, exponent, significand, lower.supplemental_result);
+}
+
+/**
+ * Compares two 16-bit floating-point values. -0 and +0 are equal, and a NaN is unordered with everything.
+ * @param format binary16 or bfloat16
+ * @param value1 the value on the left side of the comparison
+ * @param value2 the value on the right side of the comparison
+ * @return whether the first value is less than, equal to, greater than, or unordered with the second
+ */
+float16_relation_t float16_compare(float16_format_t format, float16_t value1, float16_t value2) {
+    if (float16_is_nan(format, value1) || float16_is_nan(format, value2)) {
+        return FLOAT16_UNORDERED;
+    }
+    if (!((value1 | value2) & MAGNITUDE_MASK)) {
+        return FLOAT16_EQUAL;
+    }
+    // sign-magnitude to an unsigned order: negative values reversed below the positive ones
+    uint16_t key1 = (value1 & SIGN_MASK) ? (uint16_t) ~value1 : (value1 ^ SIGN_MASK);
+    uint16_t key2 = (value2 & SIGN_MASK) ? (uint16_t) ~value2 : (value2 ^ SIGN_MASK);
+    alu_flags_t flags = compare(key1, key2);
+    return flags_equal(flags) ? FLOAT16_EQUAL : (flags_unsigned_less_than(flags) ? FLOAT16_LESS : FLOAT16_GREATER);
+}
+
+/**
+ * Applies one operation to each pair of operands.
+ * @param format binary16 or bfloat16
+ * @param operation the operation; for <code>FLOAT16_COMPARE</code>, each result is a <code>float16_relation_t</code>
+ * @param operands1 the first operand of each pair
+ * @param operands2 the second operand of each pair
+ * @param results where the results are written
+ * @param count the number of pairs
+ */
+void float16_batch(float16_format_t format, float16_operation_t operation, const float16_t *operands1,
+                   const float16_t *operands2, float16_t *results, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        switch (operation) {
+            case FLOAT16_ADD:
+                results[i] = float16_add(format, operands1[i], operands2[i]);
+                break;
+            case FLOAT16_SUBTRACT:
+                results[i] = float16_subtract(format, operands1[i], operands2[i]);
+                break;
+            case FLOAT16_MULTIPLY:
+                results[i] = float16_multiply(format, operands1[i], operands2[i]);
+                break;
+            default:
+                results[i] = (float16_t) float16_compare(format, operands1[i], operands2[i]);
+                break;
+        }
+    }
+}
+
+/**
+ * Determines whether a value is a NaN: its exponent field is all ones and its fraction is not zero.
+ * @param format binary16 or bfloat16
+ * @param value the encoded value
+ * @return 1 if the value is a NaN; 0 otherwise
+ */
+bool float16_is_nan(float16_format_t format, float16_t value) {
+    const format_t *f = formats + format;
+    return (value & MAGNITUDE_MASK) > (f->exponent_mask << f->fraction_bits);
+}
+
+/**
+ * Decodes a value exactly.
+ * @param format binary16 or bfloat16
+ * @param value the encoded value
+ * @return the value in double precision
+ */
+double float16_to_double(float16_format_t format, float16_t value) {
+    const format_t *f = formats + format;
+    int exponent = (value & MAGNITUDE_MASK) >> f->fraction_bits;
+    int fraction = value & ((1 << f->fraction_bits) - 1);
+    double magnitude;
+    if (exponent == f->exponent_mask) {
+        magnitude = fraction ? NAN : INFINITY;
+    } else if (exponent) {
+        magnitude = ldexp(fraction + (1 << f->fraction_bits), exponent - f->bias - f->fraction_bits);
+    } else {
+        magnitude = ldexp(fraction, 1 - f->bias - f->fraction_bits);
+    }
+    return (value & SIGN_MASK) ? -magnitude : magnitude;
+}
+
+/* rounds to the nearest multiple of the format's spacing at the value's magnitude, ties to even, then encodes */
+static float16_t generic_from_double(const format_t *format, double value) {
+    if (isnan(value)) {
+        return format->quiet_nan;
+    }
+    float16_t sign = signbit(value) ? SIGN_MASK : 0;
+    double magnitude = fabs(value);
+    if (magnitude == 0.0) {
+        return sign;
+    }
+    if (isinf(magnitude)) {
+        return sign | (format->exponent_mask << format->fraction_bits);
+    }
+    int exponent;
+    frexp(magnitude, &exponent);
+    exponent--;                                         // magnitude is in [2**exponent, 2**(exponent + 1))
+    int minimum_exponent = 1 - format->bias;
+    exponent = exponent < minimum_exponent ? minimum_exponent : exponent;
+    double steps = nearbyint(ldexp(magnitude, format->fraction_bits - exponent));    // the default mode is ties-to-even
+    if (steps >= ldexp(1.0, format->fraction_bits + 1)) {
+        steps = ldexp(steps, -1);                       // rounded up to the next power of two, which is exact
+        exponent++;
+    }
+    if (exponent + format->bias >= format->exponent_mask) {
+        return sign | (format->exponent_mask << format->fraction_bits);
+    }
+    uint16_t significand = (uint16_t) steps;
+    uint16_t exponent_field = (significand >> format->fraction_bits) ? (uint16_t) (exponent + format->bias) : 0;
+    return sign | (uint16_t) (exponent_field << format->fraction_bits)
+           | (significand & ((1 << format->fraction_bits) - 1));
+}
+
+/**
+ * Rounds a value to the nearest encodable value, ties to even, with the host's floating-point support.
+ * @param format binary16 or bfloat16
+ * @param value the value to be encoded
+ * @return the encoded value; the format's quiet NaN for any NaN
+ */
+float16_t float16_from_double(float16_format_t format, double value) {
+#ifdef FLOAT16_HOST_TYPE
+    if (format == FLOAT16_BINARY16 && !isnan(value)) {
+        _Float16 half = (_Float16) value;
+        float16_t encoded;
+        memcpy(&encoded, &half, sizeof(encoded));
+        return encoded;
+    }
+#endif
+    return generic_from_double(formats + format, value);
+}
+
+/**
+ * Performs an operation with the host's floating-point support, for checking the ALU-based functions.
+ * @param format binary16 or bfloat16
+ * @param operation the operation
+ * @param operand1 the first operand
+ * @param operand2 the second operand
+ * @return the encoded result, or for <code>FLOAT16_COMPARE</code> the <code>float16_relation_t</code>
+ */
+float16_t float16_host(float16_format_t format, float16_operation_t operation, float16_t operand1,
+                       float16_t operand2) {
+    double value1 = float16_to_double(format, operand1);
+    double value2 = float16_to_double(format, operand2);
+    if (operation == FLOAT16_COMPARE) {
+        if (isnan(value1) || isnan(value2)) {
+            return FLOAT16_UNORDERED;
+        }
+        return value1 < value2 ? FLOAT16_LESS : (value1 == value2 ? FLOAT16_EQUAL : FLOAT16_GREATER);
+    }
+#ifdef FLOAT16_HOST_TYPE
+    if (format == FLOAT16_BINARY16) {
+        _Float16 half1 = (_Float16) value1, half2 = (_Float16) value2, result;
+        switch (operation) {
+            case FLOAT16_ADD:
+                result = half1 + half2;
+                break;
+            case FLOAT16_SUBTRACT:
+                result = half1 - half2;
+                break;
+            default:
+                result = half1 * half2;
+                break;
+        }
+        return float16_from_double(format, (double) result);
+    }
+#endif
+    switch (operation) {
+        case FLOAT16_ADD:
+            return float16_from_double(format, value1 + value2);
+        case FLOAT16_SUBTRACT:
+            return float16_from_double(format, value1 - value2);
+        default:
+            return float16_from_double(format, value1 * value2);
+    }
+}
+
+/**
+ * Names a format.
+ * @param format binary16 or bfloat16
+ * @return the format's name
+ */
+const char *float16_format_name(float16_format_t format) {
+    return (format < NUMBER_OF_FLOAT16_FORMATS) ? formats[format].name : "unknown";
+}
+
+/**
+ * Names an operation, as the driver spells it.
+ * @param operation the operation
+ * @return the operation's name
+ */
+const char *float16_operation_name(float16_operation_t operation) {
+    return (operation < NUMBER_OF_FLOAT16_OPERATIONS) ? operation_names[operation] : "unknown";
+}
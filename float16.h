@@ -0,0 +1,65 @@
+/**************************************************************************//**
+ *
+ * @file float16.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for 16-bit floating-point
+ *      arithmetic, in IEEE 754 binary16 and in bfloat16, built on the ALU.
+ *
+ * Values are passed as their 16-bit encodings. Results are rounded to nearest,
+ * ties to even; subnormals are supported in both formats; and an operation
+ * that produces a NaN returns the format's canonical quiet NaN.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef FLOAT16_H
+#define FLOAT16_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+typedef uint16_t float16_t;
+
+typedef enum {
+    FLOAT16_BINARY16 = 0,           // 1 sign bit, 5 exponent bits, 10 fraction bits
+    FLOAT16_BFLOAT16,               // 1 sign bit, 8 exponent bits, 7 fraction bits
+    NUMBER_OF_FLOAT16_FORMATS
+} float16_format_t;
+
+typedef enum {
+    FLOAT16_ADD = 0,
+    FLOAT16_SUBTRACT,
+    FLOAT16_MULTIPLY,
+    FLOAT16_COMPARE,                // the batch and host functions encode the float16_relation_t as the result
+    NUMBER_OF_FLOAT16_OPERATIONS
+} float16_operation_t;
+
+typedef enum {
+    FLOAT16_LESS = 0,
+    FLOAT16_EQUAL,
+    FLOAT16_GREATER,
+    FLOAT16_UNORDERED               // at least one operand is a NaN
+} float16_relation_t;
+
+float16_t float16_add(float16_format_t format, float16_t augend, float16_t addend);
+float16_t float16_subtract(float16_format_t format, float16_t menuend, float16_t subtrahend);
+float16_t float16_multiply(float16_format_t format, float16_t multiplicand, float16_t multiplier);
+float16_relation_t float16_compare(float16_format_t format, float16_t value1, float16_t value2);
+void float16_batch(float16_format_t format, float16_operation_t operation, const float16_t *operands1,
+                   const float16_t *operands2, float16_t *results, size_t count);
+
+bool float16_is_nan(float16_format_t format, float16_t value) __attribute__ ((no_instrument_function));
+double float16_to_double(float16_format_t format, float16_t value) __attribute__ ((no_instrument_function));
+float16_t float16_from_double(float16_format_t format, double value) __attribute__ ((no_instrument_function));
+float16_t float16_host(float16_format_t format, float16_operation_t operation, float16_t operand1,
+                       float16_t operand2) __attribute__ ((no_instrument_function));
+const char *float16_format_name(float16_format_t format) __attribute__ ((no_instrument_function));
+const char *float16_operation_name(float16_operation_t operation) __attribute__ ((no_instrument_function));
+
+#endif //FLOAT16_H
@@ -0,0 +1,425 @@
+/**************************************************************************//**
+ *
+ * @file formatter.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Writes expected and actual ALU results into a large output buffer,
+ *      converting numbers to hexadecimal and decimal by hand.
+ *
+ * A full check is a dozen lines with two dozen numbers in them; formatting it
+ * with printf costs far more than the arithmetic being checked. Here every
+ * number is converted with a short loop straight into the buffer, which is
+ * written to the stream only when it fills.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "formatter.h"
+
+#define FORMAT_LONGEST_NUMBER   24
+#define FORMAT_LITERAL(buffer, literal) format_bytes((buffer), (literal), sizeof(literal) - 1)
+
+static const char hexadecimal_digits[] = "0123456789ABCDEF";
+
+static void format_hex16(format_buffer_t *buffer, uint16_t value) __attribute__ ((no_instrument_function));
+static void format_value(format_buffer_t *buffer, uint16_t value, bool is_signed) __attribute__ ((no_instrument_function));
+static void format_calls(format_buffer_t *buffer, const char *function, int calls) __attribute__ ((no_instrument_function));
+static bool section_matches(const format_arithmetic_t *check, int section) __attribute__ ((no_instrument_function));
+static void format_sum_section(format_buffer_t *buffer, const format_arithmetic_t *check, int section) __attribute__ ((no_instrument_function));
+static void format_product_section(format_buffer_t *buffer, const format_arithmetic_t *check, int section) __attribute__ ((no_instrument_function));
+static void format_quotient_section(format_buffer_t *buffer, const format_arithmetic_t *check, int section) __attribute__ ((no_instrument_function));
+
+/*
+ * THE BUFFER AND NUMBER CONVERSION
+ */
+
+/**
+ * Prepares a buffer that writes to a stream.
+ * @param buffer the buffer to prepare
+ * @param stream where the buffer's contents go when it fills or is flushed; NULL discards them (they are still
+ *      counted and checksummed)
+ * @param capacity the buffer's size in bytes; 0 selects FORMAT_BUFFER_SIZE
+ * @return true if the buffer could be allocated
+ */
+bool format_open(format_buffer_t *buffer, FILE *stream, size_t capacity) {
+    buffer->stream = stream;
+    buffer->capacity = capacity ? capacity : FORMAT_BUFFER_SIZE;
+    buffer->text = malloc(buffer->capacity);
+    buffer->used = 0;
+    buffer->bytes_written = 0;
+    buffer->checksummed = false;
+    buffer->checksum = 0xCBF29CE484222325ull;
+    return buffer->text != NULL;
+}
+
+/**
+ * Writes the buffer's contents to its stream and empties it.
+ * @param buffer the buffer
+ */
+void format_flush(format_buffer_t *buffer) {
+    for (size_t i = 0; buffer->checksummed && i < buffer->used; i++) {
+        buffer->checksum = (buffer->checksum ^ (uint8_t) buffer->text[i]) * 0x100000001B3ull;
+    }
+    if (buffer->stream && buffer->used) {
+        fwrite(buffer->text, 1, buffer->used, buffer->stream);
+    }
+    buffer->bytes_written += buffer->used;
+    buffer->used = 0;
+}
+
+/**
+ * Flushes the buffer and releases its memory; the stream stays open.
+ * @param buffer the buffer
+ */
+void format_close(format_buffer_t *buffer) {
+    format_flush(buffer);
+    if (buffer->stream) {
+        fflush(buffer->stream);
+    }
+    free(buffer->text);
+    buffer->text = NULL;
+}
+
+/**
+ * Flushes the buffer if fewer than <code>length</code> bytes are free.
+ * @param buffer the buffer
+ * @param length the number of bytes about to be written
+ */
+void format_reserve(format_buffer_t *buffer, size_t length) {
+    if (buffer->used + length > buffer->capacity) {
+        format_flush(buffer);
+    }
+}
+
+/**
+ * Writes bytes that need not be terminated.
+ * @param buffer the buffer
+ * @param bytes the bytes
+ * @param length the number of bytes
+ */
+void format_bytes(format_buffer_t *buffer, const char *bytes, size_t length) {
+    format_reserve(buffer, length);
+    if (length > buffer->capacity) {
+        // too long to buffer at all, and the buffer has just been flushed
+        for (size_t i = 0; buffer->checksummed && i < length; i++) {
+            buffer->checksum = (buffer->checksum ^ (uint8_t) bytes[i]) * 0x100000001B3ull;
+        }
+        if (buffer->stream) {
+            fwrite(bytes, 1, length, buffer->stream);
+        }
+        buffer->bytes_written += length;
+    } else {
+        memcpy(buffer->text + buffer->used, bytes, length);
+        buffer->used += length;
+    }
+}
+
+void format_string(format_buffer_t *buffer, const char *string) {
+    format_bytes(buffer, string, strlen(string));
+}
+
+void format_character(format_buffer_t *buffer, char character) {
+    format_reserve(buffer, 1);
+    buffer->text[buffer->used++] = character;
+}
+
+void format_unsigned(format_buffer_t *buffer, uint64_t value) {
+    char digits[FORMAT_LONGEST_NUMBER];
+    int count = 0;
+    do {
+        digits[count++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value);
+    format_reserve(buffer, (size_t) count);
+    while (count) {
+        buffer->text[buffer->used++] = digits[--count];
+    }
+}
+
+void format_signed(format_buffer_t *buffer, int64_t value) {
+    if (value < 0) {
+        format_character(buffer, '-');
+        // negate in unsigned arithmetic, so that INT64_MIN does not overflow
+        format_unsigned(buffer, 0 - (uint64_t) value);
+    } else {
+        format_unsigned(buffer, (uint64_t) value);
+    }
+}
+
+/**
+ * Writes a number in uppercase hexadecimal with no prefix, padded with zeroes.
+ * @param buffer the buffer
+ * @param value the number
+ * @param digits the minimum number of digits, at most 16
+ */
+void format_hexadecimal(format_buffer_t *buffer, uint64_t value, int digits) {
+    int count = 1;
+    while (count < 16 && value >> (4 * count)) {
+        count++;
+    }
+    count = count < digits ? digits : count;
+    format_reserve(buffer, (size_t) count);
+    for (int i = count - 1; i >= 0; i--) {
+        buffer->text[buffer->used++] = hexadecimal_digits[(value >> (4 * i)) & 0xF];
+    }
+}
+
+/**
+ * Writes a non-integer in fixed-point notation, rounded to the given number of decimal places.
+ * @param buffer the buffer
+ * @param value the number, whose magnitude must be less than 2^64 / 10^decimals
+ * @param decimals the number of digits after the decimal point, at most 9
+ */
+void format_fixed(format_buffer_t *buffer, double value, int decimals) {
+    uint64_t scale = 1;
+    for (int i = 0; i < decimals; i++) {
+        scale *= 10;
+    }
+    if (value < 0) {
+        format_character(buffer, '-');
+        value = -value;
+    }
+    uint64_t scaled = (uint64_t) (value * (double) scale + 0.5);
+    format_unsigned(buffer, scaled / scale);
+    if (decimals) {
+        uint64_t fraction = scaled % scale;
+        format_character(buffer, '.');
+        for (uint64_t place = scale / 10; place; place /= 10) {
+            format_character(buffer, (char) ('0' + fraction / place % 10));
+        }
+    }
+}
+
+static void format_hex16(format_buffer_t *buffer, uint16_t value) {
+    FORMAT_LITERAL(buffer, "0x");
+    format_hexadecimal(buffer, value, 4);
+}
+
+static void format_value(format_buffer_t *buffer, uint16_t value, bool is_signed) {
+    if (is_signed) {
+        format_signed(buffer, (int16_t) value);
+    } else {
+        format_unsigned(buffer, value);
+    }
+}
+
+static void format_calls(format_buffer_t *buffer, const char *function, int calls) {
+    if (calls >= 0) {
+        FORMAT_LITERAL(buffer, "\t\tNumber of calls to ");
+        format_string(buffer, function);
+        format_signed(buffer, calls);
+        format_character(buffer, '\n');
+    }
+}
+
+/*
+ * ARITHMETIC CHECKS
+ */
+
+static bool section_matches(const format_arithmetic_t *check, int section) {
+    const struct authoritative_result *expected = check->expected + section;
+    const alu_result_t *actual = check->actual + section;
+    switch (check->operator) {
+        case '+':
+        case '-':
+            return actual->result == expected->result
+                   && (section ? actual->signed_overflow == expected->o_flag
+                               : actual->unsigned_overflow == expected->c_flag);
+        case '*':
+            return actual->result == expected->result && actual->supplemental_result == expected->supplemental_result;
+        default:
+            return check->operand2 ? !actual->divide_by_zero && actual->result == expected->result
+                                     && actual->supplemental_result == expected->supplemental_result
+                                   : actual->divide_by_zero;
+    }
+}
+
+/**
+ * Determines whether the ALU produced the authoritative results and flags.
+ * @param check the operands, the expected results, and the actual results
+ * @return true if both the unsigned and the signed results match
+ */
+bool format_arithmetic_matches(const format_arithmetic_t *check) {
+    return section_matches(check, 0) && section_matches(check, 1);
+}
+
+static void format_sum_section(format_buffer_t *buffer, const format_arithmetic_t *check, int section) {
+    static const char *expected_labels[] = {"\texpected result (unsigned):    ", "\texpected result (signed):      "};
+    static const char *actual_labels[] = {"\tactual result (unsigned):      ", "\tactual result (signed):        "};
+    const char *labels[] = {expected_labels[section], actual_labels[section]};
+    char operator[4] = {' ', check->operator, ' ', '\0'};
+    uint16_t results[] = {check->expected[section].result, check->actual[section].result};
+    bool overflows[] = {section ? check->expected[section].o_flag : check->expected[section].c_flag,
+                        section ? check->actual[section].signed_overflow : check->actual[section].unsigned_overflow};
+    format_string(buffer, section ? "SIGNED " : "UNSIGNED ");
+    format_string(buffer, check->operator == '+' ? "ADDITION\n" : "SUBTRACTION\n");
+    for (int i = 0; i < 2; i++) {
+        format_string(buffer, i ? "\tactual result (hexadecimal):   " : "\texpected result (hexadecimal): ");
+        format_hex16(buffer, check->operand1);
+        format_string(buffer, operator);
+        format_hex16(buffer, check->operand2);
+        FORMAT_LITERAL(buffer, " = ");
+        format_hex16(buffer, results[i]);
+        format_character(buffer, '\n');
+        format_string(buffer, labels[i]);
+        format_value(buffer, check->operand1, section);
+        format_string(buffer, operator);
+        format_value(buffer, check->operand2, section);
+        FORMAT_LITERAL(buffer, " = ");
+        format_value(buffer, results[i], section);
+        format_string(buffer, overflows[i] ? "\toverflow: true\n" : "\toverflow: false\n");
+    }
+}
+
+static void format_product_section(format_buffer_t *buffer, const format_arithmetic_t *check, int section) {
+    static const char *expected_labels[] = {"\texpected result (unsigned):    ", "\texpected result (signed):      "};
+    static const char *actual_labels[] = {"\tactual result (unsigned):      ", "\tactual result (signed):        "};
+    const char *labels[] = {expected_labels[section], actual_labels[section]};
+    uint16_t lows[] = {check->expected[section].result, check->actual[section].result};
+    uint16_t highs[] = {check->expected[section].supplemental_result, check->actual[section].supplemental_result};
+    format_string(buffer, section ? "SIGNED MULTIPLICATION\n" : "UNSIGNED MULTIPLICATION\n");
+    for (int i = 0; i < 2; i++) {
+        uint32_t product = (uint32_t) highs[i] << 16 | lows[i];
+        format_string(buffer, i ? "\tactual result (hexadecimal):   " : "\texpected result (hexadecimal): ");
+        format_hex16(buffer, check->operand1);
+        FORMAT_LITERAL(buffer, " * ");
+        format_hex16(buffer, check->operand2);
+        FORMAT_LITERAL(buffer, " = ");
+        format_hex16(buffer, highs[i]);
+        format_character(buffer, '\'');
+        format_hexadecimal(buffer, lows[i], 4);
+        format_character(buffer, '\n');
+        format_string(buffer, labels[i]);
+        format_value(buffer, check->operand1, section);
+        FORMAT_LITERAL(buffer, " * ");
+        format_value(buffer, check->operand2, section);
+        FORMAT_LITERAL(buffer, " = ");
+        format_value(buffer, lows[i], section);
+        FORMAT_LITERAL(buffer, " (");
+        if (section) {
+            format_signed(buffer, (int32_t) product);
+        } else {
+            format_unsigned(buffer, product);
+        }
+        FORMAT_LITERAL(buffer, ")\n");
+    }
+}
+
+static void format_quotient_section(format_buffer_t *buffer, const format_arithmetic_t *check, int section) {
+    static const char *expected_labels[] = {"\texpected result (unsigned):    ", "\texpected result (signed):      "};
+    static const char *actual_labels[] = {"\tactual result (unsigned):      ", "\tactual result (signed):        "};
+    const char *labels[] = {expected_labels[section], actual_labels[section]};
+    uint16_t quotients[] = {check->expected[section].result, check->actual[section].result};
+    uint16_t remainders[] = {check->expected[section].supplemental_result, check->actual[section].supplemental_result};
+    bool by_zero[] = {check->operand2 == 0, check->actual[section].divide_by_zero};
+    format_string(buffer, section ? "SIGNED DIVISION\n" : "UNSIGNED DIVISION\n");
+    for (int i = 0; i < 2; i++) {
+        if (by_zero[i]) {
+            format_string(buffer, i ? "actual result:   divide-by-zero\n" : "expected result: divide-by-zero\n");
+            continue;
+        }
+        format_string(buffer, i ? "\tactual result (hexadecimal):   " : "\texpected result (hexadecimal): ");
+        format_hex16(buffer, check->operand1);
+        FORMAT_LITERAL(buffer, " / ");
+        format_hex16(buffer, check->operand2);
+        FORMAT_LITERAL(buffer, " = ");
+        format_hex16(buffer, quotients[i]);
+        FORMAT_LITERAL(buffer, "    ");
+        format_hex16(buffer, check->operand1);
+        FORMAT_LITERAL(buffer, " % ");
+        format_hex16(buffer, check->operand2);
+        FORMAT_LITERAL(buffer, " = ");
+        format_hex16(buffer, remainders[i]);
+        format_character(buffer, '\n');
+        format_string(buffer, labels[i]);
+        format_value(buffer, check->operand1, section);
+        FORMAT_LITERAL(buffer, " / ");
+        format_value(buffer, check->operand2, section);
+        FORMAT_LITERAL(buffer, " = ");
+        format_value(buffer, quotients[i], section);
+        FORMAT_LITERAL(buffer, "    ");
+        format_value(buffer, check->operand1, section);
+        FORMAT_LITERAL(buffer, " % ");
+        format_value(buffer, check->operand2, section);
+        FORMAT_LITERAL(buffer, " = ");
+        format_value(buffer, remainders[i], section);
+        format_character(buffer, '\n');
+    }
+    format_calls(buffer, "ripple_carry_addition:    ", check->addition_calls[section]);
+    format_calls(buffer, "multiply_by_power_of_two: ", check->shift_calls[section]);
+}
+
+/**
+ * Writes an arithmetic check in the same form that the driver's evaluate_print_arithmetic always has.
+ * @param buffer where the check is written
+ * @param verbosity FORMAT_FULL writes every check, FORMAT_MISMATCHES only those that fail, FORMAT_SUMMARY none
+ * @param check the operator, operands, expected results, actual results, and optionally the profiler's call counts
+ * @return true if the ALU's results and flags match the authoritative ones
+ */
+bool format_arithmetic(format_buffer_t *buffer, format_verbosity_t verbosity, const format_arithmetic_t *check) {
+    bool matched = format_arithmetic_matches(check);
+    if (verbosity == FORMAT_FULL || (verbosity == FORMAT_MISMATCHES && !matched)) {
+        switch (check->operator) {
+            case '+':
+            case '-':
+                format_sum_section(buffer, check, 0);
+                format_sum_section(buffer, check, 1);
+                format_calls(buffer, "ripple_carry_addition:    ", check->addition_calls[0]);
+                break;
+            case '*':
+                format_product_section(buffer, check, 0);
+                format_product_section(buffer, check, 1);
+                format_calls(buffer, "ripple_carry_addition:    ", check->addition_calls[0]);
+                format_calls(buffer, "multiply_by_power_of_two: ", check->shift_calls[0]);
+                break;
+            default:
+                if (check->operand2 > 0 && __builtin_popcount(check->operand2) != 1) {
+                    FORMAT_LITERAL(buffer, "[NOTE] ");
+                    format_hex16(buffer, check->operand2);
+                    FORMAT_LITERAL(buffer, " is not a power-of-two; "
+                                          "the assignment only requires division by powers-of-two.\n");
+                }
+                format_quotient_section(buffer, check, 0);
+                format_quotient_section(buffer, check, 1);
+        }
+    }
+    return matched;
+}
+
+/**
+ * Writes a comparison or logical operation's expected and actual truth values.
+ * @param buffer where the check is written
+ * @param verbosity FORMAT_FULL writes every check, FORMAT_MISMATCHES only those that fail, FORMAT_SUMMARY none
+ * @param check the operator, operands, and truth values
+ * @return true if the actual truth value is the expected one
+ */
+bool format_relation(format_buffer_t *buffer, format_verbosity_t verbosity, const format_relation_t *check) {
+    bool matched = check->expected == check->actual;
+    if (verbosity == FORMAT_FULL || (verbosity == FORMAT_MISMATCHES && !matched)) {
+        for (int i = 0; i < 2; i++) {
+            format_string(buffer, i ? "actual:   " : "expected: ");
+            format_string(buffer, check->parenthesized ? "(" : "");
+            format_value(buffer, check->operand1, check->signed_operands);
+            format_character(buffer, ' ');
+            format_string(buffer, check->symbol);
+            format_character(buffer, ' ');
+            format_value(buffer, check->operand2, check->signed_operands);
+            format_string(buffer, check->parenthesized ? ") = " : " = ");
+            format_signed(buffer, i ? check->actual : check->expected);
+            format_character(buffer, '\n');
+        }
+    }
+    return matched;
+}
+
+const char *format_verbosity_name(format_verbosity_t verbosity) {
+    static const char *names[] = {"full", "mismatches", "summary"};
+    return names[verbosity];
+}
@@ -0,0 +1,85 @@
+/**************************************************************************//**
+ *
+ * @file formatter.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for writing expected and
+ *      actual ALU results into a large output buffer without printf.
+ *
+ * A check is written in one of three verbosities: in full, exactly as the
+ * driver has always printed it; only if the ALU's result or flags differ from
+ * the authoritative result; or not at all, leaving the caller to summarize.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef FORMATTER_H
+#define FORMATTER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "alu_extensions.h"
+#include "authoritative_results.h"
+
+#define FORMAT_BUFFER_SIZE      (64 * 1024)
+
+typedef enum {
+    FORMAT_FULL = 0,
+    FORMAT_MISMATCHES,
+    FORMAT_SUMMARY
+} format_verbosity_t;
+
+typedef struct {
+    FILE *stream;
+    char *text;
+    size_t used;
+    size_t capacity;
+    uint64_t bytes_written;
+    bool checksummed;                       // set after opening the buffer to compute the checksum
+    uint64_t checksum;                      // FNV-1a over everything written, to compare runs
+} format_buffer_t;
+
+/* the first element of each pair is the unsigned operation, the second the signed one */
+typedef struct {
+    char operator;                          // one of + - * / %
+    uint16_t operand1;
+    uint16_t operand2;
+    struct authoritative_result expected[2];
+    alu_result_t actual[2];
+    int addition_calls[2];                  // from the profiler, or -1 to leave the count out
+    int shift_calls[2];
+} format_arithmetic_t;
+
+typedef struct {
+    const char *symbol;
+    uint16_t operand1;
+    uint16_t operand2;
+    bool signed_operands;
+    bool parenthesized;                     // relations are written "(a < b) = 1", logical operators "a && b = 1"
+    int expected;
+    int actual;
+} format_relation_t;
+
+bool format_open(format_buffer_t *buffer, FILE *stream, size_t capacity) __attribute__ ((no_instrument_function));
+void format_flush(format_buffer_t *buffer) __attribute__ ((no_instrument_function));
+void format_close(format_buffer_t *buffer) __attribute__ ((no_instrument_function));
+void format_reserve(format_buffer_t *buffer, size_t length) __attribute__ ((no_instrument_function));
+void format_bytes(format_buffer_t *buffer, const char *bytes, size_t length) __attribute__ ((no_instrument_function));
+void format_string(format_buffer_t *buffer, const char *string) __attribute__ ((no_instrument_function));
+void format_character(format_buffer_t *buffer, char character) __attribute__ ((no_instrument_function));
+void format_unsigned(format_buffer_t *buffer, uint64_t value) __attribute__ ((no_instrument_function));
+void format_signed(format_buffer_t *buffer, int64_t value) __attribute__ ((no_instrument_function));
+void format_hexadecimal(format_buffer_t *buffer, uint64_t value, int digits) __attribute__ ((no_instrument_function));
+void format_fixed(format_buffer_t *buffer, double value, int decimals) __attribute__ ((no_instrument_function));
+bool format_arithmetic_matches(const format_arithmetic_t *check) __attribute__ ((no_instrument_function));
+bool format_arithmetic(format_buffer_t *buffer, format_verbosity_t verbosity, const format_arithmetic_t *check) __attribute__ ((no_instrument_function));
+bool format_relation(format_buffer_t *buffer, format_verbosity_t verbosity, const format_relation_t *check) __attribute__ ((no_instrument_function));
+const char *format_verbosity_name(format_verbosity_t verbosity) __attribute__ ((no_instrument_function));
+
+#endif //FORMATTER_H
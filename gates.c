@@ -0,0 +1,474 @@
+/**************************************************************************//**
+ *
+ * @file gates.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Gate-level cost model of the ALU's operations.
+ *
+ * Every wire carries its value and its depth, the number of gates on the
+ * longest path from the circuit's inputs to it; inputs and constants have
+ * depth 0. Each gate counts itself and takes the depth of its latest input
+ * plus one, so a design's critical path is the deepest gate it evaluated.
+ * Because the depth follows the actual wires, chained adders overlap the way
+ * they would in hardware: a second ripple-carry adder's low bits do not wait
+ * for the first adder's carry to reach its top bit.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <string.h>
+#include "gates.h"
+
+#define WORD_BITS       32      // the width of alu.c's ripple-carry adder and of the barrel shifter's word
+#define SHIFT_BITS      4       // the bits of a shift amount that the barrel shifter uses
+
+typedef struct {
+    bool value;
+    uint32_t depth;
+} wire_t;
+
+typedef struct {
+    wire_t result[ALU_WIDTH];
+    wire_t supplemental_result[ALU_WIDTH];
+    wire_t unsigned_overflow;
+    wire_t signed_overflow;
+    wire_t divide_by_zero;
+} result_wires_t;
+
+static wire_t gate(gate_cost_t *cost, gate_kind_t kind, bool value, uint32_t input_depth) __attribute__ ((no_instrument_function));
+static uint32_t later(uint32_t depth1, uint32_t depth2) __attribute__ ((no_instrument_function));
+static wire_t and_gate(gate_cost_t *cost, wire_t a, wire_t b) __attribute__ ((no_instrument_function));
+static wire_t or_gate(gate_cost_t *cost, wire_t a, wire_t b) __attribute__ ((no_instrument_function));
+static wire_t xor_gate(gate_cost_t *cost, wire_t a, wire_t b) __attribute__ ((no_instrument_function));
+static wire_t not_gate(gate_cost_t *cost, wire_t a) __attribute__ ((no_instrument_function));
+static wire_t mux_gate(gate_cost_t *cost, wire_t select, wire_t when_clear, wire_t when_set) __attribute__ ((no_instrument_function));
+static wire_t or_tree(gate_cost_t *cost, const wire_t *wires, int count) __attribute__ ((no_instrument_function));
+static void input_word(wire_t *wires, uint32_t value, int width) __attribute__ ((no_instrument_function));
+static uint32_t word_value(const wire_t *wires, int width) __attribute__ ((no_instrument_function));
+static wire_t full_adder(gate_cost_t *cost, wire_t a, wire_t b, wire_t c_in, wire_t *c_out) __attribute__ ((no_instrument_function));
+static wire_t ripple_carry_adder(gate_cost_t *cost, const wire_t *a, const wire_t *b, wire_t carry, wire_t *sum, int width) __attribute__ ((no_instrument_function));
+static wire_t signed_overflow(gate_cost_t *cost, wire_t first_sign, wire_t second_sign, wire_t result_sign) __attribute__ ((no_instrument_function));
+static void ripple_add_subtract(gate_cost_t *cost, uint16_t operand1, uint16_t operand2, bool subtraction, result_wires_t *output) __attribute__ ((no_instrument_function));
+static void kogge_stone_add(gate_cost_t *cost, uint16_t augend, uint16_t addend, result_wires_t *output) __attribute__ ((no_instrument_function));
+static void compare_flags(gate_cost_t *cost, uint16_t value1, uint16_t value2, result_wires_t *output) __attribute__ ((no_instrument_function));
+static void barrel_shifter(gate_cost_t *cost, const wire_t *value, const wire_t *amount, alu_shift_t operation, result_wires_t *output) __attribute__ ((no_instrument_function));
+static void shift_and_add_multiply(gate_cost_t *cost, uint16_t multiplicand, uint16_t multiplier, result_wires_t *output) __attribute__ ((no_instrument_function));
+static void array_multiply(gate_cost_t *cost, uint16_t multiplicand, uint16_t multiplier, result_wires_t *output) __attribute__ ((no_instrument_function));
+static void power_of_two_divide(gate_cost_t *cost, uint16_t dividend, uint16_t divisor, result_wires_t *output) __attribute__ ((no_instrument_function));
+
+static const wire_t constant_zero = {false, 0};
+static const wire_t constant_one = {true, 0};
+
+static wire_t gate(gate_cost_t *cost, gate_kind_t kind, bool value, uint32_t input_depth) {
+    wire_t output = {value, input_depth + 1};
+    cost->gates[kind]++;
+    if (output.depth > cost->depth) {
+        cost->depth = output.depth;
+    }
+    return output;
+}
+
+static uint32_t later(uint32_t depth1, uint32_t depth2) {
+    return depth1 > depth2 ? depth1 : depth2;
+}
+
+static wire_t and_gate(gate_cost_t *cost, wire_t a, wire_t b) {
+    return gate(cost, GATE_AND, a.value && b.value, later(a.depth, b.depth));
+}
+
+static wire_t or_gate(gate_cost_t *cost, wire_t a, wire_t b) {
+    return gate(cost, GATE_OR, a.value || b.value, later(a.depth, b.depth));
+}
+
+static wire_t xor_gate(gate_cost_t *cost, wire_t a, wire_t b) {
+    return gate(cost, GATE_XOR, a.value != b.value, later(a.depth, b.depth));
+}
+
+static wire_t not_gate(gate_cost_t *cost, wire_t a) {
+    return gate(cost, GATE_NOT, !a.value, a.depth);
+}
+
+static wire_t mux_gate(gate_cost_t *cost, wire_t select, wire_t when_clear, wire_t when_set) {
+    return gate(cost, GATE_MUX, select.value ? when_set.value : when_clear.value,
+                later(select.depth, later(when_clear.depth, when_set.depth)));
+}
+
+/* ORs the wires together in a balanced tree, so that the depth grows with the logarithm of the count */
+static wire_t or_tree(gate_cost_t *cost, const wire_t *wires, int count) {
+    wire_t level[WORD_BITS];
+    memcpy(level, wires, (size_t) count * sizeof(wire_t));
+    while (count > 1) {
+        int half = count / 2;
+        for (int i = 0; i < half; i++) {
+            level[i] = or_gate(cost, level[2 * i], level[2 * i + 1]);
+        }
+        if (count % 2) {
+            level[half] = level[count - 1];
+        }
+        count = half + count % 2;
+    }
+    return level[0];
+}
+
+static void input_word(wire_t *wires, uint32_t value, int width) {
+    for (int i = 0; i < width; i++) {
+        wires[i] = (wire_t) {(value >> i) & 0x1, 0};
+    }
+}
+
+static uint32_t word_value(const wire_t *wires, int width) {
+    uint32_t value = 0;
+    for (int i = 0; i < width; i++) {
+        value |= (uint32_t) wires[i].value << i;
+    }
+    return value;
+}
+
+/* the equations of one_bit_full_addition: two XORs for the sum, and three ANDs and two ORs for the carry */
+static wire_t full_adder(gate_cost_t *cost, wire_t a, wire_t b, wire_t c_in, wire_t *c_out) {
+    wire_t sum = xor_gate(cost, xor_gate(cost, a, b), c_in);
+    *c_out = or_gate(cost, or_gate(cost, and_gate(cost, a, b), and_gate(cost, b, c_in)), and_gate(cost, a, c_in));
+    return sum;
+}
+
+static wire_t ripple_carry_adder(gate_cost_t *cost, const wire_t *a, const wire_t *b, wire_t carry, wire_t *sum, int width) {
+    for (int i = 0; i < width; i++) {
+        sum[i] = full_adder(cost, a[i], b[i], carry, &carry);
+    }
+    return carry;
+}
+
+/* the equation of lazy_signed_overflow: the adder's inputs have the same sign and the result's sign differs */
+static wire_t signed_overflow(gate_cost_t *cost, wire_t first_sign, wire_t second_sign, wire_t result_sign) {
+    return and_gate(cost, not_gate(cost, xor_gate(cost, first_sign, second_sign)),
+                    xor_gate(cost, first_sign, result_sign));
+}
+
+/* add and subtract: 16-bit operands through ripple_carry_addition's 32 full adders, then evaluate_lazy_flags */
+static void ripple_add_subtract(gate_cost_t *cost, uint16_t operand1, uint16_t operand2, bool subtraction,
+                                result_wires_t *output) {
+    wire_t first[WORD_BITS], second[WORD_BITS], sum[WORD_BITS];
+    input_word(first, operand1, WORD_BITS);
+    input_word(second, operand2, WORD_BITS);
+    if (subtraction) {
+        // a - b == a + ~b + 1; only the 16-bit subtrahend is complemented, so the upper half stays zero
+        for (int i = 0; i < ALU_WIDTH; i++) {
+            second[i] = not_gate(cost, second[i]);
+        }
+    }
+    ripple_carry_adder(cost, first, second, subtraction ? constant_one : constant_zero, sum, WORD_BITS);
+    memcpy(output->result, sum, sizeof(output->result));
+    // the 17th sum bit is the carry out of the 16-bit sum; a subtraction's borrow is its complement
+    output->unsigned_overflow = subtraction ? not_gate(cost, sum[ALU_WIDTH]) : sum[ALU_WIDTH];
+    output->signed_overflow = signed_overflow(cost, first[ALU_SIGN_BIT], second[ALU_SIGN_BIT], sum[ALU_SIGN_BIT]);
+}
+
+/* a 16-bit parallel-prefix adder: lg(16) levels of generate/propagate combining instead of a 16-stage carry chain */
+static void kogge_stone_add(gate_cost_t *cost, uint16_t augend, uint16_t addend, result_wires_t *output) {
+    wire_t a[ALU_WIDTH], b[ALU_WIDTH], propagate[ALU_WIDTH], generate[ALU_WIDTH];
+    wire_t group_propagate[ALU_WIDTH], group_generate[ALU_WIDTH];
+    input_word(a, augend, ALU_WIDTH);
+    input_word(b, addend, ALU_WIDTH);
+    for (int i = 0; i < ALU_WIDTH; i++) {
+        generate[i] = and_gate(cost, a[i], b[i]);
+        propagate[i] = xor_gate(cost, a[i], b[i]);
+    }
+    memcpy(group_generate, generate, sizeof(generate));
+    memcpy(group_propagate, propagate, sizeof(propagate));
+    for (int distance = 1; distance < ALU_WIDTH; distance *= 2) {
+        wire_t next_generate[ALU_WIDTH], next_propagate[ALU_WIDTH];
+        memcpy(next_generate, group_generate, sizeof(group_generate));
+        memcpy(next_propagate, group_propagate, sizeof(group_propagate));
+        for (int i = distance; i < ALU_WIDTH; i++) {
+            next_generate[i] = or_gate(cost, group_generate[i],
+                                       and_gate(cost, group_propagate[i], group_generate[i - distance]));
+            // the last level's group-propagate signals would go unused
+            if (distance * 2 < ALU_WIDTH) {
+                next_propagate[i] = and_gate(cost, group_propagate[i], group_propagate[i - distance]);
+            }
+        }
+        memcpy(group_generate, next_generate, sizeof(next_generate));
+        memcpy(group_propagate, next_propagate, sizeof(next_propagate));
+    }
+    output->result[0] = propagate[0];
+    for (int i = 1; i < ALU_WIDTH; i++) {
+        output->result[i] = xor_gate(cost, propagate[i], group_generate[i - 1]);
+    }
+    output->unsigned_overflow = group_generate[ALU_SIGN_BIT];
+    output->signed_overflow = signed_overflow(cost, a[ALU_SIGN_BIT], b[ALU_SIGN_BIT], output->result[ALU_SIGN_BIT]);
+}
+
+/* compare: the subtraction, a NOR of the difference's bits for the zero flag, and the flags packed as compare() does */
+static void compare_flags(gate_cost_t *cost, uint16_t value1, uint16_t value2, result_wires_t *output) {
+    result_wires_t difference = {};
+    ripple_add_subtract(cost, value1, value2, true, &difference);
+    wire_t flags[ALU_WIDTH];
+    for (int i = 0; i < ALU_WIDTH; i++) {
+        flags[i] = constant_zero;
+    }
+    flags[0] = not_gate(cost, or_tree(cost, difference.result, ALU_WIDTH));    // ALU_ZERO_FLAG
+    flags[1] = difference.result[ALU_SIGN_BIT];                                 // ALU_SIGN_FLAG
+    flags[2] = difference.signed_overflow;                                      // ALU_OVERFLOW_FLAG
+    flags[3] = difference.unsigned_overflow;                                    // ALU_CARRY_FLAG
+    memcpy(output->result, flags, sizeof(flags));
+}
+
+/* barrel_shift: four stages of 32 multiplexers for the word and four for the lost-bit mask, then the flags */
+static void barrel_shifter(gate_cost_t *cost, const wire_t *value, const wire_t *amount, alu_shift_t operation,
+                           result_wires_t *output) {
+    bool right = (operation == ALU_SHIFT_RIGHT) || (operation == ALU_SHIFT_RIGHT_ARITHMETIC)
+                 || (operation == ALU_ROTATE_RIGHT);
+    bool rotate = (operation == ALU_ROTATE_LEFT) || (operation == ALU_ROTATE_RIGHT);
+    wire_t fill = (operation == ALU_SHIFT_RIGHT_ARITHMETIC) ? value[ALU_SIGN_BIT] : constant_zero;
+    wire_t word[WORD_BITS], lost_bits[WORD_BITS];
+    for (int i = 0; i < ALU_WIDTH; i++) {
+        word[i] = (rotate || !right) ? value[i] : constant_zero;
+        word[i + ALU_WIDTH] = (rotate || right) ? value[i] : constant_zero;
+        lost_bits[i] = constant_one;
+        lost_bits[i + ALU_WIDTH] = constant_zero;
+    }
+    for (int stage = 0; stage < SHIFT_BITS; stage++) {
+        int distance = 1 << stage;
+        wire_t next_word[WORD_BITS], next_lost_bits[WORD_BITS];
+        for (int i = 0; i < WORD_BITS; i++) {
+            wire_t shifted;
+            if (right) {
+                shifted = (i + distance < WORD_BITS) ? word[i + distance] : fill;
+            } else {
+                shifted = (i >= distance) ? word[i - distance] : constant_zero;
+            }
+            next_word[i] = mux_gate(cost, amount[stage], word[i], shifted);
+            next_lost_bits[i] = mux_gate(cost, amount[stage], lost_bits[i],
+                                         (i >= distance) ? lost_bits[i - distance] : constant_zero);
+        }
+        memcpy(word, next_word, sizeof(word));
+        memcpy(lost_bits, next_lost_bits, sizeof(lost_bits));
+    }
+    const wire_t *upper = word + ALU_WIDTH;
+    const wire_t *lower = word;
+    if (operation == ALU_SHIFT_LEFT) {
+        wire_t differences[ALU_WIDTH];
+        memcpy(output->result, lower, sizeof(output->result));
+        memcpy(output->supplemental_result, upper, sizeof(output->supplemental_result));
+        output->unsigned_overflow = upper[0];
+        // every bit shifted out should be a copy of the result's sign bit
+        for (int i = 0; i < ALU_WIDTH; i++) {
+            wire_t expected = and_gate(cost, lower[ALU_SIGN_BIT], lost_bits[i + ALU_WIDTH]);
+            differences[i] = xor_gate(cost, upper[i], expected);
+        }
+        output->signed_overflow = or_tree(cost, differences, ALU_WIDTH);
+    } else if (!rotate) {
+        memcpy(output->result, upper, sizeof(output->result));
+        memcpy(output->supplemental_result, lower, sizeof(output->supplemental_result));
+        output->unsigned_overflow = lower[ALU_SIGN_BIT];
+    } else {
+        const wire_t *rotated = right ? lower : upper;
+        memcpy(output->result, rotated, sizeof(output->result));
+        output->unsigned_overflow = and_gate(cost, or_tree(cost, amount, SHIFT_BITS),
+                                             right ? rotated[ALU_SIGN_BIT] : rotated[0]);
+    }
+}
+
+/* unsigned_multiply: one 32-bit ripple-carry addition for each set multiplier bit up to the most significant one */
+static void shift_and_add_multiply(gate_cost_t *cost, uint16_t multiplicand, uint16_t multiplier,
+                                   result_wires_t *output) {
+    wire_t product[WORD_BITS], partial_product[WORD_BITS], multiplicand_wires[ALU_WIDTH];
+    input_word(product, 0, WORD_BITS);
+    input_word(multiplicand_wires, multiplicand, ALU_WIDTH);
+    for (int bit = 0; (multiplier >> bit) != 0; bit++) {
+        if ((multiplier >> bit) & 0x1) {
+            // shifting the partial product into place is wiring
+            for (int i = 0; i < WORD_BITS; i++) {
+                partial_product[i] = (i >= bit && i < bit + ALU_WIDTH) ? multiplicand_wires[i - bit] : constant_zero;
+            }
+            ripple_carry_adder(cost, product, partial_product, constant_zero, product, WORD_BITS);
+        }
+    }
+    memcpy(output->result, product, sizeof(output->result));
+    memcpy(output->supplemental_result, product + ALU_WIDTH, sizeof(output->supplemental_result));
+}
+
+/* an array of 256 AND gates for the partial products, rows of carry-save adders, and one 32-bit ripple-carry adder */
+static void array_multiply(gate_cost_t *cost, uint16_t multiplicand, uint16_t multiplier, result_wires_t *output) {
+    wire_t a[ALU_WIDTH], b[ALU_WIDTH], sum[WORD_BITS], carry[WORD_BITS], product[WORD_BITS];
+    input_word(a, multiplicand, ALU_WIDTH);
+    input_word(b, multiplier, ALU_WIDTH);
+    input_word(sum, 0, WORD_BITS);
+    input_word(carry, 0, WORD_BITS);
+    for (int row = 0; row < ALU_WIDTH; row++) {
+        wire_t partial_product[ALU_WIDTH];
+        for (int i = 0; i < ALU_WIDTH; i++) {
+            partial_product[i] = and_gate(cost, a[i], b[row]);
+        }
+        if (row == 0) {
+            memcpy(sum, partial_product, sizeof(partial_product));
+        } else {
+            // each row's full adders absorb the row into the sum and carry vectors without propagating carries
+            wire_t next_carry[WORD_BITS];
+            memcpy(next_carry, carry, sizeof(carry));
+            next_carry[row] = constant_zero;
+            for (int i = row; i <= row + ALU_WIDTH && i < WORD_BITS; i++) {
+                wire_t row_bit = (i < row + ALU_WIDTH) ? partial_product[i - row] : constant_zero;
+                wire_t carry_out;
+                sum[i] = full_adder(cost, row_bit, sum[i], carry[i], &carry_out);
+                if (i + 1 < WORD_BITS) {
+                    next_carry[i + 1] = carry_out;
+                }
+            }
+            memcpy(carry, next_carry, sizeof(carry));
+        }
+    }
+    ripple_carry_adder(cost, sum, carry, constant_zero, product, WORD_BITS);
+    memcpy(output->result, product, sizeof(output->result));
+    memcpy(output->supplemental_result, product + ALU_WIDTH, sizeof(output->supplemental_result));
+}
+
+/* unsigned_divide: lg as a one-hot-to-binary encoder, a right shift, a left shift back, and XORs for the remainder */
+static void power_of_two_divide(gate_cost_t *cost, uint16_t dividend, uint16_t divisor, result_wires_t *output) {
+    wire_t dividend_wires[ALU_WIDTH], divisor_wires[ALU_WIDTH], places[SHIFT_BITS];
+    input_word(dividend_wires, dividend, ALU_WIDTH);
+    input_word(divisor_wires, divisor, ALU_WIDTH);
+    for (int bit = 0; bit < SHIFT_BITS; bit++) {
+        wire_t contributors[ALU_WIDTH];
+        int count = 0;
+        for (int i = 0; i < ALU_WIDTH; i++) {
+            if ((i >> bit) & 0x1) {
+                contributors[count++] = divisor_wires[i];
+            }
+        }
+        places[bit] = or_tree(cost, contributors, count);
+    }
+    result_wires_t quotient = {}, shifted_back = {};
+    barrel_shifter(cost, dividend_wires, places, ALU_SHIFT_RIGHT, &quotient);
+    barrel_shifter(cost, quotient.result, places, ALU_SHIFT_LEFT, &shifted_back);
+    memcpy(output->result, quotient.result, sizeof(output->result));
+    for (int i = 0; i < ALU_WIDTH; i++) {
+        output->supplemental_result[i] = xor_gate(cost, dividend_wires[i], shifted_back.result[i]);
+    }
+    output->divide_by_zero = not_gate(cost, or_tree(cost, divisor_wires, ALU_WIDTH));
+}
+
+/**
+ * Evaluates an ALU operation as a netlist of primitive gates, counting the gates and finding the critical path.
+ * @param design the operation, and the circuit that implements it
+ * @param operand1 the first operand
+ * @param operand2 the second operand; the shift amount for <code>GATE_DESIGN_SHIFT_LEFT</code>
+ * @param cost where the gate counts and the depth of the longest chain of gates are written
+ * @return the circuit's outputs, which should match <code>gate_expected</code>
+ */
+alu_result_t gate_evaluate(gate_design_t design, uint16_t operand1, uint16_t operand2, gate_cost_t *cost) {
+    result_wires_t output;
+    wire_t first[ALU_WIDTH], second[ALU_WIDTH];
+    alu_result_t result = {};
+    memset(cost, 0, sizeof(gate_cost_t));
+    for (int i = 0; i < ALU_WIDTH; i++) {
+        output.result[i] = constant_zero;
+        output.supplemental_result[i] = constant_zero;
+    }
+    output.unsigned_overflow = output.signed_overflow = output.divide_by_zero = constant_zero;
+    switch (design) {
+        case GATE_DESIGN_ADD:
+            ripple_add_subtract(cost, operand1, operand2, false, &output);
+            break;
+        case GATE_DESIGN_KOGGE_STONE_ADD:
+            kogge_stone_add(cost, operand1, operand2, &output);
+            break;
+        case GATE_DESIGN_SUBTRACT:
+            ripple_add_subtract(cost, operand1, operand2, true, &output);
+            break;
+        case GATE_DESIGN_COMPARE:
+            compare_flags(cost, operand1, operand2, &output);
+            break;
+        case GATE_DESIGN_UNSIGNED_MULTIPLY:
+            shift_and_add_multiply(cost, operand1, operand2, &output);
+            break;
+        case GATE_DESIGN_ARRAY_MULTIPLY:
+            array_multiply(cost, operand1, operand2, &output);
+            break;
+        case GATE_DESIGN_UNSIGNED_DIVIDE:
+            power_of_two_divide(cost, operand1, operand2, &output);
+            break;
+        case GATE_DESIGN_SHIFT_LEFT:
+            input_word(first, operand1, ALU_WIDTH);
+            input_word(second, operand2, ALU_WIDTH);
+            barrel_shifter(cost, first, second, ALU_SHIFT_LEFT, &output);
+            break;
+        default:
+            break;
+    }
+    result.result = (uint16_t) word_value(output.result, ALU_WIDTH);
+    result.supplemental_result = (uint16_t) word_value(output.supplemental_result, ALU_WIDTH);
+    result.unsigned_overflow = output.unsigned_overflow.value;
+    result.signed_overflow = output.signed_overflow.value;
+    result.divide_by_zero = output.divide_by_zero.value;
+    return result;
+}
+
+/**
+ * Performs the ALU operation that a design models, to check the design's outputs.
+ * @param design the operation
+ * @param operand1 the first operand
+ * @param operand2 the second operand
+ * @return the ALU's result, with <code>compare</code>'s flags placed in the <code>result</code> field
+ */
+alu_result_t gate_expected(gate_design_t design, uint16_t operand1, uint16_t operand2) {
+    alu_result_t expected = {};
+    switch (design) {
+        case GATE_DESIGN_ADD:
+        case GATE_DESIGN_KOGGE_STONE_ADD:
+            return add(operand1, operand2);
+        case GATE_DESIGN_SUBTRACT:
+            return subtract(operand1, operand2);
+        case GATE_DESIGN_COMPARE:
+            expected.result = compare(operand1, operand2);
+            return expected;
+        case GATE_DESIGN_UNSIGNED_MULTIPLY:
+        case GATE_DESIGN_ARRAY_MULTIPLY:
+            return unsigned_multiply(operand1, operand2);
+        case GATE_DESIGN_UNSIGNED_DIVIDE:
+            return unsigned_divide(operand1, operand2);
+        case GATE_DESIGN_SHIFT_LEFT:
+            return barrel_shift(operand1, (uint8_t) operand2, ALU_SHIFT_LEFT);
+        default:
+            return expected;
+    }
+}
+
+/**
+ * Totals the gates of every kind.
+ * @param cost the gate counts
+ * @return the number of gates evaluated
+ */
+uint32_t gate_total(const gate_cost_t *cost) {
+    uint32_t total = 0;
+    for (int kind = 0; kind < NUMBER_OF_GATE_KINDS; kind++) {
+        total += cost->gates[kind];
+    }
+    return total;
+}
+
+/**
+ * Names a design, as the driver and benchmarks spell it.
+ * @param design the design
+ * @return the design's name
+ */
+const char *gate_design_name(gate_design_t design) {
+    static const char *names[] = {"add", "kogge-stone-add", "subtract", "compare", "unsigned_multiply",
+                                  "array-multiply", "unsigned_divide", "shift-left"};
+    return (design < NUMBER_OF_GATE_DESIGNS) ? names[design] : "unknown";
+}
+
+/**
+ * Names a kind of gate.
+ * @param kind the kind of gate
+ * @return the gate's name
+ */
+const char *gate_kind_name(gate_kind_t kind) {
+    static const char *names[] = {"AND", "OR", "XOR", "NOT", "MUX"};
+    return (kind < NUMBER_OF_GATE_KINDS) ? names[kind] : "unknown";
+}
@@ -0,0 +1,64 @@
+/**************************************************************************//**
+ *
+ * @file gates.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for the gate-level cost
+ *      model, which counts the primitive gates that each ALU operation
+ *      evaluates and the depth of its longest chain of gates.
+ *
+ * Each design is a netlist of AND, OR, XOR, NOT, and two-input MUX gates that
+ * follows the corresponding function in alu.c: the same full-adder equations,
+ * the same 32-bit ripple-carry adder under the 16-bit operations, and the
+ * same data-dependent loop in the shift-and-add multiplier. Wiring, constant
+ * inputs, and the C code's control decisions cost nothing. Two designs that
+ * alu.c does not use, a Kogge-Stone adder and a carry-save array multiplier,
+ * are there for comparison.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef GATES_H
+#define GATES_H
+
+#include <stdint.h>
+#include "alu_extensions.h"
+
+typedef enum {
+    GATE_AND = 0,
+    GATE_OR,
+    GATE_XOR,
+    GATE_NOT,
+    GATE_MUX,
+    NUMBER_OF_GATE_KINDS
+} gate_kind_t;
+
+typedef enum {
+    GATE_DESIGN_ADD = 0,
+    GATE_DESIGN_KOGGE_STONE_ADD,
+    GATE_DESIGN_SUBTRACT,
+    GATE_DESIGN_COMPARE,                // the condition flags are placed in the result field
+    GATE_DESIGN_UNSIGNED_MULTIPLY,
+    GATE_DESIGN_ARRAY_MULTIPLY,
+    GATE_DESIGN_UNSIGNED_DIVIDE,        // the divisor must be a power of two, or zero
+    GATE_DESIGN_SHIFT_LEFT,             // the second operand is the shift amount
+    NUMBER_OF_GATE_DESIGNS
+} gate_design_t;
+
+typedef struct {
+    uint32_t gates[NUMBER_OF_GATE_KINDS];
+    uint32_t depth;                     // the critical path: the longest chain of gates from an input to any gate
+} gate_cost_t;
+
+alu_result_t gate_evaluate(gate_design_t design, uint16_t operand1, uint16_t operand2, gate_cost_t *cost) __attribute__ ((no_instrument_function));
+alu_result_t gate_expected(gate_design_t design, uint16_t operand1, uint16_t operand2);
+uint32_t gate_total(const gate_cost_t *cost) __attribute__ ((no_instrument_function));
+const char *gate_design_name(gate_design_t design) __attribute__ ((no_instrument_function));
+const char *gate_kind_name(gate_kind_t kind) __attribute__ ((no_instrument_function));
+
+#endif //GATES_H
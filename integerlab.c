@@ -24,11 +24,26 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <math.h>
-#include "alu.h"
+#include "alu_extensions.h"
 #include "authoritative_results.h"
 #include "profiler.h"
+#include "benchmark.h"
+#include "swar.h"
+#include "alu_width.h"
+#include "expression.h"
+#include "cpu.h"
+#include "trace.h"
+#include "sampler.h"
+#include "server.h"
+#include "pipeline.h"
+#include "formatter.h"
+#include "alu_shift.h"
+#include "gates.h"
+#include "float16.h"
+#include "q15.h"
 
 bool read_evaluate_print() __attribute__ ((no_instrument_function));
 char *parse_operand(const char *buffer, uint32_t *operand) __attribute__ ((no_instrument_function));
@@ -36,9 +51,31 @@ char *parse_operator(const char *buffer, char *operator) __attribute__ ((no_inst
 void evaluate_print_one_bit_adder(const char *input_buffer) __attribute__ ((no_instrument_function));
 void evaluate_print_thirty_two_bit_adder(const char *input_buffer) __attribute__ ((no_instrument_function));
 void evaluate_print_power_of_two_multiplier(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_shift(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_gates(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_float16(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_q15(const char *input_buffer) __attribute__ ((no_instrument_function));
 void evaluate_print_arithmetic(uint16_t operand1, char operator, uint16_t operand2) __attribute__ ((no_instrument_function));
+void evaluate_print_comparison(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_swar(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_width(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_assignment(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_expression(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_cpu(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_trace(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_sample(const char *input_buffer) __attribute__ ((no_instrument_function));
+void evaluate_print_pipeline(const char *input_buffer) __attribute__ ((no_instrument_function));
 
-int main() {
+static uint16_t variable_bindings[EXPRESSION_VARIABLES];
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && !strcmp(argv[1], "--serve")) {
+        if (argc < 3) {
+            fprintf(stderr, "usage: %s --serve socket-path [workers]\n", argv[0]);
+            return 1;
+        }
+        return server_run(argv[2], argc > 3 ? atoi(argv[3]) : 0);
+    }
     bool running = true;
     while (running) {
         running = read_evaluate_print();
@@ -118,138 +155,587 @@ void evaluate_print_power_of_two_multiplier(const char *input_buffer) {
     printf("actual:   0x%04X * 0x%04X = 0x%08X\n", operand1, operand2, actual_result);
 }
 
+void evaluate_print_shift(const char *input_buffer) {
+    char name[16] = "";
+    uint16_t value = 0;
+    unsigned int amount = 0;
+    alu_shift_t operation = ALU_SHIFT_LEFT;
+    sscanf(input_buffer + 5, "%15s %hx %u", name, &value, &amount); // NOLINT(*-err34-c)
+    while (operation <= ALU_ROTATE_RIGHT && strcmp(name, barrel_shift_name(operation))) {
+        operation++;
+    }
+    if (operation > ALU_ROTATE_RIGHT) {
+        printf("Unknown shift: %s (use left, right, arithmetic, rotl, or rotr)\n", name);
+        return;
+    }
+    if (amount >= ALU_WIDTH) {
+        printf("[WARNING] %u is more than %d places; only the low four bits of the amount are used\n",
+               amount, ALU_WIDTH - 1);
+    }
+    alu_result_t expected = host_shift(value, (uint8_t) amount, operation);
+    alu_result_t actual = barrel_shift(value, (uint8_t) amount, operation);
+    printf("expected: %s 0x%04X by %u = 0x%04X    shifted out: 0x%04X    carry: %d    signed overflow: %d\n",
+           name, value, amount, expected.result, expected.supplemental_result,
+           expected.unsigned_overflow, expected.signed_overflow);
+    printf("actual:   %s 0x%04X by %u = 0x%04X    shifted out: 0x%04X    carry: %d    signed overflow: %d\n",
+           name, value, amount, actual.result, actual.supplemental_result,
+           actual.unsigned_overflow, actual.signed_overflow);
+}
+
+void evaluate_print_gates(const char *input_buffer) {
+    uint32_t operand;
+    char *next = parse_operand(input_buffer + 5, &operand);
+    uint16_t operand1 = (uint16_t) operand;
+    parse_operand(next, &operand);
+    uint16_t operand2 = (uint16_t) operand;
+    printf("GATE-LEVEL COST OF 0x%04X, 0x%04X (the shift amount is the second operand's low four bits)\n",
+           operand1, operand2);
+    printf("\t%-18s %-23s", "design", "result");
+    for (gate_kind_t kind = GATE_AND; kind < NUMBER_OF_GATE_KINDS; kind++) {
+        printf(" %6s", gate_kind_name(kind));
+    }
+    printf(" %7s %6s\n", "total", "depth");
+    for (gate_design_t design = GATE_DESIGN_ADD; design < NUMBER_OF_GATE_DESIGNS; design++) {
+        gate_cost_t cost;
+        alu_result_t actual = gate_evaluate(design, operand1, operand2, &cost);
+        alu_result_t expected = gate_expected(design, operand1, operand2);
+        bool matches = actual.result == expected.result
+                       && actual.supplemental_result == expected.supplemental_result
+                       && actual.unsigned_overflow == expected.unsigned_overflow
+                       && actual.signed_overflow == expected.signed_overflow
+                       && actual.divide_by_zero == expected.divide_by_zero;
+        char result[32];
+        snprintf(result, sizeof(result), "0x%04X'%04X %s", actual.supplemental_result, actual.result,
+                 matches ? "(matches)" : "(DIFFERS)");
+        printf("\t%-18s %-23s", gate_design_name(design), result);
+        for (gate_kind_t kind = GATE_AND; kind < NUMBER_OF_GATE_KINDS; kind++) {
+            printf(" %6u", cost.gates[kind]);
+        }
+        printf(" %7u %6u\n", gate_total(&cost), cost.depth);
+    }
+    if (operand2 && __builtin_popcount(operand2) != 1) {
+        printf("[WARNING] 0x%04X is not a power of two; unsigned_divide's circuit only handles powers of two\n",
+               operand2);
+    }
+}
+
+void evaluate_print_float16(const char *input_buffer) {
+    char first[16] = "", second[16] = "";
+    unsigned int value1 = 0, value2 = 1;
+    int fields = sscanf(input_buffer + 7, "%15s %15s %x %x", first, second, &value1, &value2); // NOLINT(*-err34-c)
+    bool checking = !strcmp(first, "check");
+    float16_format_t format = FLOAT16_BINARY16;
+    float16_operation_t operation = FLOAT16_ADD;
+    while (format < NUMBER_OF_FLOAT16_FORMATS && strcmp(checking ? second : first, float16_format_name(format))) {
+        format++;
+    }
+    while (!checking && operation < NUMBER_OF_FLOAT16_OPERATIONS
+           && strcmp(second, float16_operation_name(operation))) {
+        operation++;
+    }
+    if (format == NUMBER_OF_FLOAT16_FORMATS || operation == NUMBER_OF_FLOAT16_OPERATIONS
+        || (!checking && fields < 4)) {
+        printf("Use \"float16 <binary16|bfloat16> <add|subtract|multiply|compare> <hex_value1> <hex_value2>\"\n"
+               "    or \"float16 check <binary16|bfloat16> [second-operand stride, in hex]\".\n");
+        return;
+    }
+    if (!checking) {
+        static const char *relations[] = {"less", "equal", "greater", "unordered"};
+        float16_t operand1 = (float16_t) value1, operand2 = (float16_t) value2;
+        float16_t expected = float16_host(format, operation, operand1, operand2);
+        float16_t actual;
+        float16_batch(format, operation, &operand1, &operand2, &actual, 1);
+        printf("%s %s(0x%04X = %g, 0x%04X = %g)\n", float16_format_name(format), float16_operation_name(operation),
+               operand1, float16_to_double(format, operand1), operand2, float16_to_double(format, operand2));
+        if (operation == FLOAT16_COMPARE) {
+            printf("expected: %s\nactual:   %s\n", relations[expected], relations[actual]);
+        } else {
+            printf("expected: 0x%04X = %g\nactual:   0x%04X = %g\n", expected, float16_to_double(format, expected),
+                   actual, float16_to_double(format, actual));
+        }
+        return;
+    }
+    // every first operand against every stride-th second operand, and against the special values; a stride of 1
+    // checks all 2**32 pairs
+    unsigned int stride = fields > 2 && value1 ? value1 : 0x1001;
+    float16_t infinity = float16_from_double(format, INFINITY);
+    float16_t specials[] = {0x8000, 0x0001, 0x8001, infinity, infinity | 0x8000, float16_from_double(format, NAN),
+                            infinity - 1, float16_from_double(format, 1.0), float16_from_double(format, -1.5)};
+    int number_of_specials = sizeof(specials) / sizeof(specials[0]);
+    float16_t *operands1 = malloc((UINT16_MAX + 1) * sizeof(float16_t));
+    float16_t *operands2 = malloc((UINT16_MAX + 1) * sizeof(float16_t));
+    float16_t *results = malloc((UINT16_MAX + 1) * sizeof(float16_t));
+    printf("%s: every first operand against every 0x%X-th second operand and %d special values\n",
+           float16_format_name(format), stride, number_of_specials);
+    for (operation = FLOAT16_ADD; operation < NUMBER_OF_FLOAT16_OPERATIONS; operation++) {
+        uint64_t pairs = 0, mismatches = 0;
+        uint64_t start = benchmark_nanoseconds();
+        for (uint32_t step = 0; step < (UINT16_MAX + stride) / stride + number_of_specials; step++) {
+            uint32_t regular_steps = (UINT16_MAX + stride) / stride;
+            float16_t operand2 = step < regular_steps ? (float16_t) (step * stride) : specials[step - regular_steps];
+            for (uint32_t operand1 = 0; operand1 <= UINT16_MAX; operand1++) {
+                operands1[operand1] = (float16_t) operand1;
+                operands2[operand1] = operand2;
+            }
+            float16_batch(format, operation, operands1, operands2, results, UINT16_MAX + 1);
+            for (uint32_t operand1 = 0; operand1 <= UINT16_MAX; operand1++) {
+                float16_t expected = float16_host(format, operation, operands1[operand1], operand2);
+                bool both_nan = operation != FLOAT16_COMPARE && float16_is_nan(format, expected)
+                                && float16_is_nan(format, results[operand1]);
+                if (expected != results[operand1] && !both_nan) {
+                    if (mismatches < 5) {
+                        printf("\t%s(0x%04X, 0x%04X): expected 0x%04X, actual 0x%04X\n",
+                               float16_operation_name(operation), operand1, operand2, expected, results[operand1]);
+                    }
+                    mismatches++;
+                }
+            }
+            pairs += UINT16_MAX + 1;
+        }
+        double seconds = (double) (benchmark_nanoseconds() - start) / 1e9;
+        printf("\t%-9s %" PRIu64 " pairs, %" PRIu64 " differences (%.1f s)\n", float16_operation_name(operation),
+               pairs, mismatches, seconds);
+    }
+    free(operands1);
+    free(operands2);
+    free(results);
+}
+
+void evaluate_print_q15(const char *input_buffer) {
+    static const char *operations[] = {"add", "subtract", "multiply"};
+    char operation[16] = "";
+    unsigned int value1 = 0, value2 = 0;
+    int fields = sscanf(input_buffer + 3, "%15s %x %x", operation, &value1, &value2); // NOLINT(*-err34-c)
+    int index = 0;
+    while (index < 3 && strcmp(operation, operations[index])) {
+        index++;
+    }
+    if (index == 3 || fields < 3) {
+        printf("Use \"q15 <add|subtract|multiply> <hex_value1> <hex_value2>\".\n");
+        return;
+    }
+    q15_t operand1 = (q15_t) value1, operand2 = (q15_t) value2;
+    double first = q15_to_double(operand1), second = q15_to_double(operand2);
+    double exact = index == 0 ? first + second : index == 1 ? first - second : first * second;
+    q15_t expected = q15_from_double(exact);
+    q15_t actual = index == 0 ? q15_add(operand1, operand2)
+                              : index == 1 ? q15_subtract(operand1, operand2) : q15_multiply(operand1, operand2);
+    printf("q15 %s(0x%04X = %.6f, 0x%04X = %.6f) == %.10f exactly\n", operations[index], operand1, first, operand2,
+           second, exact);
+    printf("expected: 0x%04X = %.6f\nactual:   0x%04X = %.6f\n", expected, q15_to_double(expected), actual,
+           q15_to_double(actual));
+}
+
 void evaluate_print_arithmetic(uint16_t operand1, char operator, uint16_t operand2) {
+    format_arithmetic_t check = {.operator = operator, .operand1 = operand1, .operand2 = operand2,
+                                 .addition_calls = {-1, -1}, .shift_calls = {-1, -1}};
+    format_buffer_t buffer;
     reset_call_counts();
-    alu_result_t actual_result;
-    struct authoritative_result *expected_result = malloc(sizeof(struct authoritative_result));
     switch (operator) {
         case '+':
         case '-':
             if (operator == '+') {
-                evaluate_addition(operand1, operand2, expected_result);
-                actual_result = add(operand1, operand2);
+                evaluate_addition(operand1, operand2, check.expected);
+                check.actual[0] = traced_add(operand1, operand2);
             } else {
-                evaluate_subtraction(operand1, operand2, expected_result);
-                actual_result = subtract(operand1, operand2);
+                evaluate_subtraction(operand1, operand2, check.expected);
+                check.actual[0] = traced_subtract(operand1, operand2);
             }
-            printf("UNSIGNED %s\n", operator == '+' ? "ADDITION" : "SUBTRACTION");
-            printf("\texpected result (hexadecimal): 0x%04X %c 0x%04X = 0x%04X\n",
-                   operand1, operator, operand2, expected_result->result);
-            printf("\texpected result (unsigned):    %u %c %u = %u\toverflow: %s\n",
-                   operand1, operator, operand2, expected_result->result,
-                   expected_result->c_flag ? "true" : "false");
-            printf("\tactual result (hexadecimal):   0x%04X %c 0x%04X = 0x%04X\n",
-                   operand1, operator, operand2, actual_result.result);
-            printf("\tactual result (unsigned):      %u %c %u = %u\toverflow: %s\n",
-                   operand1, operator, operand2, actual_result.result,
-                   actual_result.unsigned_overflow ? "true" : "false");
-            printf("SIGNED %s\n", operator == '+' ? "ADDITION" : "SUBTRACTION");
-            printf("\texpected result (hexadecimal): 0x%04X %c 0x%04X = 0x%04X\n",
-                   operand1, operator, operand2, expected_result->result);
-            printf("\texpected result (signed):      %d %c %d = %d\toverflow: %s\n",
-                   (int16_t) operand1, operator, (int16_t) operand2, (int16_t) expected_result->result,
-                   expected_result->o_flag ? "true" : "false");
-            printf("\tactual result (hexadecimal):   0x%04X %c 0x%04X = 0x%04X\n",
-                   operand1, operator, operand2, actual_result.result);
-            printf("\tactual result (signed):        %d %c %d = %d\toverflow: %s\n",
-                   (int16_t) operand1, operator, (int16_t) operand2, (int16_t) actual_result.result,
-                   actual_result.signed_overflow ? "true" : "false");
-            printf("\t\tNumber of calls to ripple_carry_addition:    %d\n", get_call_counts(ripple_carry_addition));
+            check.expected[1] = check.expected[0];
+            check.actual[1] = check.actual[0];
+            check.addition_calls[0] = get_call_counts(ripple_carry_addition);
             break;
         case '*':
-            printf("UNSIGNED MULTIPLICATION\n");
-            evaluate_unsigned_multiplication(operand1, operand2, expected_result);
-            actual_result = unsigned_multiply(operand1, operand2);
-            printf("\texpected result (hexadecimal): 0x%04X * 0x%04X = 0x%04X'%04X\n",
-                   operand1, operand2, expected_result->supplemental_result, expected_result->result);
-            printf("\texpected result (unsigned):    %u * %u = %u (%u)\n", operand1, operand2, expected_result->result,
-                   ((uint32_t) expected_result->supplemental_result << 16) | expected_result->result);
-            printf("\tactual result (hexadecimal):   0x%04X * 0x%04X = 0x%04X'%04X\n",
-                   operand1, operand2, actual_result.supplemental_result, actual_result.result);
-            printf("\tactual result (unsigned):      %u * %u = %u (%u)\n", operand1, operand2, actual_result.result,
-                   ((uint32_t) actual_result.supplemental_result << 16) | actual_result.result);
-            printf("SIGNED MULTIPLICATION\n");
-            evaluate_signed_multiplication(operand1, operand2, expected_result);
-            actual_result = signed_multiply(operand1, operand2);
-            printf("\texpected result (hexadecimal): 0x%04X * 0x%04X = 0x%04X'%04X\n",
-                   operand1, operand2, expected_result->supplemental_result, expected_result->result);
-            printf("\texpected result (signed):      %d * %d = %d (%d)\n",
-                   (int16_t) operand1, (int16_t) operand2, (int16_t) expected_result->result,
-                   (int32_t) (((uint32_t) expected_result->supplemental_result << 16) | expected_result->result));
-            printf("\tactual result (hexadecimal):   0x%04X * 0x%04X = 0x%04X'%04X\n",
-                   operand1, operand2, actual_result.supplemental_result, actual_result.result);
-            printf("\tactual result (signed):        %d * %d = %d (%d)\n",
-                   (int16_t) operand1, (int16_t) operand2, (int16_t) actual_result.result,
-                   (int32_t) (((uint32_t) actual_result.supplemental_result << 16) | actual_result.result));
-            printf("\t\tNumber of calls to ripple_carry_addition:    %d\n", get_call_counts(ripple_carry_addition));
-            printf("\t\tNumber of calls to multiply_by_power_of_two: %d\n", get_call_counts(multiply_by_power_of_two));
+            evaluate_unsigned_multiplication(operand1, operand2, check.expected);
+            check.actual[0] = traced_unsigned_multiply(operand1, operand2);
+            evaluate_signed_multiplication(operand1, operand2, check.expected + 1);
+            check.actual[1] = traced_signed_multiply(operand1, operand2);
+            check.addition_calls[0] = get_call_counts(ripple_carry_addition);
+            check.shift_calls[0] = get_call_counts(multiply_by_power_of_two);
             break;
         case '/':
         case '%':
-            if (operand2 > 0 && operand2 != 1 << lg(operand2)) {
-                printf("[NOTE] 0x%04X is not a power-of-two; the assignment only requires division by powers-of-two.\n",
-                       operand2);
+            if (operand2 != 0) {
+                evaluate_unsigned_division(operand1, operand2, check.expected);
+                evaluate_signed_division(operand1, operand2, check.expected + 1);
             }
-            printf("UNSIGNED DIVISION\n");
             reset_call_counts();
-            if (operand2 == 0) {
-                printf("expected result: divide-by-zero\n");
-            } else {
-                evaluate_unsigned_division(operand1, operand2, expected_result);
-                printf("\texpected result (hexadecimal): 0x%04X / 0x%04X = 0x%04X    0x%04X %% 0x%04X = 0x%04X\n",
-                       operand1, operand2, expected_result->result,
-                       operand1, operand2, expected_result->supplemental_result);
-                printf("\texpected result (unsigned):    %u / %u = %u    %u %% %u = %u\n",
-                       operand1, operand2, expected_result->result,
-                       operand1, operand2, expected_result->supplemental_result);
-            }
-            actual_result = unsigned_divide(operand1, operand2);
-            if (actual_result.divide_by_zero) {
-                printf("actual result:   divide-by-zero\n");
-            } else {
-                printf("\tactual result (hexadecimal):   0x%04X / 0x%04X = 0x%04X    0x%04X %% 0x%04X = 0x%04X\n",
-                       operand1, operand2, actual_result.result,
-                       operand1, operand2, actual_result.supplemental_result);
-                printf("\tactual result (unsigned):      %u / %u = %u    %u %% %u = %u\n",
-                       operand1, operand2, actual_result.result,
-                       operand1, operand2, actual_result.supplemental_result);
-            }
-            printf("\t\tNumber of calls to ripple_carry_addition:    %d\n", get_call_counts(ripple_carry_addition));
-            printf("\t\tNumber of calls to multiply_by_power_of_two: %d\n", get_call_counts(multiply_by_power_of_two));
-            printf("SIGNED DIVISION\n");
+            check.actual[0] = traced_unsigned_divide(operand1, operand2);
+            check.addition_calls[0] = get_call_counts(ripple_carry_addition);
+            check.shift_calls[0] = get_call_counts(multiply_by_power_of_two);
             reset_call_counts();
-            if (operand2 == 0) {
-                printf("expected result: divide-by-zero\n");
-            } else {
-                evaluate_signed_division(operand1, operand2, expected_result);
-                printf("\texpected result (hexadecimal): 0x%04X / 0x%04X = 0x%04X    0x%04X %% 0x%04X = 0x%04X\n",
-                       operand1, operand2, expected_result->result,
-                       operand1, operand2, expected_result->supplemental_result);
-                printf("\texpected result (signed):      %d / %d = %d    %d %% %d = %d\n",
-                       (int16_t) operand1, (int16_t) operand2, (int16_t) expected_result->result,
-                       (int16_t) operand1, (int16_t) operand2, (int16_t) expected_result->supplemental_result);
-            }
-            actual_result = signed_divide(operand1, operand2);
-            if (actual_result.divide_by_zero) {
-                printf("actual result:   divide-by-zero\n");
-            } else {
-                printf("\tactual result (hexadecimal):   0x%04X / 0x%04X = 0x%04X    0x%04X %% 0x%04X = 0x%04X\n",
-                       operand1, operand2, actual_result.result,
-                       operand1, operand2, actual_result.supplemental_result);
-                printf("\tactual result (signed):        %d / %d = %d    %d %% %d = %d\n",
-                       (int16_t) operand1, (int16_t) operand2, (int16_t) actual_result.result,
-                       (int16_t) operand1, (int16_t) operand2, (int16_t) actual_result.supplemental_result);
-            }
-            printf("\t\tNumber of calls to ripple_carry_addition:    %d\n", get_call_counts(ripple_carry_addition));
-            printf("\t\tNumber of calls to multiply_by_power_of_two: %d\n", get_call_counts(multiply_by_power_of_two));
+            check.actual[1] = traced_signed_divide(operand1, operand2);
+            check.addition_calls[1] = get_call_counts(ripple_carry_addition);
+            check.shift_calls[1] = get_call_counts(multiply_by_power_of_two);
             break;
         default:
             printf("Unknown operator: %c\n", operator);
+            return;
+    }
+    fflush(stdout);
+    format_open(&buffer, stdout, 0);
+    format_arithmetic(&buffer, FORMAT_FULL, &check);
+    format_close(&buffer);
+}
+
+void evaluate_print_comparison(const char *input_buffer) {
+    reset_call_counts();
+    uint32_t operand;
+    char *next = parse_operand(input_buffer + 7, &operand);
+    uint16_t operand1 = (uint16_t) operand;
+    parse_operand(next, &operand);
+    uint16_t operand2 = (uint16_t) operand;
+    struct authoritative_result *expected_result = malloc(sizeof(struct authoritative_result));
+    evaluate_subtraction(operand1, operand2, expected_result);
+    alu_flags_t expected_flags = (alu_flags_t) ((expected_result->z_flag ? ALU_ZERO_FLAG : 0)
+                                                | (expected_result->s_flag ? ALU_SIGN_FLAG : 0)
+                                                | (expected_result->o_flag ? ALU_OVERFLOW_FLAG : 0)
+                                                | (expected_result->c_flag ? ALU_CARRY_FLAG : 0));
+    alu_flags_t actual_flags = compare(operand1, operand2);
+    printf("expected: compare(0x%04X, 0x%04X) -> Z=%d S=%d O=%d C=%d\n", operand1, operand2,
+           flags_equal(expected_flags), is_not_zero(expected_flags & ALU_SIGN_FLAG),
+           is_not_zero(expected_flags & ALU_OVERFLOW_FLAG), is_not_zero(expected_flags & ALU_CARRY_FLAG));
+    printf("actual:   compare(0x%04X, 0x%04X) -> Z=%d S=%d O=%d C=%d\n", operand1, operand2,
+           flags_equal(actual_flags), is_not_zero(actual_flags & ALU_SIGN_FLAG),
+           is_not_zero(actual_flags & ALU_OVERFLOW_FLAG), is_not_zero(actual_flags & ALU_CARRY_FLAG));
+    printf("SIGNED    expected: ==%d !=%d <%d <=%d >=%d >%d\n",
+           (int16_t) operand1 == (int16_t) operand2, (int16_t) operand1 != (int16_t) operand2,
+           (int16_t) operand1 < (int16_t) operand2, (int16_t) operand1 <= (int16_t) operand2,
+           (int16_t) operand1 >= (int16_t) operand2, (int16_t) operand1 > (int16_t) operand2);
+    printf("          actual:   ==%d !=%d <%d <=%d >=%d >%d\n",
+           flags_equal(actual_flags), flags_not_equal(actual_flags),
+           flags_less_than(actual_flags), flags_at_most(actual_flags),
+           flags_at_least(actual_flags), flags_greater_than(actual_flags));
+    printf("UNSIGNED  expected: ==%d !=%d <%d <=%d >=%d >%d\n",
+           operand1 == operand2, operand1 != operand2, operand1 < operand2,
+           operand1 <= operand2, operand1 >= operand2, operand1 > operand2);
+    printf("          actual:   ==%d !=%d <%d <=%d >=%d >%d\n",
+           flags_equal(actual_flags), flags_not_equal(actual_flags),
+           flags_unsigned_less_than(actual_flags), flags_unsigned_at_most(actual_flags),
+           flags_unsigned_at_least(actual_flags), flags_unsigned_greater_than(actual_flags));
+    printf("\t\tNumber of calls to ripple_carry_addition:    %d\n", get_call_counts(ripple_carry_addition));
+    free(expected_result);
+}
+
+void evaluate_print_swar(const char *input_buffer) {
+    uint64_t packed1 = 0, packed2 = 0;
+    uint16_t lanes1[SWAR_LANES], lanes2[SWAR_LANES];
+    uint16_t sums[SWAR_LANES], differences[SWAR_LANES], less_thans[SWAR_LANES], unsigned_less_thans[SWAR_LANES];
+    uint16_t sum_unsigned_overflows[SWAR_LANES], sum_signed_overflows[SWAR_LANES];
+    uint16_t difference_unsigned_overflows[SWAR_LANES], difference_signed_overflows[SWAR_LANES];
+    sscanf(input_buffer + 4, "%" SCNx64 " %" SCNx64, &packed1, &packed2); // NOLINT(cert-err34-c)
+    swar_unpack(packed1, lanes1);
+    swar_unpack(packed2, lanes2);
+    for (int i = 0; i < SWAR_LANES; i++) {
+        alu_result_t sum = add(lanes1[i], lanes2[i]);
+        alu_result_t difference = subtract(lanes1[i], lanes2[i]);
+        sums[i] = sum.result;
+        sum_unsigned_overflows[i] = sum.unsigned_overflow ? 0x8000 : 0;
+        sum_signed_overflows[i] = sum.signed_overflow ? 0x8000 : 0;
+        differences[i] = difference.result;
+        difference_unsigned_overflows[i] = difference.unsigned_overflow ? 0x8000 : 0;
+        difference_signed_overflows[i] = difference.signed_overflow ? 0x8000 : 0;
+        less_thans[i] = less_than(lanes1[i], lanes2[i]) ? 0xFFFF : 0;
+        unsigned_less_thans[i] = unsigned_less_than(lanes1[i], lanes2[i]) ? 0xFFFF : 0;
+    }
+    swar_result_t actual_sum = swar_add(packed1, packed2);
+    swar_result_t actual_difference = swar_subtract(packed1, packed2);
+    printf("SWAR ADDITION\n");
+    printf("\texpected: 0x%016" PRIX64 "    unsigned overflow: 0x%016" PRIX64 "    signed overflow: 0x%016" PRIX64 "\n",
+           swar_pack(sums), swar_pack(sum_unsigned_overflows), swar_pack(sum_signed_overflows));
+    printf("\tactual:   0x%016" PRIX64 "    unsigned overflow: 0x%016" PRIX64 "    signed overflow: 0x%016" PRIX64 "\n",
+           actual_sum.result, actual_sum.unsigned_overflow, actual_sum.signed_overflow);
+    printf("SWAR SUBTRACTION\n");
+    printf("\texpected: 0x%016" PRIX64 "    unsigned overflow: 0x%016" PRIX64 "    signed overflow: 0x%016" PRIX64 "\n",
+           swar_pack(differences), swar_pack(difference_unsigned_overflows), swar_pack(difference_signed_overflows));
+    printf("\tactual:   0x%016" PRIX64 "    unsigned overflow: 0x%016" PRIX64 "    signed overflow: 0x%016" PRIX64 "\n",
+           actual_difference.result, actual_difference.unsigned_overflow, actual_difference.signed_overflow);
+    printf("SWAR COMPARISON\n");
+    printf("\texpected: signed <: 0x%016" PRIX64 "    unsigned <: 0x%016" PRIX64 "\n",
+           swar_pack(less_thans), swar_pack(unsigned_less_thans));
+    printf("\tactual:   signed <: 0x%016" PRIX64 "    unsigned <: 0x%016" PRIX64 "\n",
+           swar_less_than(packed1, packed2), swar_unsigned_less_than(packed1, packed2));
+}
+
+void evaluate_print_width(const char *input_buffer) {
+    char *next;
+    char operator[3];
+    int width = (int) strtol(input_buffer + 3, &next, 10);
+    while (*next == ' ' || *next == '\t') {
+        next++;
+    }
+    uint64_t operand1 = strtoull(next, &next, (strncmp(next, "0x", 2) ? 10 : 16));
+    next = parse_operator(next, operator);
+    while (*next == ' ' || *next == '\t') {
+        next++;
+    }
+    uint64_t operand2 = strtoull(next, &next, (strncmp(next, "0x", 2) ? 10 : 16));
+    if (width != 8 && width != 16 && width != 32 && width != 64) {
+        printf("Width must be 8, 16, 32, or 64.\n");
+        return;
+    }
+    uint64_t mask = width == 64 ? UINT64_MAX : (UINT64_C(1) << width) - 1;
+    uint64_t sign_bit = UINT64_C(1) << (width - 1);
+    operand1 &= mask;
+    operand2 &= mask;
+    alu64_result_t expected = {}, actual = {};
+    switch (operator[0]) {
+        case '+':
+            expected.result = (operand1 + operand2) & mask;
+            expected.unsigned_overflow = expected.result < operand1;
+            expected.signed_overflow = is_not_zero(~(operand1 ^ operand2) & (operand1 ^ expected.result) & sign_bit);
+            break;
+        case '-':
+            expected.result = (operand1 - operand2) & mask;
+            expected.unsigned_overflow = operand1 < operand2;
+            expected.signed_overflow = is_not_zero((operand1 ^ operand2) & (operand1 ^ expected.result) & sign_bit);
+            break;
+        case '*': {
+            unsigned __int128 product = (unsigned __int128) operand1 * operand2;
+            expected.result = (uint64_t) product & mask;
+            expected.supplemental_result = (uint64_t) (product >> width) & mask;
+            break;
+        }
+        case '/':
+        case '%':
+            expected.divide_by_zero = is_zero(operand2);
+            expected.result = operand2 ? operand1 / operand2 : 0;
+            expected.supplemental_result = operand2 ? operand1 % operand2 : 0;
+            break;
+        default:
+            printf("Unknown operator: %s\n", operator);
+            return;
+    }
+#define EVALUATE_WIDTH(WIDTH, UTYPE)                                                                \
+    case WIDTH: {                                                                                   \
+        alu##WIDTH##_result_t result;                                                               \
+        if (operator[0] == '+') {                                                                   \
+            result = alu##WIDTH##_add((UTYPE) operand1, (UTYPE) operand2);                          \
+        } else if (operator[0] == '-') {                                                            \
+            result = alu##WIDTH##_subtract((UTYPE) operand1, (UTYPE) operand2);                     \
+        } else if (operator[0] == '*') {                                                            \
+            result = alu##WIDTH##_unsigned_multiply((UTYPE) operand1, (UTYPE) operand2);            \
+        } else {                                                                                    \
+            result = alu##WIDTH##_unsigned_divide((UTYPE) operand1, (UTYPE) operand2);              \
+        }                                                                                           \
+        actual.result = result.result;                                                              \
+        actual.supplemental_result = result.supplemental_result;                                    \
+        actual.unsigned_overflow = result.unsigned_overflow;                                        \
+        actual.signed_overflow = result.signed_overflow;                                            \
+        actual.divide_by_zero = result.divide_by_zero;                                              \
+        break;                                                                                      \
+    }
+    switch (width) {
+        EVALUATE_WIDTH(8, uint8_t)
+        EVALUATE_WIDTH(16, uint16_t)
+        EVALUATE_WIDTH(32, uint32_t)
+        EVALUATE_WIDTH(64, uint64_t)
+        default:
+            break;
+    }
+#undef EVALUATE_WIDTH
+    int digits = width / 4;
+    printf("%d-BIT UNSIGNED %c\n", width, operator[0]);
+    printf("\texpected: 0x%0*" PRIX64 " %c 0x%0*" PRIX64 " = 0x%0*" PRIX64 "    supplemental: 0x%0*" PRIX64
+           "    unsigned overflow: %s    signed overflow: %s    divide-by-zero: %s\n",
+           digits, operand1, operator[0], digits, operand2, digits, (uint64_t) expected.result,
+           digits, (uint64_t) expected.supplemental_result, expected.unsigned_overflow ? "true" : "false",
+           expected.signed_overflow ? "true" : "false", expected.divide_by_zero ? "true" : "false");
+    printf("\tactual:   0x%0*" PRIX64 " %c 0x%0*" PRIX64 " = 0x%0*" PRIX64 "    supplemental: 0x%0*" PRIX64
+           "    unsigned overflow: %s    signed overflow: %s    divide-by-zero: %s\n",
+           digits, operand1, operator[0], digits, operand2, digits, (uint64_t) actual.result,
+           digits, (uint64_t) actual.supplemental_result, actual.unsigned_overflow ? "true" : "false",
+           actual.signed_overflow ? "true" : "false", actual.divide_by_zero ? "true" : "false");
+}
+
+void evaluate_print_assignment(const char *input_buffer) {
+    char name = '\0';
+    uint32_t value;
+    int consumed = 0;
+    sscanf(input_buffer + 3, " %c = %n", &name, &consumed);
+    if (name < 'a' || name > 'z' || consumed == 0) {
+        printf("Usage: let <variable a-z> = <value>\n");
+        return;
+    }
+    parse_operand(input_buffer + 3 + consumed, &value);
+    variable_bindings[name - 'a'] = (uint16_t) value;
+    printf("%c = 0x%04X (%u, %d)\n", name, (uint16_t) value, (uint16_t) value, (int16_t) value);
+}
+
+void evaluate_print_expression(const char *input_buffer) {
+    bool was_cached;
+    const expression_t *expression = expression_compile_cached(input_buffer + 4, &was_cached);
+    if (expression->error) {
+        printf("Cannot compile \"%s\": %s\n", expression->source, expression->error);
+        return;
+    }
+    uint16_t binding[EXPRESSION_VARIABLES];
+    for (int i = 0; i < expression->number_of_variables; i++) {
+        binding[i] = variable_bindings[expression->variable_names[i] - 'a'];
+        printf("%c = 0x%04X  ", expression->variable_names[i], binding[i]);
+    }
+    printf("\n%s (%d instructions, %s)\n", expression->source, expression->number_of_instructions,
+           was_cached ? "cached" : "compiled");
+    expression_disassemble(expression);
+    uint16_t expected_result;
+    if (expression_evaluate_reference(expression, binding, &expected_result)) {
+        printf("expected: 0x%04X (%u, %d)\n", expected_result, expected_result, (int16_t) expected_result);
+    } else {
+        printf("expected: divide-by-zero\n");
+    }
+    uint16_t actual_result = expression_evaluate(expression, binding);
+    printf("actual:   0x%04X (%u, %d)\n", actual_result, actual_result, (int16_t) actual_result);
+}
+
+void evaluate_print_cpu(const char *input_buffer) {
+    char name[32] = "";
+    sscanf(input_buffer + 3, "%31s", name);
+    for (int i = 0; i < number_of_cpu_workloads; i++) {
+        if (!strcmp(name, cpu_workloads[i].name)) {
+            cpu_t *cpu = malloc(sizeof(cpu_t));
+            char error[80];
+            if (!cpu) {
+                printf("Cannot run %s: not enough memory for the CPU\n", name);
+                return;
+            }
+            if (!cpu_assemble(cpu, cpu_workloads[i].source, error, sizeof(error))) {
+                printf("Cannot assemble %s: %s\n", name, error);
+            } else {
+                reset_call_counts();
+                uint64_t start = benchmark_nanoseconds();
+                cpu_status_t status = cpu_run(cpu, UINT64_MAX);
+                double elapsed = (double) (benchmark_nanoseconds() - start);
+                printf("%s: %s\n", name, cpu_workloads[i].description);
+                printf("\t%s at 0x%04X after %" PRIu64 " instructions (%.3f million instructions per second)\n",
+                       cpu_status_name(status), cpu->program_counter, cpu->instructions_retired,
+                       1000.0 * (double) cpu->instructions_retired / elapsed);
+                for (int r = 0; r < CPU_REGISTERS; r++) {
+                    printf("%sr%-2d = 0x%04X", r % 8 ? "  " : "\t", r, cpu->registers[r]);
+                    printf(r % 8 == 7 ? "\n" : "");
+                }
+                printf("\texpected: halted with the workload's result\n");
+                printf("\tactual:   %s with %s result\n", cpu_status_name(status),
+                       cpu_workloads[i].verify(cpu) ? "the workload's" : "an incorrect");
+                printf("\t\tNumber of calls to ripple_carry_addition:    %d\n",
+                       get_call_counts(ripple_carry_addition));
+            }
+            free(cpu);
+            return;
+        }
+    }
+    printf("Available workloads:\n");
+    for (int i = 0; i < number_of_cpu_workloads; i++) {
+        printf("\t%-12s %s\n", cpu_workloads[i].name, cpu_workloads[i].description);
+    }
+}
+
+void evaluate_print_trace(const char *input_buffer) {
+    char command[8] = "", path[EXPRESSION_SOURCE_LENGTH] = "";
+    sscanf(input_buffer + 5, "%7s %255s", command, path);
+    if (!strcmp(command, "start") && path[0]) {
+        if (trace_start(path)) {
+            printf("Recording ALU calls to %s\n", path);
+        } else {
+            printf("Cannot record to %s (is a trace already being recorded?)\n", path);
+        }
+    } else if (!strcmp(command, "stop")) {
+        printf("Recorded %" PRIu64 " ALU calls\n", trace_stop());
+        if (trace_dropped()) {
+            printf("Dropped %" PRIu64 " ALU calls for want of memory for a trace buffer\n", trace_dropped());
+        }
+    } else if (!strcmp(command, "replay") && path[0]) {
+        trace_replay_report_t report;
+        if (!trace_replay(path, &report)) {
+            printf("Cannot replay %s: %s\n", path, report.error);
+            return;
+        }
+        uint64_t total_mismatches = 0;
+        printf("REPLAY OF %s (%" PRIu64 " calls in %" PRIu64 " bytes, %.2f bytes per call)\n", path, report.records,
+               report.bytes, report.records ? (double) report.bytes / (double) report.records : 0.0);
+        for (int i = 0; i < NUMBER_OF_TRACE_FUNCTIONS; i++) {
+            if (report.calls[i]) {
+                printf("\t%-20s %12" PRIu64 " calls %12" PRIu64 " differences\n", trace_function_name(i),
+                       report.calls[i], report.mismatches[i]);
+            }
+            total_mismatches += report.mismatches[i];
+        }
+        for (uint64_t i = 0; i < total_mismatches && i < TRACE_REPORTED_MISMATCHES; i++) {
+            const trace_mismatch_t *mismatch = report.first_mismatches + i;
+            printf("\t%s(0x%04X, 0x%04X)\n", trace_function_name(mismatch->function), mismatch->operand1,
+                   mismatch->operand2);
+            printf("\t\trecorded: 0x%04X'%04X  unsigned overflow: %d  signed overflow: %d  divide-by-zero: %d\n",
+                   mismatch->recorded.supplemental_result, mismatch->recorded.result,
+                   mismatch->recorded.unsigned_overflow, mismatch->recorded.signed_overflow,
+                   mismatch->recorded.divide_by_zero);
+            printf("\t\treplayed: 0x%04X'%04X  unsigned overflow: %d  signed overflow: %d  divide-by-zero: %d\n",
+                   mismatch->replayed.supplemental_result, mismatch->replayed.result,
+                   mismatch->replayed.unsigned_overflow, mismatch->replayed.signed_overflow,
+                   mismatch->replayed.divide_by_zero);
+        }
+        printf("\treplayed in %.3f ms (%.1f ns per call)\n", (double) report.nanoseconds / 1e6,
+               report.records ? (double) report.nanoseconds / (double) report.records : 0.0);
+    } else {
+        printf("Usage: trace start <path>, trace stop, or trace replay <path>\n");
+    }
+}
+
+void evaluate_print_sample(const char *input_buffer) {
+    char command[8] = "", path[EXPRESSION_SOURCE_LENGTH] = "";
+    unsigned int interval = SAMPLER_DEFAULT_INTERVAL;
+    sscanf(input_buffer + 6, "%7s %255s %u", command, path, &interval); // NOLINT(cert-err34-c)
+    if (!strcmp(command, "start") && path[0]) {
+        if (sampler_start(interval, path)) {
+            printf("Sampling every %u microseconds of CPU time; reports go to %s.flat and %s.folded\n",
+                   interval ? interval : SAMPLER_DEFAULT_INTERVAL, path, path);
+        } else {
+            printf("Cannot start sampling (is the sampler already running?)\n");
+        }
+    } else if (!strcmp(command, "stop")) {
+        sampler_summary_t summary;
+        if (sampler_stop(&summary)) {
+            printf("Took %" PRIu64 " samples (%" PRIu64 " dropped) in %" PRIu64 " functions\n", summary.samples,
+                   summary.dropped, summary.symbols);
+        } else {
+            printf("The sampler is not running\n");
+        }
+    } else {
+        printf("Usage: sample start <path-prefix> [microseconds], or sample stop\n");
+    }
+}
+
+void evaluate_print_pipeline(const char *input_buffer) {
+    char path[EXPRESSION_SOURCE_LENGTH] = "", mode[16] = "full";
+    int evaluators = 1;
+    format_verbosity_t verbosity = FORMAT_FULL;
+    pipeline_report_t report;
+    sscanf(input_buffer + 8, "%255s %d %15s", path, &evaluators, mode); // NOLINT(cert-err34-c)
+    while (verbosity < FORMAT_SUMMARY && strcmp(mode, format_verbosity_name(verbosity))) {
+        verbosity++;
+    }
+    FILE *script = path[0] ? fopen(path, "r") : NULL;
+    if (!script || strcmp(mode, format_verbosity_name(verbosity))) {
+        printf("Usage: pipeline <script> [evaluators] [full|mismatches|summary]  (cannot read \"%s\")\n", path);
+        if (script) {
+            fclose(script);
+        }
+        return;
+    }
+    fflush(stdout);
+    if (pipeline_run(script, stdout, evaluators, verbosity, &report)) {
+        printf("%" PRIu64 " expressions (%" PRIu64 " passed, %" PRIu64 " failed; %" PRIu64 " lines not understood) "
+               "from %" PRIu64 " lines in %.3f ms with %d evaluators: %.0f expressions/s\n",
+               report.operations, report.passed, report.failed, report.errors, report.lines,
+               (double) report.nanoseconds / 1e6, evaluators,
+               1e9 * (double) report.operations / (double) report.nanoseconds);
+    } else {
+        printf("Cannot start a pipeline with %d evaluators (at most %d, and memory and threads must be available)\n",
+               evaluators, PIPELINE_MAXIMUM_EVALUATORS);
     }
+    fclose(script);
 }
 
 bool read_evaluate_print() {
-    char input_buffer[72];
+    char input_buffer[EXPRESSION_SOURCE_LENGTH];
     uint32_t operand1, operand2;
     char operator[3];
     bool keep_going = true;
@@ -257,11 +743,27 @@ bool read_evaluate_print() {
            "    a two-operand comparison expression, a two-operand arithmetic expression,\n"
            "    \"lg <value>\" or \"exponentiate <value>\" to test your powers-of-two code,\n"
            "    \"is_negative <value>\" to determine if 2's complement value is negative,\n"
+           "    \"compare <value1> <value2>\" for the condition flags and all six relations,\n"
            "    \"add1 <binary_value1> <binary_value2> <carry_in>\" for 1-bit full adder,\n"
            "    \"add32 <hex_value1> <hex_value2> <carry_in>\" for 32-bit ripple-carry adder,\n"
            "    \"mul2 <hex_value> <hex_power_of_two>\" for power-of-two multiplier,\n"
+           "    \"shift <left|right|arithmetic|rotl|rotr> <hex_value> <amount>\" for the barrel shifter,\n"
+           "    \"gates <value1> <value2>\" for the gate count and critical-path depth of each operation,\n"
+           "    \"float16 <binary16|bfloat16> <add|subtract|multiply|compare> <hex_value1> <hex_value2>\"\n"
+           "        or \"float16 check <binary16|bfloat16> [hex_stride]\" for 16-bit floating point on the ALU,\n"
+           "    \"q15 <add|subtract|multiply> <hex_value1> <hex_value2>\" for saturating Q15 fixed point,\n"
+           "    \"swar <hex_value1> <hex_value2>\" for 4x16-bit packed arithmetic on 64-bit values,\n"
+           "    \"alu<8|16|32|64> <value1> <+|-|*|/> <value2>\" for the width-generic ALU,\n"
+           "    \"let <variable> = <value>\" to bind a variable a-z for expressions,\n"
+           "    \"eval <expression>\" to compile and evaluate an infix expression with the ALU,\n"
+           "    \"cpu <workload>\" to run a program on the ALU-based CPU (\"cpu list\" names them),\n"
+           "    \"trace start <path>\", \"trace stop\", or \"trace replay <path>\" to record or replay ALU calls,\n"
+           "    \"sample start <path-prefix> [microseconds]\" or \"sample stop\" to profile by sampling,\n"
+           "    \"pipeline <script> [evaluators] [full|mismatches|summary]\" to check a file of two-operand expressions,\n"
+           "    \"timing\" to check that the constant-time ALU's latency is data-independent,\n"
+           "    \"benchmark <name>\" to run a benchmark (\"benchmark list\" names them),\n"
            "    or \"quit\": ");
-    if (!fgets(input_buffer, 72, stdin)) {
+    if (!fgets(input_buffer, sizeof(input_buffer), stdin)) {
         printf("Failed to read input.\n");
         input_buffer[0] = '\0';
     };
@@ -288,12 +790,42 @@ bool read_evaluate_print() {
                (int16_t) operand1, (uint16_t) operand1, ((int16_t) operand1 < 0 ? "is" : "is not"));
         printf("actual:   %hd (0x%04hX) %s negative\n",
                (int16_t) operand1, (uint16_t) operand1, (is_negative((uint16_t) operand1) ? "is" : "is not"));
+    } else if (!strncmp(input_buffer, "compare", 7)) {
+        evaluate_print_comparison(input_buffer);
     } else if (!strncmp(input_buffer, "add1", 4)) {
         evaluate_print_one_bit_adder(input_buffer);
     } else if (!strncmp(input_buffer, "add32", 5)) {
         evaluate_print_thirty_two_bit_adder(input_buffer);
     } else if (!strncmp(input_buffer, "mul2", 4)) {
         evaluate_print_power_of_two_multiplier(input_buffer);
+    } else if (!strncmp(input_buffer, "shift", 5)) {
+        evaluate_print_shift(input_buffer);
+    } else if (!strncmp(input_buffer, "gates", 5)) {
+        evaluate_print_gates(input_buffer);
+    } else if (!strncmp(input_buffer, "float16", 7)) {
+        evaluate_print_float16(input_buffer);
+    } else if (!strncmp(input_buffer, "q15", 3)) {
+        evaluate_print_q15(input_buffer);
+    } else if (!strncmp(input_buffer, "alu", 3)) {
+        evaluate_print_width(input_buffer);
+    } else if (!strncmp(input_buffer, "swar", 4)) {
+        evaluate_print_swar(input_buffer);
+    } else if (!strncmp(input_buffer, "let", 3)) {
+        evaluate_print_assignment(input_buffer);
+    } else if (!strncmp(input_buffer, "eval", 4)) {
+        evaluate_print_expression(input_buffer);
+    } else if (!strncmp(input_buffer, "cpu", 3)) {
+        evaluate_print_cpu(input_buffer);
+    } else if (!strncmp(input_buffer, "sample", 6)) {
+        evaluate_print_sample(input_buffer);
+    } else if (!strncmp(input_buffer, "trace", 5)) {
+        evaluate_print_trace(input_buffer);
+    } else if (!strncmp(input_buffer, "pipeline", 8)) {
+        evaluate_print_pipeline(input_buffer);
+    } else if (!strncmp(input_buffer, "timing", 6)) {
+        evaluate_print_constant_time_check();
+    } else if (!strncmp(input_buffer, "benchmark", 9)) {
+        evaluate_print_benchmark(input_buffer + 9);
     } else {
         char *next;
         if (isdigit(input_buffer[0]) || input_buffer[0] == '-') {
@@ -0,0 +1,523 @@
+/**************************************************************************//**
+ *
+ * @file pipeline.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Runs a script of two-operand expressions through a reader/parser
+ *      thread, one or more ALU evaluator threads, and a formatter.
+ *
+ * The stages pass batches of parsed operations through bounded lock-free
+ * single-producer/single-consumer rings. The reader deals batches to the
+ * evaluators in rotation and the formatter collects them in the same rotation,
+ * which keeps the output in script order without any reordering buffer. Spent
+ * batches return to the reader through one more ring, so the whole pipeline
+ * works within a fixed pool of batches.
+ *
+ * The evaluators run alu_inline.h's uninstrumented twin of the ALU, so that
+ * concurrent threads never touch the profiler's shared call counters, which
+ * the pipeline does not report anyway.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include "alu_inline.h"
+#include "trace.h"
+#include "benchmark.h"
+#include "authoritative_results.h"
+#include "pipeline.h"
+
+#define PIPELINE_BATCH_SIZE     256
+#define PIPELINE_RING_SLOTS     64          // a power of two; also the number of batches in the pool
+#define PIPELINE_SPINS          64          // polls of an empty or full ring before yielding the processor
+#define PIPELINE_LINE_LENGTH    256
+#define PIPELINE_OPERATORS      14
+
+typedef enum {
+    PIPELINE_NOT_AN_EXPRESSION = 0,
+    PIPELINE_ADD,
+    PIPELINE_SUBTRACT,
+    PIPELINE_MULTIPLY,
+    PIPELINE_DIVIDE,
+    PIPELINE_REMAINDER,
+    PIPELINE_EQUAL,
+    PIPELINE_NOT_EQUAL,
+    PIPELINE_LESS_THAN,
+    PIPELINE_AT_MOST,
+    PIPELINE_GREATER_THAN,
+    PIPELINE_AT_LEAST,
+    PIPELINE_AND,
+    PIPELINE_OR
+} pipeline_operator_t;                      // PIPELINE_OPERATORS in all
+
+typedef struct {
+    uint64_t line;
+    pipeline_operator_t operator;
+    uint16_t operand1;
+    uint16_t operand2;
+    uint32_t nanoseconds;                   // time spent in the ALU
+    struct authoritative_result expected[2];    // unsigned, then signed; for relations, the truth value
+    alu_result_t actual[2];                 // for relations, compare's flags; for && and ||, the truth value
+} pipeline_operation_t;
+
+typedef struct {
+    int count;
+    bool last;                              // marks the end of the script; carries no operations
+    pipeline_operation_t operations[PIPELINE_BATCH_SIZE];
+} pipeline_batch_t;
+
+typedef struct {
+    pipeline_batch_t *slots[PIPELINE_RING_SLOTS];
+    uint32_t head __attribute__ ((aligned (64)));   // written only by the consumer
+    uint32_t tail __attribute__ ((aligned (64)));   // written only by the producer
+} pipeline_ring_t;
+
+typedef struct {
+    FILE *input;
+    int evaluators;
+    uint64_t lines;
+    pipeline_ring_t *free_batches;
+    pipeline_ring_t *to_evaluators;
+    pipeline_ring_t *to_formatter;
+} pipeline_t;
+
+typedef struct {
+    pipeline_t *pipeline;
+    int index;
+} pipeline_evaluator_t;
+
+typedef struct {
+    uint64_t passed[PIPELINE_OPERATORS];
+    uint64_t failed[PIPELINE_OPERATORS];
+    uint64_t nanoseconds[PIPELINE_OPERATORS];
+} pipeline_summary_t;
+
+static const char *operator_symbols[] = {"", "+", "-", "*", "/", "%", "==", "!=", "<", "<=", ">", ">=", "&&", "||"};
+
+static void ring_push(pipeline_ring_t *ring, pipeline_batch_t *batch) __attribute__ ((no_instrument_function));
+static pipeline_batch_t *ring_pop(pipeline_ring_t *ring) __attribute__ ((no_instrument_function));
+static bool parse_line(const char *line, pipeline_operation_t *operation) __attribute__ ((no_instrument_function));
+static bool read_batch(pipeline_t *pipeline, pipeline_batch_t *batch) __attribute__ ((no_instrument_function));
+static void evaluate_batch(pipeline_batch_t *batch) __attribute__ ((no_instrument_function));
+static bool format_operation(format_buffer_t *buffer, format_verbosity_t verbosity,
+                             const pipeline_operation_t *operation) __attribute__ ((no_instrument_function));
+static void format_batch(const pipeline_batch_t *batch, format_buffer_t *buffer, format_verbosity_t verbosity,
+                         pipeline_summary_t *summary, pipeline_report_t *report) __attribute__ ((no_instrument_function));
+static void format_summary(format_buffer_t *buffer, const pipeline_summary_t *summary) __attribute__ ((no_instrument_function));
+static void *read_stage(void *pipeline) __attribute__ ((no_instrument_function));
+static void *evaluate_stage(void *evaluator) __attribute__ ((no_instrument_function));
+static void stop_evaluators(pipeline_t *pipeline, pthread_t *threads, int count) __attribute__ ((no_instrument_function));
+
+/*
+ * RINGS
+ */
+
+static void ring_push(pipeline_ring_t *ring, pipeline_batch_t *batch) {
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    int spins = 0;
+    while (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == PIPELINE_RING_SLOTS) {
+        if (++spins == PIPELINE_SPINS) {
+            sched_yield();
+            spins = 0;
+        }
+    }
+    ring->slots[tail & (PIPELINE_RING_SLOTS - 1)] = batch;
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+static pipeline_batch_t *ring_pop(pipeline_ring_t *ring) {
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    int spins = 0;
+    while (head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) {
+        if (++spins == PIPELINE_SPINS) {
+            sched_yield();
+            spins = 0;
+        }
+    }
+    pipeline_batch_t *batch = ring->slots[head & (PIPELINE_RING_SLOTS - 1)];
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return batch;
+}
+
+/*
+ * STAGES
+ */
+
+static bool parse_line(const char *line, pipeline_operation_t *operation) {
+    char *next;
+    while (isspace(*line)) {
+        line++;
+    }
+    long operand1 = strtol(line, &next, strncmp(line, "0x", 2) ? 10 : 16);
+    if (next == line) {
+        return false;
+    }
+    while (isspace(*next)) {
+        next++;
+    }
+    operation->operator = PIPELINE_NOT_AN_EXPRESSION;
+    // try the two-character operators first, so that "<=" is not taken for "<"
+    for (size_t length = 2; length > 0 && operation->operator == PIPELINE_NOT_AN_EXPRESSION; length--) {
+        for (int i = PIPELINE_ADD; i <= PIPELINE_OR; i++) {
+            if (strlen(operator_symbols[i]) == length && !strncmp(next, operator_symbols[i], length)) {
+                operation->operator = (pipeline_operator_t) i;
+                next += length;
+                break;
+            }
+        }
+    }
+    while (isspace(*next)) {
+        next++;
+    }
+    line = next;
+    long operand2 = strtol(line, &next, strncmp(line, "0x", 2) ? 10 : 16);
+    while (isspace(*next)) {
+        next++;
+    }
+    operation->operand1 = (uint16_t) operand1;
+    operation->operand2 = (uint16_t) operand2;
+    return operation->operator != PIPELINE_NOT_AN_EXPRESSION && next != line && *next == '\0';
+}
+
+static bool read_batch(pipeline_t *pipeline, pipeline_batch_t *batch) {
+    char line[PIPELINE_LINE_LENGTH];
+    batch->count = 0;
+    batch->last = false;
+    while (batch->count < PIPELINE_BATCH_SIZE && fgets(line, sizeof(line), pipeline->input)) {
+        pipeline->lines++;
+        const char *first = line;
+        while (isspace(*first)) {
+            first++;
+        }
+        if (*first != '\0' && *first != '#') {
+            pipeline_operation_t *operation = batch->operations + batch->count++;
+            operation->line = pipeline->lines;
+            if (!parse_line(first, operation)) {
+                operation->operator = PIPELINE_NOT_AN_EXPRESSION;
+            }
+        }
+    }
+    return batch->count > 0;
+}
+
+static void evaluate_batch(pipeline_batch_t *batch) {
+    for (int i = 0; i < batch->count; i++) {
+        pipeline_operation_t *operation = batch->operations + i;
+        uint16_t operand1 = operation->operand1;
+        uint16_t operand2 = operation->operand2;
+        int16_t signed1 = (int16_t) operand1;
+        int16_t signed2 = (int16_t) operand2;
+        struct authoritative_result *expected = operation->expected;
+        alu_result_t *actual = operation->actual;
+        uint64_t start = benchmark_nanoseconds();
+        switch (operation->operator) {
+            case PIPELINE_ADD:
+                actual[0] = traced_add(operand1, operand2);
+                break;
+            case PIPELINE_SUBTRACT:
+                actual[0] = traced_subtract(operand1, operand2);
+                break;
+            case PIPELINE_MULTIPLY:
+                actual[0] = traced_unsigned_multiply(operand1, operand2);
+                actual[1] = traced_signed_multiply(operand1, operand2);
+                break;
+            case PIPELINE_DIVIDE:
+            case PIPELINE_REMAINDER:
+                actual[0] = traced_unsigned_divide(operand1, operand2);
+                actual[1] = traced_signed_divide(operand1, operand2);
+                break;
+            case PIPELINE_AND:
+                actual[0] = (alu_result_t) {.result = logical_and(operand1, operand2)};
+                break;
+            case PIPELINE_OR:
+                actual[0] = (alu_result_t) {.result = logical_or(operand1, operand2)};
+                break;
+            case PIPELINE_NOT_AN_EXPRESSION:
+                break;
+            default:
+                actual[0] = (alu_result_t) {.result = traced_compare(operand1, operand2)};
+        }
+        operation->nanoseconds = (uint32_t) (benchmark_nanoseconds() - start);
+        // the authoritative results come from the host's own instructions, which cannot divide by zero
+        switch (operation->operator) {
+            case PIPELINE_ADD:
+                evaluate_addition(operand1, operand2, expected);
+                expected[1] = expected[0];
+                actual[1] = actual[0];
+                break;
+            case PIPELINE_SUBTRACT:
+                evaluate_subtraction(operand1, operand2, expected);
+                expected[1] = expected[0];
+                actual[1] = actual[0];
+                break;
+            case PIPELINE_MULTIPLY:
+                evaluate_unsigned_multiplication(operand1, operand2, expected);
+                evaluate_signed_multiplication(operand1, operand2, expected + 1);
+                break;
+            case PIPELINE_DIVIDE:
+            case PIPELINE_REMAINDER:
+                if (operand2) {
+                    evaluate_unsigned_division(operand1, operand2, expected);
+                    evaluate_signed_division(operand1, operand2, expected + 1);
+                }
+                break;
+            case PIPELINE_EQUAL:
+                expected[0].result = signed1 == signed2;
+                break;
+            case PIPELINE_NOT_EQUAL:
+                expected[0].result = signed1 != signed2;
+                break;
+            case PIPELINE_LESS_THAN:
+                expected[0].result = signed1 < signed2;
+                break;
+            case PIPELINE_AT_MOST:
+                expected[0].result = signed1 <= signed2;
+                break;
+            case PIPELINE_GREATER_THAN:
+                expected[0].result = signed1 > signed2;
+                break;
+            case PIPELINE_AT_LEAST:
+                expected[0].result = signed1 >= signed2;
+                break;
+            case PIPELINE_AND:
+                expected[0].result = operand1 && operand2;
+                break;
+            case PIPELINE_OR:
+                expected[0].result = operand1 || operand2;
+                break;
+            case PIPELINE_NOT_AN_EXPRESSION:
+                break;
+        }
+    }
+}
+
+static bool format_operation(format_buffer_t *buffer, format_verbosity_t verbosity,
+                             const pipeline_operation_t *operation) {
+    pipeline_operator_t operator = operation->operator;
+    alu_flags_t flags = (alu_flags_t) operation->actual[0].result;
+    format_relation_t relation = {operator_symbols[operator], operation->operand1, operation->operand2,
+                                  true, true, operation->expected[0].result, 0};
+    switch (operator) {
+        case PIPELINE_NOT_AN_EXPRESSION:
+            if (verbosity != FORMAT_SUMMARY) {
+                format_string(buffer, "line ");
+                format_unsigned(buffer, operation->line);
+                format_string(buffer, ": not a two-operand expression\n");
+            }
+            return false;
+        case PIPELINE_ADD:
+        case PIPELINE_SUBTRACT:
+        case PIPELINE_MULTIPLY:
+        case PIPELINE_DIVIDE:
+        case PIPELINE_REMAINDER: {
+            format_arithmetic_t check = {.operator = operator_symbols[operator][0],
+                                         .operand1 = operation->operand1, .operand2 = operation->operand2,
+                                         .addition_calls = {-1, -1}, .shift_calls = {-1, -1}};
+            memcpy(check.expected, operation->expected, sizeof(check.expected));
+            memcpy(check.actual, operation->actual, sizeof(check.actual));
+            return format_arithmetic(buffer, verbosity, &check);
+        }
+        case PIPELINE_AND:
+        case PIPELINE_OR:
+            relation.signed_operands = false;
+            relation.parenthesized = false;
+            relation.actual = operation->actual[0].result;
+            break;
+        case PIPELINE_EQUAL:
+            relation.actual = flags_equal(flags);
+            break;
+        case PIPELINE_NOT_EQUAL:
+            relation.actual = flags_not_equal(flags);
+            break;
+        case PIPELINE_LESS_THAN:
+            relation.actual = flags_less_than(flags);
+            break;
+        case PIPELINE_AT_MOST:
+            relation.actual = flags_at_most(flags);
+            break;
+        case PIPELINE_GREATER_THAN:
+            relation.actual = flags_greater_than(flags);
+            break;
+        case PIPELINE_AT_LEAST:
+            relation.actual = flags_at_least(flags);
+    }
+    return format_relation(buffer, verbosity, &relation);
+}
+
+static void format_batch(const pipeline_batch_t *batch, format_buffer_t *buffer, format_verbosity_t verbosity,
+                         pipeline_summary_t *summary, pipeline_report_t *report) {
+    for (int i = 0; i < batch->count; i++) {
+        const pipeline_operation_t *operation = batch->operations + i;
+        bool passed = format_operation(buffer, verbosity, operation);
+        if (operation->operator == PIPELINE_NOT_AN_EXPRESSION) {
+            report->errors++;
+        } else {
+            report->operations++;
+            report->passed += passed;
+            report->failed += !passed;
+            summary->passed[operation->operator] += passed;
+            summary->failed[operation->operator] += !passed;
+            summary->nanoseconds[operation->operator] += operation->nanoseconds;
+        }
+    }
+}
+
+static void format_summary(format_buffer_t *buffer, const pipeline_summary_t *summary) {
+    format_string(buffer, "SUMMARY\n\toperator\tpassed\tfailed\tmean ALU time (ns)\n");
+    for (int i = PIPELINE_ADD; i < PIPELINE_OPERATORS; i++) {
+        uint64_t count = summary->passed[i] + summary->failed[i];
+        if (count) {
+            format_character(buffer, '\t');
+            format_string(buffer, operator_symbols[i]);
+            format_character(buffer, '\t');
+            format_unsigned(buffer, summary->passed[i]);
+            format_character(buffer, '\t');
+            format_unsigned(buffer, summary->failed[i]);
+            format_character(buffer, '\t');
+            format_fixed(buffer, (double) summary->nanoseconds[i] / (double) count, 1);
+            format_character(buffer, '\n');
+        }
+    }
+}
+
+static void *read_stage(void *pipeline) {
+    pipeline_t *stages = pipeline;
+    int evaluator = 0;
+    pipeline_batch_t *batch = ring_pop(stages->free_batches);
+    while (read_batch(stages, batch)) {
+        ring_push(stages->to_evaluators + evaluator, batch);
+        evaluator = (evaluator + 1) % stages->evaluators;
+        batch = ring_pop(stages->free_batches);
+    }
+    // every evaluator gets an end marker, starting with the one the formatter expects next
+    for (int i = 0; i < stages->evaluators; i++) {
+        batch = i ? ring_pop(stages->free_batches) : batch;
+        batch->count = 0;
+        batch->last = true;
+        ring_push(stages->to_evaluators + evaluator, batch);
+        evaluator = (evaluator + 1) % stages->evaluators;
+    }
+    return NULL;
+}
+
+static void *evaluate_stage(void *evaluator) {
+    pipeline_evaluator_t *self = evaluator;
+    bool last = false;
+    while (!last) {
+        pipeline_batch_t *batch = ring_pop(self->pipeline->to_evaluators + self->index);
+        last = batch->last;
+        evaluate_batch(batch);
+        ring_push(self->pipeline->to_formatter + self->index, batch);
+    }
+    return NULL;
+}
+
+/* ends the first count evaluators with the marker the reader would have sent, and waits for them */
+static void stop_evaluators(pipeline_t *pipeline, pthread_t *threads, int count) {
+    for (int i = 0; i < count; i++) {
+        pipeline_batch_t *batch = ring_pop(pipeline->free_batches);
+        batch->count = 0;
+        batch->last = true;
+        ring_push(pipeline->to_evaluators + i, batch);
+    }
+    for (int i = 0; i < count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+/**
+ * Checks every expression in a script against the authoritative results, writing one report per expression in
+ * script order.
+ * @param input the script
+ * @param output where the results are written
+ * @param evaluators the number of evaluator threads, up to PIPELINE_MAXIMUM_EVALUATORS; with 0, reading,
+ *      evaluating, and formatting take turns on the calling thread
+ * @param verbosity FORMAT_FULL reports every expression, FORMAT_MISMATCHES only those the ALU gets wrong, and
+ *      FORMAT_SUMMARY only per-operator counts and timings at the end
+ * @param report filled with counts, timing, and a checksum of the output
+ * @return true if the script was run; false if the pipeline could not be started
+ */
+bool pipeline_run(FILE *input, FILE *output, int evaluators, format_verbosity_t verbosity, pipeline_report_t *report) {
+    pipeline_t pipeline = {.input = input, .evaluators = evaluators};
+    pipeline_batch_t *batches = malloc(PIPELINE_RING_SLOTS * sizeof(pipeline_batch_t));
+    pipeline_summary_t summary = {};
+    format_buffer_t buffer;
+    bool started = format_open(&buffer, output, 0) && batches
+                   && evaluators >= 0 && evaluators <= PIPELINE_MAXIMUM_EVALUATORS;
+    memset(report, 0, sizeof(pipeline_report_t));
+    buffer.checksummed = true;
+    uint64_t start = benchmark_nanoseconds();
+    if (started && evaluators == 0) {
+        while (read_batch(&pipeline, batches)) {
+            evaluate_batch(batches);
+            format_batch(batches, &buffer, verbosity, &summary, report);
+        }
+    } else if (started) {
+        pthread_t reader, threads[PIPELINE_MAXIMUM_EVALUATORS];
+        pipeline_evaluator_t stages[PIPELINE_MAXIMUM_EVALUATORS];
+        pipeline.free_batches = calloc(1, sizeof(pipeline_ring_t));
+        pipeline.to_evaluators = calloc((size_t) evaluators, sizeof(pipeline_ring_t));
+        pipeline.to_formatter = calloc((size_t) evaluators, sizeof(pipeline_ring_t));
+        started = pipeline.free_batches && pipeline.to_evaluators && pipeline.to_formatter;
+        for (int i = 0; started && i < PIPELINE_RING_SLOTS; i++) {
+            ring_push(pipeline.free_batches, batches + i);
+        }
+        // the evaluators start first, so that any that did start can be ended before the reader has dealt them work
+        int running = 0;
+        while (started && running < evaluators) {
+            stages[running] = (pipeline_evaluator_t) {&pipeline, running};
+            started = !pthread_create(threads + running, NULL, evaluate_stage, stages + running);
+            running += started;
+        }
+        started = started && !pthread_create(&reader, NULL, read_stage, &pipeline);
+        if (!started) {
+            stop_evaluators(&pipeline, threads, running);
+        }
+        // the formatter runs here, collecting batches in the order the reader dealt them
+        int evaluator = 0;
+        int finished = 0;
+        while (started && finished < evaluators) {
+            pipeline_batch_t *batch = ring_pop(pipeline.to_formatter + evaluator);
+            evaluator = (evaluator + 1) % evaluators;
+            if (batch->last) {
+                finished++;
+            } else {
+                format_batch(batch, &buffer, verbosity, &summary, report);
+                ring_push(pipeline.free_batches, batch);
+            }
+        }
+        if (started) {
+            pthread_join(reader, NULL);
+            for (int i = 0; i < evaluators; i++) {
+                pthread_join(threads[i], NULL);
+            }
+        }
+        free(pipeline.free_batches);
+        free(pipeline.to_evaluators);
+        free(pipeline.to_formatter);
+    }
+    if (started && verbosity == FORMAT_SUMMARY) {
+        format_summary(&buffer, &summary);
+    }
+    if (buffer.text) {
+        format_close(&buffer);
+    }
+    report->nanoseconds = benchmark_nanoseconds() - start;
+    report->lines = pipeline.lines;
+    report->bytes_written = buffer.bytes_written;
+    report->checksum = buffer.checksum;
+    free(batches);
+    return started;
+}
@@ -0,0 +1,48 @@
+/**************************************************************************//**
+ *
+ * @file pipeline.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for running a script of
+ *      two-operand expressions through a pipeline of reader, ALU evaluator, and
+ *      formatter threads.
+ *
+ * Each line of a script is "<operand> <operator> <operand>", where the
+ * operator is one of + - * / % == != < <= > >= && ||; blank lines and lines
+ * that begin with # are skipped. Every expression is checked against the
+ * authoritative results, and the reports are written in script order
+ * regardless of how many evaluators run.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "formatter.h"
+
+#define PIPELINE_MAXIMUM_EVALUATORS 16
+
+typedef struct {
+    uint64_t lines;
+    uint64_t operations;
+    uint64_t passed;                    // operations whose results and flags match the authoritative ones
+    uint64_t failed;
+    uint64_t errors;                    // lines that are not expressions
+    uint64_t bytes_written;
+    uint64_t checksum;                  // FNV-1a over the output, to compare runs
+    uint64_t nanoseconds;
+} pipeline_report_t;
+
+bool pipeline_run(FILE *input, FILE *output, int evaluators, format_verbosity_t verbosity,
+                  pipeline_report_t *report) __attribute__ ((no_instrument_function));
+
+#endif //PIPELINE_H
@@ -0,0 +1,303 @@
+/**************************************************************************//**
+ *
+ * @file predicate.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Compares columns of 16-bit values in blocks of 64, producing one
+ *      64-bit selection bitmask word per block.
+ *
+ * Every predicate reduces to equality or signed less-than, possibly with its
+ * operands swapped and its result inverted; an unsigned comparison is a signed
+ * one after flipping both operands' sign bits. Each block kernel therefore only
+ * needs those two relations. The SSE2 and AVX2 kernels are compiled with target
+ * attributes and chosen at run time when the processor has them; the SWAR
+ * kernel works on any host, and the scalar kernel is the reference.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <string.h>
+#include "swar.h"
+#include "predicate.h"
+
+#if defined (__x86_64__) || defined (__i386__)
+#include <immintrin.h>
+#define PREDICATE_X86
+#endif
+
+#define BLOCK               64
+#define SIGN_BIAS           0x8000
+#define SWAR_GATHER         UINT64_C(0x0001000200040008)   // moves lane flags from bits 0, 16, 32, 48 to bits 48-51
+
+typedef uint64_t (*block_kernel_t)(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias);
+
+static uint64_t scalar_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) __attribute__ ((no_instrument_function));
+static uint64_t swar_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) __attribute__ ((no_instrument_function));
+static void compare(predicate_t predicate, const uint16_t *values1, size_t step1, const uint16_t *values2,
+                    size_t step2, uint64_t *mask, size_t count) __attribute__ ((no_instrument_function));
+
+#ifdef PREDICATE_X86
+static uint64_t sse2_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) __attribute__ ((no_instrument_function, target ("sse2")));
+static uint64_t avx2_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) __attribute__ ((no_instrument_function, target ("avx2")));
+#endif
+
+static const struct {
+    bool equality;
+    bool swap;
+    bool invert;
+    uint16_t bias;
+} reductions[NUMBER_OF_PREDICATES] = {
+        [PREDICATE_EQUAL]                   = {true,  false, false, 0},
+        [PREDICATE_NOT_EQUAL]               = {true,  false, true,  0},
+        [PREDICATE_LESS_THAN]               = {false, false, false, 0},
+        [PREDICATE_AT_MOST]                 = {false, true,  true,  0},             // a <= b == !(b < a)
+        [PREDICATE_GREATER_THAN]            = {false, true,  false, 0},             // a > b == b < a
+        [PREDICATE_AT_LEAST]                = {false, false, true,  0},             // a >= b == !(a < b)
+        [PREDICATE_UNSIGNED_LESS_THAN]      = {false, false, false, SIGN_BIAS},
+        [PREDICATE_UNSIGNED_AT_MOST]        = {false, true,  true,  SIGN_BIAS},
+        [PREDICATE_UNSIGNED_GREATER_THAN]   = {false, true,  false, SIGN_BIAS},
+        [PREDICATE_UNSIGNED_AT_LEAST]       = {false, false, true,  SIGN_BIAS},
+};
+
+static const char *predicate_names[NUMBER_OF_PREDICATES] = {
+        "==", "!=", "<", "<=", ">", ">=", "<u", "<=u", ">u", ">=u"
+};
+
+static const char *kernel_names[NUMBER_OF_PREDICATE_KERNELS] = {"scalar", "swar", "sse2", "avx2"};
+
+static block_kernel_t kernels[NUMBER_OF_PREDICATE_KERNELS] = {
+        scalar_block,
+        swar_block,
+#ifdef PREDICATE_X86
+        sse2_block,
+        avx2_block
+#else
+        NULL,
+        NULL
+#endif
+};
+
+static predicate_kernel_t selected_kernel = NUMBER_OF_PREDICATE_KERNELS;   // chosen on first use
+
+/*
+ * BLOCK KERNELS
+ */
+
+static uint64_t scalar_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) {
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK; i++) {
+        int16_t value1 = (int16_t) (left[i] ^ bias);
+        int16_t value2 = (int16_t) (right[i] ^ bias);
+        mask |= (uint64_t) (equality ? value1 == value2 : value1 < value2) << i;
+    }
+    return mask;
+}
+
+static uint64_t swar_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) {
+    uint64_t biases = bias * UINT64_C(0x0001000100010001);
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK; i += SWAR_LANES) {
+        swar_flags_t flags = swar_compare(swar_pack(left + i) ^ biases, swar_pack(right + i) ^ biases);
+        uint64_t holds = (equality ? flags.zero : flags.sign ^ flags.overflow) & SWAR_HIGH_BITS;
+        mask |= (((holds >> 15) * SWAR_GATHER) >> 48 & 0xF) << i;
+    }
+    return mask;
+}
+
+#ifdef PREDICATE_X86
+
+static uint64_t sse2_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) {
+    __m128i biases = _mm_set1_epi16((short) bias);
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK; i += 16) {
+        __m128i left0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (left + i)), biases);
+        __m128i left1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (left + i + 8)), biases);
+        __m128i right0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (right + i)), biases);
+        __m128i right1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (right + i + 8)), biases);
+        __m128i holds0 = equality ? _mm_cmpeq_epi16(left0, right0) : _mm_cmplt_epi16(left0, right0);
+        __m128i holds1 = equality ? _mm_cmpeq_epi16(left1, right1) : _mm_cmplt_epi16(left1, right1);
+        // saturating to bytes keeps each all-ones or all-zeros lane intact, in order
+        mask |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_packs_epi16(holds0, holds1)) << i;
+    }
+    return mask;
+}
+
+static uint64_t avx2_block(const uint16_t *left, const uint16_t *right, bool equality, uint16_t bias) {
+    __m256i biases = _mm256_set1_epi16((short) bias);
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK; i += 32) {
+        __m256i left0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (left + i)), biases);
+        __m256i left1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (left + i + 16)), biases);
+        __m256i right0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (right + i)), biases);
+        __m256i right1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (right + i + 16)), biases);
+        __m256i holds0 = equality ? _mm256_cmpeq_epi16(left0, right0) : _mm256_cmpgt_epi16(right0, left0);
+        __m256i holds1 = equality ? _mm256_cmpeq_epi16(left1, right1) : _mm256_cmpgt_epi16(right1, left1);
+        // packing works within each 128-bit half, so the middle two quarters come out swapped
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(holds0, holds1), 0xD8);
+        mask |= (uint64_t) (uint32_t) _mm256_movemask_epi8(packed) << i;
+    }
+    return mask;
+}
+
+#endif //PREDICATE_X86
+
+/*
+ * KERNEL SELECTION
+ */
+
+/**
+ * Determines whether a kernel can run on this processor.
+ * @param kernel the kernel
+ * @return true if the kernel was compiled in and the processor has the instructions it needs
+ */
+bool predicate_kernel_supported(predicate_kernel_t kernel) {
+#ifdef PREDICATE_X86
+    __builtin_cpu_init();
+    if (kernel == PREDICATE_SSE2) {
+        return __builtin_cpu_supports("sse2");
+    } else if (kernel == PREDICATE_AVX2) {
+        return __builtin_cpu_supports("avx2");
+    }
+#endif
+    return kernel == PREDICATE_SCALAR || kernel == PREDICATE_SWAR;
+}
+
+/**
+ * Reports the kernel that comparisons use, choosing the widest supported one if none has been selected.
+ * @return the kernel
+ */
+predicate_kernel_t predicate_kernel(void) {
+    if (selected_kernel == NUMBER_OF_PREDICATE_KERNELS) {
+        predicate_kernel_t kernel = PREDICATE_AVX2;
+        while (!predicate_kernel_supported(kernel)) {
+            kernel--;
+        }
+        selected_kernel = kernel;
+    }
+    return selected_kernel;
+}
+
+/**
+ * Makes subsequent comparisons use a particular kernel, such as to compare kernels with each other.
+ * @param kernel the kernel
+ * @return true if the kernel was selected; false if it cannot run on this processor
+ */
+bool predicate_select_kernel(predicate_kernel_t kernel) {
+    bool supported = kernel < NUMBER_OF_PREDICATE_KERNELS && predicate_kernel_supported(kernel);
+    if (supported) {
+        selected_kernel = kernel;
+    }
+    return supported;
+}
+
+const char *predicate_kernel_name(predicate_kernel_t kernel) {
+    return kernel_names[kernel];
+}
+
+const char *predicate_name(predicate_t predicate) {
+    return predicate_names[predicate];
+}
+
+/*
+ * COMPARISON, COUNTING, AND COMPACTION
+ */
+
+/**
+ * Compares two sources of values block by block. A source is either a column (step 64) or a block holding one
+ * value 64 times (step 0).
+ */
+static void compare(predicate_t predicate, const uint16_t *values1, size_t step1, const uint16_t *values2,
+                    size_t step2, uint64_t *mask, size_t count) {
+    block_kernel_t block = kernels[predicate_kernel()];
+    bool equality = reductions[predicate].equality;
+    uint16_t bias = reductions[predicate].bias;
+    uint64_t inversion = reductions[predicate].invert ? UINT64_MAX : 0;
+    if (reductions[predicate].swap) {
+        const uint16_t *values = values1;
+        size_t step = step1;
+        values1 = values2;
+        step1 = step2;
+        values2 = values;
+        step2 = step;
+    }
+    size_t blocks = count / BLOCK;
+    for (size_t i = 0; i < blocks; i++) {
+        mask[i] = block(values1 + i * step1, values2 + i * step2, equality, bias) ^ inversion;
+    }
+    size_t remaining = count % BLOCK;
+    if (remaining) {
+        // the last, partial block is copied so that the kernels never read past the end of a column
+        uint16_t left[BLOCK] = {}, right[BLOCK] = {};
+        memcpy(left, values1 + blocks * step1, remaining * sizeof(uint16_t));
+        memcpy(right, values2 + blocks * step2, remaining * sizeof(uint16_t));
+        mask[blocks] = (block(left, right, equality, bias) ^ inversion) & ((UINT64_C(1) << remaining) - 1);
+    }
+}
+
+/**
+ * Compares two columns element by element.
+ * @param predicate the relation to test, values1[i] on the left and values2[i] on the right
+ * @param values1 the first column
+ * @param values2 the second column
+ * @param mask receives predicate_mask_words(count) words; bit i is set if the relation holds for element i
+ * @param count the number of elements in each column
+ */
+void predicate_compare_columns(predicate_t predicate, const uint16_t *values1, const uint16_t *values2,
+                               uint64_t *mask, size_t count) {
+    compare(predicate, values1, BLOCK, values2, BLOCK, mask, count);
+}
+
+/**
+ * Compares each element of a column with a constant.
+ * @param predicate the relation to test, the element on the left and the constant on the right
+ * @param values the column
+ * @param constant the value to compare against
+ * @param mask receives predicate_mask_words(count) words; bit i is set if the relation holds for element i
+ * @param count the number of elements in the column
+ */
+void predicate_compare_constant(predicate_t predicate, const uint16_t *values, uint16_t constant,
+                                uint64_t *mask, size_t count) {
+    uint16_t constants[BLOCK];
+    for (int i = 0; i < BLOCK; i++) {
+        constants[i] = constant;
+    }
+    compare(predicate, values, BLOCK, constants, 0, mask, count);
+}
+
+/**
+ * Counts the selected elements.
+ * @param mask a selection bitmask
+ * @param count the number of elements the mask covers
+ * @return the number of set bits
+ */
+size_t predicate_count(const uint64_t *mask, size_t count) {
+    size_t selected = 0;
+    for (size_t i = 0; i < predicate_mask_words(count); i++) {
+        selected += (size_t) __builtin_popcountll(mask[i]);
+    }
+    return selected;
+}
+
+/**
+ * Lists the selected elements' indices in increasing order.
+ * @param mask a selection bitmask
+ * @param count the number of elements the mask covers
+ * @param indices receives the indices; it must have room for predicate_count(mask, count) of them
+ * @return the number of indices written
+ */
+size_t predicate_compact(const uint64_t *mask, size_t count, uint32_t *indices) {
+    size_t selected = 0;
+    for (size_t i = 0; i < predicate_mask_words(count); i++) {
+        uint64_t word = mask[i];
+        while (word) {
+            indices[selected++] = (uint32_t) (i * BLOCK) + (uint32_t) __builtin_ctzll(word);
+            word &= word - 1;
+        }
+    }
+    return selected;
+}
@@ -0,0 +1,65 @@
+/**************************************************************************//**
+ *
+ * @file predicate.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for comparing columns of
+ *      16-bit values in bulk, producing packed selection bitmasks.
+ *
+ * Bit i of a bitmask (bit i % 64 of word i / 64) is set when the predicate
+ * holds for element i. Bits past the last element are always clear, so masks
+ * can be combined word by word and counted without trimming.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef PREDICATE_H
+#define PREDICATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define predicate_mask_words(count)     (((count) + 63) / 64)
+
+typedef enum {
+    PREDICATE_EQUAL = 0,
+    PREDICATE_NOT_EQUAL,
+    PREDICATE_LESS_THAN,
+    PREDICATE_AT_MOST,
+    PREDICATE_GREATER_THAN,
+    PREDICATE_AT_LEAST,
+    PREDICATE_UNSIGNED_LESS_THAN,
+    PREDICATE_UNSIGNED_AT_MOST,
+    PREDICATE_UNSIGNED_GREATER_THAN,
+    PREDICATE_UNSIGNED_AT_LEAST,
+    NUMBER_OF_PREDICATES
+} predicate_t;
+
+typedef enum {
+    PREDICATE_SCALAR = 0,
+    PREDICATE_SWAR,
+    PREDICATE_SSE2,
+    PREDICATE_AVX2,
+    NUMBER_OF_PREDICATE_KERNELS
+} predicate_kernel_t;
+
+void predicate_compare_columns(predicate_t predicate, const uint16_t *values1, const uint16_t *values2,
+                               uint64_t *mask, size_t count) __attribute__ ((no_instrument_function));
+void predicate_compare_constant(predicate_t predicate, const uint16_t *values, uint16_t constant,
+                                uint64_t *mask, size_t count) __attribute__ ((no_instrument_function));
+size_t predicate_count(const uint64_t *mask, size_t count) __attribute__ ((no_instrument_function));
+size_t predicate_compact(const uint64_t *mask, size_t count, uint32_t *indices) __attribute__ ((no_instrument_function));
+
+predicate_kernel_t predicate_kernel(void) __attribute__ ((no_instrument_function));
+bool predicate_kernel_supported(predicate_kernel_t kernel) __attribute__ ((no_instrument_function));
+bool predicate_select_kernel(predicate_kernel_t kernel) __attribute__ ((no_instrument_function));
+const char *predicate_kernel_name(predicate_kernel_t kernel) __attribute__ ((no_instrument_function));
+const char *predicate_name(predicate_t predicate) __attribute__ ((no_instrument_function));
+
+#endif //PREDICATE_H
@@ -0,0 +1,278 @@
+/**************************************************************************//**
+ *
+ * @file q15.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Saturating Q15 addition, subtraction, and multiplication on the ALU,
+ *      and the dot product, FIR filter, moving average, and radix-2 FFT
+ *      built on them.
+ *
+ * Addition and subtraction clamp whenever the ALU reports signed overflow.
+ * Multiplication takes the full 32-bit product from signed_multiply's result
+ * and supplemental_result fields, which is a Q30 value, and rounds it back to
+ * Q15.
+ *
+ * The kernels work the way a DSP's multiply-accumulate unit does. Products are
+ * summed at full Q30 precision in a 32-bit accumulator, which saturates at
+ * each step rather than wrapping. The sum is rounded to Q15 only once, at the
+ * end. So a filter's output is the correctly rounded sum of its exact
+ * products, not a sum of individually rounded ones. The accumulator's sums
+ * and differences go through the 32-bit ripple-carry adder. Sign extension,
+ * packing the product's halves, and the final shift are only wiring.
+ *
+ * Each FFT butterfly halves its outputs, so a transform of 2**k points
+ * returns the discrete Fourier transform divided by 2**k and cannot
+ * overflow. This is the usual scaling for fixed-point FFTs. The caller
+ * supplies the twiddle table, so the transform itself allocates nothing.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include <math.h>
+#include "q15.h"
+
+#define ACCUMULATOR_MAX     UINT32_C(0x7FFFFFFF)
+#define ACCUMULATOR_MIN     UINT32_C(0x80000000)
+#define PI                  3.14159265358979323846
+
+static uint32_t sign_extend(q15_t value) __attribute__ ((no_instrument_function));
+static uint32_t full_product(q15_t multiplicand, q15_t multiplier);
+static uint32_t accumulate(uint32_t accumulator, uint32_t addend, uint8_t subtracting);
+static q15_t narrow(uint32_t accumulator, uint8_t places);
+static q15_t saturate(alu_result_t result, q15_t first_operand) __attribute__ ((no_instrument_function));
+static size_t reverse_bits(size_t index, int bits) __attribute__ ((no_instrument_function));
+
+static uint32_t sign_extend(q15_t value) {
+    return (uint32_t) (int32_t) (int16_t) value;
+}
+
+/* the exact Q30 product, assembled from the two halves of the ALU's signed product */
+static uint32_t full_product(q15_t multiplicand, q15_t multiplier) {
+    alu_result_t product = signed_multiply(multiplicand, multiplier);
+    return (uint32_t) product.supplemental_result << ALU_WIDTH | product.result;
+}
+
+/* adds an addend to (or subtracts it from) a 32-bit accumulator, clamping instead of wrapping on signed overflow */
+static uint32_t accumulate(uint32_t accumulator, uint32_t addend, uint8_t subtracting) {
+    uint32_t input = subtracting ? ~addend : addend;
+    uint32_t total = ripple_carry_addition(accumulator, input, subtracting);
+    if ((~(accumulator ^ input) & (accumulator ^ total)) >> 31) {
+        total = (accumulator >> 31) ? ACCUMULATOR_MIN : ACCUMULATOR_MAX;
+    }
+    return total;
+}
+
+/* divides an accumulator by 2**places, rounding to nearest with ties up, and clamps the quotient to Q15 */
+static q15_t narrow(uint32_t accumulator, uint8_t places) {
+    int32_t quotient = (int32_t) accumulate(accumulator, (UINT32_C(1) << places) >> 1, 0) >> places;
+    if (quotient > INT16_MAX) {
+        return Q15_MAX;
+    } else if (quotient < INT16_MIN) {
+        return Q15_MIN;
+    } else {
+        return (q15_t) quotient;
+    }
+}
+
+/* a sum or difference overflows only toward the first operand's sign, so that sign picks the bound */
+static q15_t saturate(alu_result_t result, q15_t first_operand) {
+    if (result.signed_overflow) {
+        return is_negative(first_operand) ? Q15_MIN : Q15_MAX;
+    }
+    return result.result;
+}
+
+static size_t reverse_bits(size_t index, int bits) {
+    size_t reversed = 0;
+    for (int i = 0; i < bits; i++) {
+        reversed = reversed << 1 | ((index >> i) & 0x1);
+    }
+    return reversed;
+}
+
+/**
+ * Adds two Q15 values, saturating.
+ * @param augend the number to be added to
+ * @param addend the number to be added to the augend
+ * @return the sum, or Q15_MAX or Q15_MIN if the sum is out of range
+ */
+q15_t q15_add(q15_t augend, q15_t addend) {
+    return saturate(add(augend, addend), augend);
+}
+
+/**
+ * Subtracts two Q15 values, saturating.
+ * @param menuend the number to be subtracted from
+ * @param subtrahend the number to be subtracted from the menuend
+ * @return the difference, or Q15_MAX or Q15_MIN if the difference is out of range
+ */
+q15_t q15_subtract(q15_t menuend, q15_t subtrahend) {
+    return saturate(subtract(menuend, subtrahend), menuend);
+}
+
+/**
+ * Multiplies two Q15 values, rounding to nearest and saturating. The only product out of range is -1 * -1.
+ * @param multiplicand the number to be multiplied
+ * @param multiplier the number that the first is to be multiplied by
+ * @return the rounded product, or Q15_MAX for -1 * -1
+ */
+q15_t q15_multiply(q15_t multiplicand, q15_t multiplier) {
+    return narrow(full_product(multiplicand, multiplier), Q15_FRACTION);
+}
+
+/**
+ * Computes the dot product of two Q15 vectors, accumulating the exact products and rounding once.
+ * @param vector1 the first vector
+ * @param vector2 the second vector
+ * @param length the number of elements in each vector
+ * @return the rounded dot product, saturated to Q15
+ */
+q15_t q15_dot_product(const q15_t *vector1, const q15_t *vector2, size_t length) {
+    uint32_t accumulator = 0;
+    for (size_t i = 0; i < length; i++) {
+        accumulator = accumulate(accumulator, full_product(vector1[i], vector2[i]), 0);
+    }
+    return narrow(accumulator, Q15_FRACTION);
+}
+
+/**
+ * Filters a signal with a finite impulse response filter: each output is the sum of the coefficients times the
+ * current and preceding inputs, <code>output[i] = coefficients[0] * input[i] + coefficients[1] * input[i - 1] +
+ * ...</code>. Inputs before the start of the signal are taken to be zero.
+ * @param coefficients the filter's impulse response
+ * @param taps the number of coefficients
+ * @param input the signal
+ * @param output the filtered signal, which must not overlap the input
+ * @param count the number of samples in the signal
+ */
+void q15_fir(const q15_t *coefficients, size_t taps, const q15_t *input, q15_t *output, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t accumulator = 0;
+        for (size_t k = 0; k < taps && k <= i; k++) {
+            accumulator = accumulate(accumulator, full_product(coefficients[k], input[i - k]), 0);
+        }
+        output[i] = narrow(accumulator, Q15_FRACTION);
+    }
+}
+
+/**
+ * Averages each sample with the samples that precede it, keeping a running sum that gains each new sample and loses
+ * the one leaving the window. Dividing by the window is then a rounding shift. Inputs before the start of the signal
+ * are taken to be zero.
+ * @param input the signal
+ * @param output the averaged signal, which must not overlap the input
+ * @param count the number of samples in the signal
+ * @param window the number of samples in each average, which must be a power of two
+ * @return 0 if the window is not a power of two (leaving the output unmodified); 1 otherwise
+ */
+bool q15_moving_average(const q15_t *input, q15_t *output, size_t count, uint16_t window) {
+    if (!window || (window & (window - 1))) {
+        return false;
+    }
+    uint8_t places = (uint8_t) lg(window);
+    uint32_t total = 0;
+    q15_t leaving = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i >= window) {
+            leaving = input[i - window];
+        }
+        total = accumulate(total, sign_extend(input[i]), 0);
+        total = accumulate(total, sign_extend(leaving), 1);
+        output[i] = narrow(total, places);
+    }
+    return true;
+}
+
+/**
+ * Performs one scaled radix-2 decimation-in-time butterfly: with <i>t</i> = twiddle * bottom, the top becomes
+ * (top + <i>t</i>) / 2 and the bottom becomes (top - <i>t</i>) / 2. The complex product is kept at full precision
+ * until the final rounding.
+ * @param top the first input and output
+ * @param bottom the second input and output
+ * @param twiddle the root of unity that the bottom is rotated by
+ */
+void q15_butterfly(q15_complex_t *top, q15_complex_t *bottom, q15_complex_t twiddle) {
+    uint32_t rotated_real = accumulate(full_product(twiddle.real, bottom->real),
+                                       full_product(twiddle.imaginary, bottom->imaginary), 1);
+    uint32_t rotated_imaginary = accumulate(full_product(twiddle.real, bottom->imaginary),
+                                            full_product(twiddle.imaginary, bottom->real), 0);
+    uint32_t top_real = sign_extend(top->real) << Q15_FRACTION;
+    uint32_t top_imaginary = sign_extend(top->imaginary) << Q15_FRACTION;
+    top->real = narrow(accumulate(top_real, rotated_real, 0), Q15_FRACTION + 1);
+    top->imaginary = narrow(accumulate(top_imaginary, rotated_imaginary, 0), Q15_FRACTION + 1);
+    bottom->real = narrow(accumulate(top_real, rotated_real, 1), Q15_FRACTION + 1);
+    bottom->imaginary = narrow(accumulate(top_imaginary, rotated_imaginary, 1), Q15_FRACTION + 1);
+}
+
+/**
+ * Computes the twiddle table that <code>q15_fft</code> needs for a transform of a given length: the roots of unity
+ * e**(-2 pi i k / length) for k < length / 2, rounded to Q15. A table can be reused for any number of transforms of
+ * that length.
+ * @param twiddles receives the <code>length / 2</code> roots of unity
+ * @param length the number of points in the transform, which <i>must</i> be a power of two
+ */
+void q15_fft_twiddles(q15_complex_t *twiddles, size_t length) {
+    for (size_t k = 0; k < length / 2; k++) {
+        double angle = 2 * PI * (double) k / (double) length;
+        twiddles[k].real = q15_from_double(cos(angle));
+        twiddles[k].imaginary = q15_from_double(-sin(angle));
+    }
+}
+
+/**
+ * Transforms a signal in place with an iterative radix-2 fast Fourier transform. Because every butterfly is scaled,
+ * the result is the discrete Fourier transform divided by the length.
+ * @param data the signal, replaced by its scaled transform in natural order
+ * @param twiddles the table that <code>q15_fft_twiddles</code> computes for this length
+ * @param length the number of points, which <i>must</i> be a power of two
+ */
+void q15_fft(q15_complex_t *data, const q15_complex_t *twiddles, size_t length) {
+    int bits = floor_lg((uint32_t) length);
+    for (size_t i = 0; i < length; i++) {
+        size_t j = reverse_bits(i, bits);
+        if (j > i) {
+            q15_complex_t swap = data[i];
+            data[i] = data[j];
+            data[j] = swap;
+        }
+    }
+    for (size_t span = 1; span < length; span <<= 1) {
+        size_t stride = length / (span << 1);   // twiddles for this stage are every stride-th root of unity
+        for (size_t start = 0; start < length; start += span << 1) {
+            for (size_t k = 0; k < span; k++) {
+                q15_butterfly(data + start + k, data + start + k + span, twiddles[k * stride]);
+            }
+        }
+    }
+}
+
+/**
+ * Encodes a real number as Q15, rounding to nearest with ties up, as the ALU's operations do, and saturating; in
+ * particular, 1.0 becomes Q15_MAX.
+ * @param value the real number
+ * @return the nearest Q15 value
+ */
+q15_t q15_from_double(double value) {
+    double scaled = floor(value * (1 << Q15_FRACTION) + 0.5);
+    if (scaled > INT16_MAX) {
+        return Q15_MAX;
+    } else if (scaled < INT16_MIN) {
+        return Q15_MIN;
+    } else {
+        return (q15_t) (int16_t) scaled;
+    }
+}
+
+/**
+ * Decodes a Q15 value exactly.
+ * @param value the Q15 value
+ * @return the value as a real number
+ */
+double q15_to_double(q15_t value) {
+    return (double) (int16_t) value / (1 << Q15_FRACTION);
+}
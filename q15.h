@@ -0,0 +1,54 @@
+/**************************************************************************//**
+ *
+ * @file q15.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations and function prototypes for Q15 fixed-point
+ *      arithmetic and signal-processing kernels, built on the ALU's signed
+ *      operations.
+ *
+ * A Q15 value is a 16-bit two's complement integer read as a multiple of
+ * 2**-15, covering [-1, 1 - 2**-15]. Every operation saturates: a result
+ * beyond the range is clamped to Q15_MIN or Q15_MAX instead of wrapping.
+ * Products are rounded to nearest, with halfway cases rounded up.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef Q15_H
+#define Q15_H
+
+#include <stddef.h>
+#include "alu_extensions.h"
+
+#define Q15_MAX         0x7FFF      // 1 - 2**-15
+#define Q15_MIN         0x8000      // -1
+#define Q15_FRACTION    15
+
+typedef uint16_t q15_t;
+
+typedef struct {
+    q15_t real;
+    q15_t imaginary;
+} q15_complex_t;
+
+q15_t q15_add(q15_t augend, q15_t addend);
+q15_t q15_subtract(q15_t menuend, q15_t subtrahend);
+q15_t q15_multiply(q15_t multiplicand, q15_t multiplier);
+
+q15_t q15_dot_product(const q15_t *vector1, const q15_t *vector2, size_t length);
+void q15_fir(const q15_t *coefficients, size_t taps, const q15_t *input, q15_t *output, size_t count);
+bool q15_moving_average(const q15_t *input, q15_t *output, size_t count, uint16_t window);
+void q15_butterfly(q15_complex_t *top, q15_complex_t *bottom, q15_complex_t twiddle);
+void q15_fft(q15_complex_t *data, const q15_complex_t *twiddles, size_t length);
+void q15_fft_twiddles(q15_complex_t *twiddles, size_t length) __attribute__ ((no_instrument_function));
+
+q15_t q15_from_double(double value) __attribute__ ((no_instrument_function));
+double q15_to_double(q15_t value) __attribute__ ((no_instrument_function));
+
+#endif //Q15_H
@@ -0,0 +1,379 @@
+/**************************************************************************//**
+ *
+ * @file sampler.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief A statistical profiler that samples the program counter and a
+ *      frame-pointer backtrace on each tick of the process's profiling timer.
+ *
+ * setitimer(ITIMER_PROF) delivers SIGPROF after each interval of CPU time.
+ * The kernel may round the interval up to its own timer tick.
+ * The handler copies the interrupted PC out of its ucontext. It then follows
+ * the chain of saved frame pointers, taking each frame's return address,
+ * while the chain stays inside the stack of the thread that started the
+ * sampler. Samples interrupted on other threads keep only their PC.
+ *
+ * The handler takes no locks and makes no calls. It reserves a slot in a
+ * fixed buffer with an atomic add, fills it in, and publishes it with a
+ * release store of the slot's sequence number. Any number of threads can be
+ * interrupted at once. A sample that finds the buffer full is counted and
+ * discarded.
+ *
+ * Symbols are resolved only when a report is written, with dladdr(). The
+ * executable is linked with -rdynamic so that its functions, and in
+ * particular the ALU's, are in the dynamic symbol table. Static functions are
+ * not in that table, and their samples are reported as [unknown]. The flat
+ * report gives each function's self samples (it was the one interrupted) and
+ * total samples (it was anywhere on the stack). The folded report has one
+ * line per distinct stack, root first, in the format that flame-graph tools
+ * read.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include "sampler.h"
+
+#define SYMBOL_CACHE_SLOTS  (1 << 14)   // a power of two, well beyond the distinct addresses in a report
+#define PATH_LENGTH         256
+#define NO_SYMBOL           SIZE_MAX    // resolve could not grow the symbol table
+
+typedef struct {
+    uint32_t published;                 // the slot's sequence number plus one, once its frames are written
+    uint32_t depth;
+    uintptr_t frames[SAMPLER_DEPTH];    // the interrupted PC, then return addresses from the innermost caller outward
+} sample_t;
+
+typedef struct {
+    const void *start;                  // the function's entry point, or NULL for unresolved addresses
+    const char *name;
+    uint64_t self;
+    uint64_t total;
+    uint64_t last_sample;               // the last sample counted in total, so that recursion counts once
+} symbol_t;
+
+typedef struct {
+    struct {
+        uintptr_t address;
+        size_t symbol;
+    } slots[SYMBOL_CACHE_SLOTS];
+    size_t used;
+} symbol_cache_t;
+
+typedef struct {
+    uint32_t depth;
+    size_t symbols[SAMPLER_DEPTH];      // root first
+} backtrace_t;
+
+static void take_sample(int signal, siginfo_t *information, void *context) __attribute__ ((no_instrument_function));
+static void stop_at_exit(void) __attribute__ ((no_instrument_function));
+static size_t resolve(uintptr_t address, symbol_t **symbols, size_t *count, size_t *capacity,
+                      symbol_cache_t *cache) __attribute__ ((no_instrument_function));
+static int compare_stacks(const void *stack1, const void *stack2) __attribute__ ((no_instrument_function));
+static int compare_self(const void *symbol1, const void *symbol2) __attribute__ ((no_instrument_function));
+
+static sample_t buffer[SAMPLER_CAPACITY];
+static uint32_t reserved;
+static uint64_t dropped;
+static uintptr_t stack_low, stack_high;
+static bool running;
+static bool exit_handler_registered;
+static char report_prefix[PATH_LENGTH];
+static struct sigaction previous_action;
+
+static void take_sample(int signal, siginfo_t *information, void *context) {
+    int saved_errno = errno;
+    uint32_t sequence = __atomic_fetch_add(&reserved, 1, __ATOMIC_RELAXED);
+    if (sequence >= SAMPLER_CAPACITY) {
+        __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+        errno = saved_errno;
+        return;
+    }
+    const ucontext_t *interrupted = context;
+    uintptr_t pc = 0, frame = 0, stack_pointer = 0;
+#if defined(__x86_64__)
+    pc = (uintptr_t) interrupted->uc_mcontext.gregs[REG_RIP];
+    frame = (uintptr_t) interrupted->uc_mcontext.gregs[REG_RBP];
+    stack_pointer = (uintptr_t) interrupted->uc_mcontext.gregs[REG_RSP];
+#elif defined(__aarch64__)
+    pc = (uintptr_t) interrupted->uc_mcontext.pc;
+    frame = (uintptr_t) interrupted->uc_mcontext.regs[29];
+    stack_pointer = (uintptr_t) interrupted->uc_mcontext.sp;
+#endif
+    sample_t *sample = buffer + sequence;
+    uint32_t depth = 0;
+    sample->frames[depth++] = pc;
+    // each frame record is the caller's frame pointer followed by the return address; the chain only moves outward
+    bool on_known_stack = stack_low <= stack_pointer && stack_pointer < stack_high;
+    while (on_known_stack && depth < SAMPLER_DEPTH && frame >= stack_pointer && !(frame % sizeof(uintptr_t))
+           && frame + 2 * sizeof(uintptr_t) <= stack_high) {
+        const uintptr_t *record = (const uintptr_t *) frame;
+        if (!record[1]) {
+            break;
+        }
+        sample->frames[depth++] = record[1];
+        if (record[0] <= frame) {
+            break;
+        }
+        frame = record[0];
+    }
+    sample->depth = depth;
+    __atomic_store_n(&sample->published, sequence + 1, __ATOMIC_RELEASE);
+    errno = saved_errno;
+}
+
+static void stop_at_exit(void) {
+    sampler_stop(NULL);
+}
+
+/* finds or adds the symbol for an address, remembering the answer for the next sample with the same address;
+ * returns NO_SYMBOL if a new symbol does not fit and the table cannot grow */
+static size_t resolve(uintptr_t address, symbol_t **symbols, size_t *count, size_t *capacity, symbol_cache_t *cache) {
+    size_t slot = (address >> 2) & (SYMBOL_CACHE_SLOTS - 1);
+    while (cache->slots[slot].address && cache->slots[slot].address != address) {
+        slot = (slot + 1) & (SYMBOL_CACHE_SLOTS - 1);
+    }
+    if (cache->slots[slot].address == address) {
+        return cache->slots[slot].symbol;
+    }
+    Dl_info information;
+    const void *start = NULL;
+    const char *name = "[unknown]";
+    if (dladdr((void *) address, &information) && information.dli_sname) {
+        start = information.dli_saddr;
+        name = information.dli_sname;
+    }
+    size_t symbol = 0;
+    while (symbol < *count && (*symbols)[symbol].start != start) {
+        symbol++;
+    }
+    if (symbol == *count) {
+        if (*count == *capacity) {
+            size_t grown = *capacity ? 2 * *capacity : 64;
+            symbol_t *table = realloc(*symbols, grown * sizeof(symbol_t));
+            if (!table) {
+                return NO_SYMBOL;
+            }
+            *symbols = table;
+            *capacity = grown;
+        }
+        (*symbols)[(*count)++] = (symbol_t) {start, name, 0, 0, 0};
+    }
+    // past half full, probing slows down; later addresses are resolved each time instead
+    if (cache->used < SYMBOL_CACHE_SLOTS / 2) {
+        cache->slots[slot].address = address;
+        cache->slots[slot].symbol = symbol;
+        cache->used++;
+    }
+    return symbol;
+}
+
+static int compare_stacks(const void *stack1, const void *stack2) {
+    const backtrace_t *first = stack1, *second = stack2;
+    for (uint32_t i = 0; i < first->depth && i < second->depth; i++) {
+        if (first->symbols[i] != second->symbols[i]) {
+            return first->symbols[i] < second->symbols[i] ? -1 : 1;
+        }
+    }
+    return (first->depth > second->depth) - (first->depth < second->depth);
+}
+
+static int compare_self(const void *symbol1, const void *symbol2) {
+    const symbol_t *first = symbol1, *second = symbol2;
+    if (first->self != second->self) {
+        return first->self < second->self ? 1 : -1;
+    }
+    return (first->total < second->total) - (first->total > second->total);
+}
+
+/**
+ * Starts sampling every thread of the process. Backtraces are taken only on the calling thread's stack.
+ * @param interval_microseconds the CPU time between samples; 0 selects <code>SAMPLER_DEFAULT_INTERVAL</code>
+ * @param path_prefix if not <code>NULL</code>, <code>sampler_stop</code> (or the program's exit, if the sampler is
+ * still running) writes the flat report to <i>path_prefix</i>.flat and the folded stacks to <i>path_prefix</i>.folded
+ * @return 1 if sampling started; 0 if the sampler was already running or the timer could not be set
+ */
+bool sampler_start(unsigned int interval_microseconds, const char *path_prefix) {
+    if (running) {
+        return false;
+    }
+    pthread_attr_t attributes;
+    void *stack_address;
+    size_t stack_size;
+    stack_low = stack_high = 0;
+    if (!pthread_getattr_np(pthread_self(), &attributes)) {
+        if (!pthread_attr_getstack(&attributes, &stack_address, &stack_size)) {
+            stack_low = (uintptr_t) stack_address;
+            stack_high = stack_low + stack_size;
+        }
+        pthread_attr_destroy(&attributes);
+    }
+    memset(buffer, 0, sizeof(buffer));
+    __atomic_store_n(&reserved, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&dropped, 0, __ATOMIC_RELAXED);
+    snprintf(report_prefix, sizeof(report_prefix), "%s", path_prefix ? path_prefix : "");
+    if (!exit_handler_registered) {
+        exit_handler_registered = !atexit(stop_at_exit);
+    }
+    struct sigaction action = {.sa_sigaction = take_sample, .sa_flags = SA_SIGINFO | SA_RESTART};
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &previous_action)) {
+        return false;
+    }
+    interval_microseconds = interval_microseconds ? interval_microseconds : SAMPLER_DEFAULT_INTERVAL;
+    struct itimerval timer = {
+            .it_interval = {.tv_sec = interval_microseconds / 1000000, .tv_usec = interval_microseconds % 1000000},
+            .it_value = {.tv_sec = interval_microseconds / 1000000, .tv_usec = interval_microseconds % 1000000}
+    };
+    if (setitimer(ITIMER_PROF, &timer, NULL)) {
+        sigaction(SIGPROF, &previous_action, NULL);
+        return false;
+    }
+    running = true;
+    return true;
+}
+
+/**
+ * Stops sampling and, if <code>sampler_start</code> was given a path prefix, writes both reports there. The samples
+ * remain available to <code>sampler_report</code> until the sampler is started again.
+ * @param summary if not <code>NULL</code>, receives the number of samples taken and dropped, and, if the reports were
+ * written, the number of distinct functions in them
+ * @return 1 if the sampler had been running; 0 otherwise
+ */
+bool sampler_stop(sampler_summary_t *summary) {
+    if (!running) {
+        return false;
+    }
+    struct itimerval disarmed = {};
+    setitimer(ITIMER_PROF, &disarmed, NULL);
+    sigaction(SIGPROF, &previous_action, NULL);
+    running = false;
+    sampler_summary_t counts = {};
+    if (report_prefix[0]) {
+        char flat_path[PATH_LENGTH + 8], folded_path[PATH_LENGTH + 8];
+        snprintf(flat_path, sizeof(flat_path), "%s.flat", report_prefix);
+        snprintf(folded_path, sizeof(folded_path), "%s.folded", report_prefix);
+        FILE *flat = fopen(flat_path, "w");
+        FILE *folded = fopen(folded_path, "w");
+        sampler_report(flat, folded, SIZE_MAX, &counts);
+        if (flat) {
+            fclose(flat);
+        }
+        if (folded) {
+            fclose(folded);
+        }
+    } else {
+        sampler_report(NULL, NULL, 0, &counts);
+    }
+    if (summary) {
+        *summary = counts;
+    }
+    return true;
+}
+
+/**
+ * Symbolizes the samples taken since the sampler was last started and writes the reports. Samples are only read, so
+ * the reports can be written more than once, and while the sampler is running. If memory runs out, the flat report
+ * says so: without room for the backtraces no samples are reported, and if the symbol table cannot grow only the
+ * samples symbolized before then are.
+ * @param flat where the flat report is written, most self samples first; may be <code>NULL</code>
+ * @param folded where the folded stacks are written; may be <code>NULL</code>
+ * @param flat_lines the most functions to list in the flat report
+ * @param summary if not <code>NULL</code>, receives the number of samples reported and dropped and the number of
+ * distinct functions
+ */
+void sampler_report(FILE *flat, FILE *folded, size_t flat_lines, sampler_summary_t *summary) {
+    uint32_t available = __atomic_load_n(&reserved, __ATOMIC_RELAXED);
+    available = available < SAMPLER_CAPACITY ? available : SAMPLER_CAPACITY;
+    backtrace_t *stacks = malloc((available ? available : 1) * sizeof(backtrace_t));
+    symbol_cache_t *cache = calloc(1, sizeof(symbol_cache_t));
+    if (!stacks || !cache) {
+        free(stacks);
+        free(cache);
+        if (flat) {
+            fprintf(flat, "not enough memory to symbolize %" PRIu32 " samples\n", available);
+        }
+        if (summary) {
+            *summary = (sampler_summary_t) {.dropped = __atomic_load_n(&dropped, __ATOMIC_RELAXED)};
+        }
+        return;
+    }
+    symbol_t *symbols = NULL;
+    size_t number_of_symbols = 0, symbol_capacity = 0;
+    uint64_t samples = 0;
+    bool exhausted = false;
+    for (uint32_t sequence = 0; sequence < available && !exhausted; sequence++) {
+        const sample_t *sample = buffer + sequence;
+        if (__atomic_load_n(&sample->published, __ATOMIC_ACQUIRE) != sequence + 1) {
+            continue;                   // a handler is still writing it
+        }
+        backtrace_t *stack = stacks + samples;
+        stack->depth = sample->depth;
+        for (uint32_t frame = 0; frame < sample->depth && !exhausted; frame++) {
+            // a return address is just past its call, which may be the last instruction of the caller
+            uintptr_t address = frame ? sample->frames[frame] - 1 : sample->frames[frame];
+            size_t symbol = resolve(address, &symbols, &number_of_symbols, &symbol_capacity, cache);
+            stack->symbols[sample->depth - 1 - frame] = symbol;
+            exhausted = symbol == NO_SYMBOL;
+        }
+        if (!exhausted) {
+            samples++;
+            for (uint32_t frame = 0; frame < stack->depth; frame++) {
+                symbol_t *symbol = symbols + stack->symbols[frame];
+                if (symbol->last_sample != samples) {
+                    symbol->last_sample = samples;
+                    symbol->total++;
+                }
+            }
+            symbols[stack->symbols[stack->depth - 1]].self++;
+        }
+    }
+    if (folded) {
+        qsort(stacks, samples, sizeof(backtrace_t), compare_stacks);
+        for (uint64_t first = 0, next; first < samples; first = next) {
+            for (next = first + 1; next < samples && !compare_stacks(stacks + first, stacks + next); next++) {}
+            for (uint32_t frame = 0; frame < stacks[first].depth; frame++) {
+                fprintf(folded, "%s%s", frame ? ";" : "", symbols[stacks[first].symbols[frame]].name);
+            }
+            fprintf(folded, " %" PRIu64 "\n", next - first);
+        }
+    }
+    if (flat) {
+        uint64_t lost = __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+        qsort(symbols, number_of_symbols, sizeof(symbol_t), compare_self);
+        fprintf(flat, "%" PRIu64 " samples, %" PRIu64 " dropped, %zu functions\n", samples, lost, number_of_symbols);
+        if (exhausted) {
+            fprintf(flat, "not enough memory to symbolize the samples after the first %" PRIu64 "\n", samples);
+        }
+        fprintf(flat, "%8s %7s %8s %7s  %s\n", "self", "self%", "total", "total%", "function");
+        double percent = samples ? 100.0 / (double) samples : 0;
+        for (size_t i = 0; i < number_of_symbols && i < flat_lines; i++) {
+            fprintf(flat, "%8" PRIu64 " %6.2f%% %8" PRIu64 " %6.2f%%  %s\n", symbols[i].self,
+                    percent * (double) symbols[i].self, symbols[i].total, percent * (double) symbols[i].total,
+                    symbols[i].name);
+        }
+    }
+    if (summary) {
+        summary->samples = samples;
+        summary->dropped = __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+        summary->symbols = number_of_symbols;
+    }
+    free(stacks);
+    free(cache);
+    free(symbols);
+}
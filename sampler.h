@@ -0,0 +1,45 @@
+/**************************************************************************//**
+ *
+ * @file sampler.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes for the statistical sampling profiler, which
+ *      records where the program is at each tick of a profiling timer instead
+ *      of counting every call.
+ *
+ * The sampler works in any build. It is meant for uninstrumented, optimized
+ * builds, where -finstrument-functions' hooks do not inflate the cost of the
+ * smallest ALU functions, and frame pointers make the backtraces complete:
+ *
+ *      make INSTRUMENT= OPTIMIZE=-O2
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SAMPLER_DEFAULT_INTERVAL    1000        // microseconds of CPU time between samples
+#define SAMPLER_DEPTH               16          // the interrupted PC and up to 15 return addresses
+#define SAMPLER_CAPACITY            (1 << 15)   // samples held between a start and a report; later ones are dropped
+
+typedef struct {
+    uint64_t samples;
+    uint64_t dropped;                   // taken while the ring was full
+    uint64_t symbols;                   // distinct functions in the reports
+} sampler_summary_t;
+
+bool sampler_start(unsigned int interval_microseconds, const char *path_prefix) __attribute__ ((no_instrument_function));
+bool sampler_stop(sampler_summary_t *summary) __attribute__ ((no_instrument_function));
+void sampler_report(FILE *flat, FILE *folded, size_t flat_lines, sampler_summary_t *summary) __attribute__ ((no_instrument_function));
+
+#endif //SAMPLER_H
@@ -0,0 +1,665 @@
+/**************************************************************************//**
+ *
+ * @file server.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief A long-running ALU evaluation server on a Unix domain socket.
+ *
+ * One thread multiplexes the listening socket and every client with epoll;
+ * it parses request frames and hands each batch to a pool of worker threads,
+ * which run the ALU and hand the finished response back through a completion
+ * list, waking the epoll thread with an eventfd. Every request on a
+ * connection is numbered as it arrives, and responses are written strictly in
+ * that order no matter which worker finishes first, so clients can pipeline
+ * requests. A connection that has too many batches outstanding, or too much
+ * unsent output, stops being read until it catches up.
+ *
+ * The workers run alu_inline.h's uninstrumented twin of the ALU, so that
+ * concurrent threads never touch the profiler's shared call counters.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "alu_inline.h"
+#include "trace.h"
+#include "benchmark.h"
+#include "server.h"
+
+#define SERVER_BACKLOG              64
+#define SERVER_MAXIMUM_WORKERS      16
+#define SERVER_EVENTS               64
+#define SERVER_POLL_MILLISECONDS    200         // how long a stop request can go unnoticed
+#define SERVER_READ_SIZE            (64 * 1024)
+#define SERVER_OUTSTANDING_LIMIT    64          // batches per connection before reading pauses
+#define SERVER_OUTPUT_LIMIT         (4 << 20)   // unsent bytes per connection before reading pauses
+#define LATENCY_BUCKETS             64
+
+typedef struct connection connection_t;
+
+typedef struct job {
+    connection_t *connection;
+    uint64_t sequence;
+    uint64_t received;                          // when the request was parsed, in nanoseconds
+    uint32_t count;                             // the number of operations
+    bool immediate;                             // answered without a worker; not counted as a batch
+    uint8_t *operations;
+    uint8_t *response;                          // a complete frame
+    size_t response_length;
+    struct job *next;
+} job_t;
+
+struct connection {
+    int socket;
+    uint8_t *input;
+    size_t input_used;
+    size_t input_capacity;
+    uint8_t *output;
+    size_t output_used;
+    size_t output_sent;
+    size_t output_capacity;
+    uint64_t next_sequence;                     // the number given to the next request
+    uint64_t next_to_send;                      // the number of the next response to write
+    job_t *completed;                           // finished out of order, sorted by sequence
+    int outstanding;                            // requests not yet finished
+    uint32_t interest;                          // the epoll events currently registered
+    bool read_closed;                           // no more requests will be read
+    bool failed;                                // the socket is unusable; discard output
+    bool dead;                                  // awaiting release at the end of the event loop iteration
+    connection_t *next_dead;
+};
+
+static void *work(void *unused) __attribute__ ((no_instrument_function));
+static void execute(job_t *job) __attribute__ ((no_instrument_function));
+static job_t *new_job(connection_t *connection, uint32_t count, size_t response_length) __attribute__ ((no_instrument_function));
+static void free_job(job_t *job) __attribute__ ((no_instrument_function));
+static void put_word(uint8_t *destination, uint32_t word) __attribute__ ((no_instrument_function));
+static uint32_t get_word(const uint8_t *source) __attribute__ ((no_instrument_function));
+static bool append_output(connection_t *connection, const uint8_t *bytes, size_t length) __attribute__ ((no_instrument_function));
+static void respond_immediately(connection_t *connection, server_message_t type, const char *text) __attribute__ ((no_instrument_function));
+static void process_input(connection_t *connection) __attribute__ ((no_instrument_function));
+static void read_input(connection_t *connection) __attribute__ ((no_instrument_function));
+static void flush_output(connection_t *connection) __attribute__ ((no_instrument_function));
+static void deliver(job_t *job) __attribute__ ((no_instrument_function));
+static void update_interest(connection_t *connection) __attribute__ ((no_instrument_function));
+static void accept_connections(void) __attribute__ ((no_instrument_function));
+static void collect_completions(void) __attribute__ ((no_instrument_function));
+static void format_statistics(char *text, size_t size) __attribute__ ((no_instrument_function));
+static void handle_signal(int signal_number) __attribute__ ((no_instrument_function));
+
+static volatile sig_atomic_t stop_requested;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t available;
+    job_t *head;                                // pending work, oldest first
+    job_t *tail;
+    job_t *finished;                            // finished work, in no particular order
+    bool stopping;
+} queue = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, NULL, false};
+
+/* everything below is used only by the epoll thread */
+static int epoll_descriptor = -1;
+static int listener = -1;
+static int wake = -1;
+static int listener_marker, wake_marker;
+static connection_t *dead_connections;
+static int number_of_workers;
+
+static struct {
+    uint64_t started;
+    uint64_t connections_accepted;
+    uint64_t connections_open;
+    uint64_t batches;
+    uint64_t operations;
+    uint64_t outstanding;
+    uint64_t latency_total;
+    uint64_t latency_maximum;
+    uint64_t latency_histogram[LATENCY_BUCKETS];  // bucket i counts latencies below 2^(i+1) ns
+} statistics;
+
+static void put_word(uint8_t *destination, uint32_t word) {
+    for (int i = 0; i < 4; i++) {
+        destination[i] = (uint8_t) (word >> (8 * i));
+    }
+}
+
+static uint32_t get_word(const uint8_t *source) {
+    return (uint32_t) source[0] | (uint32_t) source[1] << 8 | (uint32_t) source[2] << 16 | (uint32_t) source[3] << 24;
+}
+
+/*
+ * WORKERS
+ */
+
+/* returns NULL, and marks the connection failed, if memory runs out */
+static job_t *new_job(connection_t *connection, uint32_t count, size_t response_length) {
+    job_t *job = calloc(1, sizeof(job_t));
+    uint8_t *response = malloc(response_length);
+    if (!job || !response) {
+        free(job);
+        free(response);
+        connection->failed = true;
+        return NULL;
+    }
+    job->connection = connection;
+    job->sequence = connection->next_sequence++;
+    job->received = benchmark_nanoseconds();
+    job->count = count;
+    job->response = response;
+    job->response_length = response_length;
+    connection->outstanding++;
+    statistics.outstanding++;
+    return job;
+}
+
+static void free_job(job_t *job) {
+    free(job->operations);
+    free(job->response);
+    free(job);
+}
+
+static void execute(job_t *job) {
+    uint8_t *result = job->response;
+    put_word(result, (uint32_t) (job->response_length - 4));
+    result[4] = SERVER_BATCH;
+    put_word(result + 5, job->count);
+    result += 9;
+    const uint8_t *operation = job->operations;
+    for (uint32_t i = 0; i < job->count; i++) {
+        uint16_t operand1 = (uint16_t) (operation[1] | operation[2] << 8);
+        uint16_t operand2 = (uint16_t) (operation[3] | operation[4] << 8);
+        alu_result_t outcome = {};
+        switch (operation[0]) {
+            case SERVER_ADD:
+                outcome = traced_add(operand1, operand2);
+                break;
+            case SERVER_SUBTRACT:
+                outcome = traced_subtract(operand1, operand2);
+                break;
+            case SERVER_UNSIGNED_MULTIPLY:
+                outcome = traced_unsigned_multiply(operand1, operand2);
+                break;
+            case SERVER_SIGNED_MULTIPLY:
+                outcome = traced_signed_multiply(operand1, operand2);
+                break;
+            case SERVER_UNSIGNED_DIVIDE:
+                outcome = traced_unsigned_divide(operand1, operand2);
+                break;
+            case SERVER_SIGNED_DIVIDE:
+                outcome = traced_signed_divide(operand1, operand2);
+                break;
+            default:
+                // the request was validated when it was parsed, so this is SERVER_COMPARE
+                outcome.result = traced_compare(operand1, operand2);
+        }
+        result[0] = (uint8_t) outcome.result;
+        result[1] = (uint8_t) (outcome.result >> 8);
+        result[2] = (uint8_t) outcome.supplemental_result;
+        result[3] = (uint8_t) (outcome.supplemental_result >> 8);
+        result[4] = (uint8_t) ((outcome.unsigned_overflow ? SERVER_UNSIGNED_OVERFLOW_BIT : 0)
+                               | (outcome.signed_overflow ? SERVER_SIGNED_OVERFLOW_BIT : 0)
+                               | (outcome.divide_by_zero ? SERVER_DIVIDE_BY_ZERO_BIT : 0));
+        result += SERVER_RESULT_SIZE;
+        operation += SERVER_OPERATION_SIZE;
+    }
+}
+
+static void *work(void *unused) {
+    uint64_t one = 1;
+    while (true) {
+        pthread_mutex_lock(&queue.lock);
+        while (!queue.head && !queue.stopping) {
+            pthread_cond_wait(&queue.available, &queue.lock);
+        }
+        job_t *job = queue.head;
+        if (job) {
+            queue.head = job->next;
+            queue.tail = queue.head ? queue.tail : NULL;
+        }
+        pthread_mutex_unlock(&queue.lock);
+        if (!job) {
+            return NULL;
+        }
+        execute(job);
+        pthread_mutex_lock(&queue.lock);
+        job->next = queue.finished;
+        queue.finished = job;
+        pthread_mutex_unlock(&queue.lock);
+        if (write(wake, &one, sizeof(one)) < 0) {
+            perror("server: eventfd");
+        }
+    }
+}
+
+/*
+ * CONNECTIONS
+ */
+
+static bool append_output(connection_t *connection, const uint8_t *bytes, size_t length) {
+    if (connection->output_used + length > connection->output_capacity) {
+        size_t capacity = connection->output_capacity ? connection->output_capacity : SERVER_READ_SIZE;
+        while (capacity < connection->output_used + length) {
+            capacity *= 2;
+        }
+        uint8_t *output = realloc(connection->output, capacity);
+        if (!output) {
+            connection->failed = true;
+            return false;
+        }
+        connection->output = output;
+        connection->output_capacity = capacity;
+    }
+    memcpy(connection->output + connection->output_used, bytes, length);
+    connection->output_used += length;
+    return true;
+}
+
+/* queues a response that needs no worker; it is still written in its request's turn */
+static void respond_immediately(connection_t *connection, server_message_t type, const char *text) {
+    size_t length = strlen(text);
+    job_t *job = new_job(connection, 0, 5 + length);
+    if (!job) {
+        return;
+    }
+    job->immediate = true;
+    put_word(job->response, (uint32_t) (1 + length));
+    job->response[4] = (uint8_t) type;
+    memcpy(job->response + 5, text, length);
+    deliver(job);
+}
+
+static void process_input(connection_t *connection) {
+    size_t consumed = 0;
+    while (!connection->read_closed && !connection->failed
+           && connection->outstanding < SERVER_OUTSTANDING_LIMIT
+           && connection->output_used - connection->output_sent < SERVER_OUTPUT_LIMIT
+           && connection->input_used - consumed >= 4) {
+        const uint8_t *frame = connection->input + consumed;
+        uint32_t length = get_word(frame);
+        if (length == 0 || length > SERVER_MAXIMUM_FRAME) {
+            respond_immediately(connection, SERVER_ERROR, "frame length is zero or too large");
+            connection->read_closed = true;
+        } else if (connection->input_used - consumed - 4 >= length) {
+            uint8_t type = frame[4];
+            uint32_t count = length >= 5 ? get_word(frame + 5) : 0;
+            if (type == SERVER_STATS && length == 1) {
+                char text[1024];
+                format_statistics(text, sizeof(text));
+                respond_immediately(connection, SERVER_STATS, text);
+            } else if (type != SERVER_BATCH || length < 5
+                       || (uint64_t) length != 5 + (uint64_t) count * SERVER_OPERATION_SIZE) {
+                respond_immediately(connection, SERVER_ERROR, "malformed request");
+                connection->read_closed = true;
+            } else {
+                bool valid = true;
+                for (uint32_t i = 0; i < count; i++) {
+                    valid = valid && frame[9 + i * SERVER_OPERATION_SIZE] < NUMBER_OF_SERVER_OPERATIONS;
+                }
+                if (!valid) {
+                    respond_immediately(connection, SERVER_ERROR, "unknown operation");
+                    connection->read_closed = true;
+                } else {
+                    uint8_t *operations = malloc((size_t) count * SERVER_OPERATION_SIZE + 1);
+                    size_t response_length = 9 + (size_t) count * SERVER_RESULT_SIZE;
+                    job_t *job = operations ? new_job(connection, count, response_length) : NULL;
+                    if (!job) {
+                        free(operations);
+                        connection->failed = true;
+                        break;
+                    }
+                    job->operations = operations;
+                    memcpy(job->operations, frame + 9, (size_t) count * SERVER_OPERATION_SIZE);
+                    pthread_mutex_lock(&queue.lock);
+                    if (queue.tail) {
+                        queue.tail->next = job;
+                    } else {
+                        queue.head = job;
+                    }
+                    queue.tail = job;
+                    pthread_cond_signal(&queue.available);
+                    pthread_mutex_unlock(&queue.lock);
+                }
+            }
+            consumed += 4 + length;
+        } else {
+            // wait for the rest of the frame
+            break;
+        }
+    }
+    memmove(connection->input, connection->input + consumed, connection->input_used - consumed);
+    connection->input_used -= consumed;
+}
+
+static void read_input(connection_t *connection) {
+    while (!connection->read_closed && !connection->failed) {
+        if (connection->input_capacity - connection->input_used < SERVER_READ_SIZE) {
+            // a frame may be up to SERVER_MAXIMUM_FRAME bytes, so the buffer grows to hold the largest one
+            size_t capacity = connection->input_used + SERVER_READ_SIZE;
+            if (capacity > SERVER_MAXIMUM_FRAME + 4 + SERVER_READ_SIZE) {
+                return;
+            }
+            uint8_t *input = realloc(connection->input, capacity);
+            if (!input) {
+                connection->failed = true;
+                return;
+            }
+            connection->input = input;
+            connection->input_capacity = capacity;
+        }
+        ssize_t received = recv(connection->socket, connection->input + connection->input_used,
+                                connection->input_capacity - connection->input_used, 0);
+        if (received > 0) {
+            connection->input_used += (size_t) received;
+            process_input(connection);
+            if (connection->outstanding >= SERVER_OUTSTANDING_LIMIT
+                || connection->output_used - connection->output_sent >= SERVER_OUTPUT_LIMIT) {
+                return;
+            }
+        } else if (received == 0) {
+            connection->read_closed = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return;
+        } else if (errno != EINTR) {
+            connection->failed = true;
+        }
+    }
+}
+
+static void flush_output(connection_t *connection) {
+    while (!connection->failed && connection->output_sent < connection->output_used) {
+        ssize_t sent = send(connection->socket, connection->output + connection->output_sent,
+                            connection->output_used - connection->output_sent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->output_sent += (size_t) sent;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        } else if (sent < 0 && errno != EINTR) {
+            connection->failed = true;
+        }
+    }
+    connection->output_used = 0;
+    connection->output_sent = 0;
+}
+
+static void update_interest(connection_t *connection) {
+    if (connection->dead) {
+        return;
+    }
+    bool unsent = connection->output_sent < connection->output_used;
+    if (connection->failed || (connection->read_closed && !connection->outstanding && !unsent)) {
+        // release the connection once this iteration's events no longer refer to it
+        epoll_ctl(epoll_descriptor, EPOLL_CTL_DEL, connection->socket, NULL);
+        connection->dead = true;
+        connection->next_dead = dead_connections;
+        dead_connections = connection;
+        return;
+    }
+    bool throttled = connection->outstanding >= SERVER_OUTSTANDING_LIMIT
+                     || connection->output_used - connection->output_sent >= SERVER_OUTPUT_LIMIT;
+    uint32_t interest = (connection->read_closed || throttled ? 0 : EPOLLIN) | (unsent ? EPOLLOUT : 0);
+    if (interest != connection->interest) {
+        struct epoll_event event = {.events = interest, .data.ptr = connection};
+        epoll_ctl(epoll_descriptor, EPOLL_CTL_MOD, connection->socket, &event);
+        connection->interest = interest;
+    }
+}
+
+static void deliver(job_t *job) {
+    connection_t *connection = job->connection;
+    connection->outstanding--;
+    statistics.outstanding--;
+    if (!job->immediate) {
+        uint64_t latency = benchmark_nanoseconds() - job->received;
+        int bucket = latency > 1 ? 63 - __builtin_clzll(latency) : 0;
+        statistics.batches++;
+        statistics.operations += job->count;
+        statistics.latency_total += latency;
+        statistics.latency_maximum = latency > statistics.latency_maximum ? latency : statistics.latency_maximum;
+        statistics.latency_histogram[bucket]++;
+    }
+    if (connection->failed) {
+        free_job(job);
+        return;
+    }
+    job_t **position = &connection->completed;
+    while (*position && (*position)->sequence < job->sequence) {
+        position = &(*position)->next;
+    }
+    job->next = *position;
+    *position = job;
+    while (connection->completed && connection->completed->sequence == connection->next_to_send) {
+        job_t *ready = connection->completed;
+        connection->completed = ready->next;
+        connection->next_to_send++;
+        append_output(connection, ready->response, ready->response_length);
+        free_job(ready);
+    }
+}
+
+static void accept_connections(void) {
+    while (true) {
+        int socket = accept(listener, NULL, NULL);
+        if (socket < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("server: accept");
+            }
+            return;
+        }
+        fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+        connection_t *connection = calloc(1, sizeof(connection_t));
+        if (!connection) {
+            perror("server: accept");
+            close(socket);
+            continue;
+        }
+        connection->socket = socket;
+        connection->interest = EPOLLIN;
+        struct epoll_event event = {.events = EPOLLIN, .data.ptr = connection};
+        epoll_ctl(epoll_descriptor, EPOLL_CTL_ADD, socket, &event);
+        statistics.connections_accepted++;
+        statistics.connections_open++;
+    }
+}
+
+static void collect_completions(void) {
+    uint64_t count;
+    if (read(wake, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        perror("server: eventfd");
+    }
+    pthread_mutex_lock(&queue.lock);
+    job_t *finished = queue.finished;
+    queue.finished = NULL;
+    pthread_mutex_unlock(&queue.lock);
+    while (finished) {
+        job_t *job = finished;
+        connection_t *connection = job->connection;
+        finished = job->next;
+        deliver(job);
+        // reading may have paused while this connection had too much work outstanding
+        process_input(connection);
+        flush_output(connection);
+        update_interest(connection);
+    }
+}
+
+static void format_statistics(char *text, size_t size) {
+    double uptime = (double) (benchmark_nanoseconds() - statistics.started) / 1e9;
+    uint64_t percentiles[2] = {0, 0};
+    uint64_t thresholds[2] = {(statistics.batches + 1) / 2, statistics.batches - statistics.batches / 100};
+    for (int p = 0; p < 2; p++) {
+        uint64_t cumulative = 0;
+        int bucket = 0;
+        while (bucket < LATENCY_BUCKETS - 1 && cumulative + statistics.latency_histogram[bucket] < thresholds[p]) {
+            cumulative += statistics.latency_histogram[bucket++];
+        }
+        percentiles[p] = statistics.batches ? (uint64_t) 2 << bucket : 0;
+    }
+    snprintf(text, size,
+             "uptime_seconds %.3f\n"
+             "workers %d\n"
+             "connections_accepted %llu\n"
+             "connections_open %llu\n"
+             "batches %llu\n"
+             "operations %llu\n"
+             "outstanding_requests %llu\n"
+             "operations_per_second %.1f\n"
+             "batch_latency_mean_microseconds %.1f\n"
+             "batch_latency_p50_microseconds_at_most %.1f\n"
+             "batch_latency_p99_microseconds_at_most %.1f\n"
+             "batch_latency_maximum_microseconds %.1f\n",
+             uptime, number_of_workers,
+             (unsigned long long) statistics.connections_accepted, (unsigned long long) statistics.connections_open,
+             (unsigned long long) statistics.batches, (unsigned long long) statistics.operations,
+             (unsigned long long) statistics.outstanding, (double) statistics.operations / uptime,
+             statistics.batches ? (double) statistics.latency_total / (double) statistics.batches / 1e3 : 0.0,
+             (double) percentiles[0] / 1e3, (double) percentiles[1] / 1e3,
+             (double) statistics.latency_maximum / 1e3);
+}
+
+/*
+ * SERVER
+ */
+
+static void handle_signal(int signal_number) {
+    stop_requested = 1;
+}
+
+/**
+ * Asks a running server to stop; it finishes within SERVER_POLL_MILLISECONDS. This may be called from any thread.
+ */
+void server_request_stop(void) {
+    stop_requested = 1;
+}
+
+/**
+ * Serves ALU requests on a Unix domain socket until SIGINT, SIGTERM, or <code>server_request_stop</code>.
+ * @param path the socket's path; a stale socket left by a server that is no longer running is replaced
+ * @param workers the number of worker threads, or 0 for one per online processor
+ * @return 0 if the server ran and stopped cleanly; 1 if it could not start
+ */
+int server_run(const char *path, int workers) {
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    struct sigaction action = {.sa_handler = handle_signal}, old_interrupt, old_terminate;
+    pthread_t threads[SERVER_MAXIMUM_WORKERS];
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "server: socket path is too long\n");
+        return 1;
+    }
+    strcpy(address.sun_path, path);
+    // refuse to displace a live server, but replace a stale socket
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe >= 0 && !connect(probe, (struct sockaddr *) &address, sizeof(address))) {
+        fprintf(stderr, "server: another server is listening on %s\n", path);
+        close(probe);
+        return 1;
+    }
+    if (probe >= 0) {
+        close(probe);
+    }
+    unlink(path);
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listener < 0 || bind(listener, (struct sockaddr *) &address, sizeof(address)) < 0
+        || listen(listener, SERVER_BACKLOG) < 0) {
+        perror("server");
+        if (listener >= 0) {
+            close(listener);
+        }
+        return 1;
+    }
+    epoll_descriptor = epoll_create1(0);
+    wake = eventfd(0, EFD_NONBLOCK);
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = &listener_marker};
+    epoll_ctl(epoll_descriptor, EPOLL_CTL_ADD, listener, &event);
+    event.data.ptr = &wake_marker;
+    epoll_ctl(epoll_descriptor, EPOLL_CTL_ADD, wake, &event);
+    memset(&statistics, 0, sizeof(statistics));
+    statistics.started = benchmark_nanoseconds();
+    number_of_workers = workers > 0 ? workers : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    number_of_workers = number_of_workers < 1 ? 1 : number_of_workers;
+    number_of_workers = number_of_workers > SERVER_MAXIMUM_WORKERS ? SERVER_MAXIMUM_WORKERS : number_of_workers;
+    queue.stopping = false;
+    for (int i = 0; i < number_of_workers; i++) {
+        pthread_create(threads + i, NULL, work, NULL);
+    }
+    stop_requested = 0;
+    sigaction(SIGINT, &action, &old_interrupt);
+    sigaction(SIGTERM, &action, &old_terminate);
+    while (!stop_requested) {
+        struct epoll_event events[SERVER_EVENTS];
+        int number_of_events = epoll_wait(epoll_descriptor, events, SERVER_EVENTS, SERVER_POLL_MILLISECONDS);
+        for (int i = 0; i < number_of_events; i++) {
+            if (events[i].data.ptr == &listener_marker) {
+                accept_connections();
+            } else if (events[i].data.ptr == &wake_marker) {
+                collect_completions();
+            } else {
+                connection_t *connection = events[i].data.ptr;
+                if (connection->dead) {
+                    continue;
+                }
+                if (events[i].events & EPOLLIN) {
+                    read_input(connection);
+                }
+                if (events[i].events & (EPOLLERR | EPOLLHUP) && !(events[i].events & EPOLLIN)) {
+                    connection->failed = true;
+                }
+                flush_output(connection);
+                update_interest(connection);
+            }
+        }
+        while (dead_connections) {
+            connection_t *connection = dead_connections;
+            dead_connections = connection->next_dead;
+            if (connection->outstanding) {
+                // workers still hold its jobs; keep it until they are delivered
+                connection->dead = false;
+                continue;
+            }
+            while (connection->completed) {
+                job_t *job = connection->completed;
+                connection->completed = job->next;
+                free_job(job);
+            }
+            close(connection->socket);
+            free(connection->input);
+            free(connection->output);
+            free(connection);
+            statistics.connections_open--;
+        }
+    }
+    sigaction(SIGINT, &old_interrupt, NULL);
+    sigaction(SIGTERM, &old_terminate, NULL);
+    pthread_mutex_lock(&queue.lock);
+    queue.stopping = true;
+    pthread_cond_broadcast(&queue.available);
+    pthread_mutex_unlock(&queue.lock);
+    for (int i = 0; i < number_of_workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    // connections and their unfinished jobs are abandoned along with the process's other state
+    close(listener);
+    close(wake);
+    close(epoll_descriptor);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**************************************************************************//**
+ *
+ * @file server.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Protocol definitions and function prototypes for the ALU evaluation
+ *      server, which answers batches of operations over a Unix domain socket.
+ *
+ * Every message in either direction is a frame: a 32-bit little-endian length
+ * (of everything after the length field), a one-byte message type, and the
+ * message's body. A client may send any number of requests without waiting;
+ * the server answers each connection's requests in the order they arrived.
+ *
+ *  SERVER_BATCH request    a 32-bit count, then that many 5-byte operations:
+ *                          the server_operation_t and two 16-bit operands
+ *  SERVER_BATCH response   a 32-bit count, then that many 5-byte results:
+ *                          the 16-bit result, the 16-bit supplemental result,
+ *                          and the SERVER_*_BIT flags
+ *  SERVER_STATS request    no body
+ *  SERVER_STATS response   "name value" lines of text
+ *  SERVER_ERROR response   a message explaining why the server is closing
+ *                          the connection
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+
+#define SERVER_MAXIMUM_FRAME            (1 << 20)
+#define SERVER_OPERATION_SIZE           5
+#define SERVER_RESULT_SIZE              5
+
+#define SERVER_UNSIGNED_OVERFLOW_BIT    0x1
+#define SERVER_SIGNED_OVERFLOW_BIT      0x2
+#define SERVER_DIVIDE_BY_ZERO_BIT       0x4
+
+typedef enum {
+    SERVER_BATCH = 1,
+    SERVER_STATS = 2,
+    SERVER_ERROR = 0xFF
+} server_message_t;
+
+/* compare's flags are returned in the result field */
+typedef enum {
+    SERVER_ADD = 0,
+    SERVER_SUBTRACT,
+    SERVER_UNSIGNED_MULTIPLY,
+    SERVER_SIGNED_MULTIPLY,
+    SERVER_UNSIGNED_DIVIDE,
+    SERVER_SIGNED_DIVIDE,
+    SERVER_COMPARE,
+    NUMBER_OF_SERVER_OPERATIONS
+} server_operation_t;
+
+int server_run(const char *path, int number_of_workers) __attribute__ ((no_instrument_function));
+void server_request_stop(void) __attribute__ ((no_instrument_function));
+
+#endif //SERVER_H
@@ -0,0 +1,264 @@
+/**************************************************************************//**
+ *
+ * @file swar.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief SIMD-within-a-register arithmetic on four 16-bit lanes packed into a
+ *      uint64_t.
+ *
+ * Each lane's most-significant bit is handled separately from its other 15
+ * bits, so that a carry or borrow can never cross a lane boundary. Nothing
+ * here needs intrinsics, so the batch loops can be vectorised on any 64-bit
+ * target.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#include "swar.h"
+
+/**
+ * Packs four 16-bit values into one word; lane 0 is the least-significant.
+ * @param lanes the values to be packed
+ * @return the packed word
+ */
+uint64_t swar_pack(const uint16_t lanes[SWAR_LANES]) {
+    uint64_t packed = 0;
+    for (int i = SWAR_LANES - 1; i >= 0; i--) {
+        packed = (packed << 16) | lanes[i];
+    }
+    return packed;
+}
+
+/**
+ * Unpacks one word into four 16-bit values; lane 0 is the least-significant.
+ * @param packed the packed word
+ * @param lanes the array that receives the values
+ */
+void swar_unpack(uint64_t packed, uint16_t lanes[SWAR_LANES]) {
+    for (int i = 0; i < SWAR_LANES; i++) {
+        lanes[i] = (uint16_t) (packed >> (16 * i));
+    }
+}
+
+/**
+ * Adds four pairs of 16-bit integers lane by lane. The flags have the same meaning as those of <code>add</code>.
+ * @param augends the packed numbers to be added to
+ * @param addends the packed numbers to be added to the augends
+ * @return the packed sums, and each lane's <code>unsigned_overflow</code> and <code>signed_overflow</code> flags
+ */
+swar_result_t swar_add(uint64_t augends, uint64_t addends) {
+    swar_result_t sums;
+    // the low 15 bits of two lanes cannot carry past the lane's most-significant bit
+    uint64_t low_sums = (augends & SWAR_LOW_BITS) + (addends & SWAR_LOW_BITS);
+    sums.result = low_sums ^ ((augends ^ addends) & SWAR_HIGH_BITS);
+    sums.unsigned_overflow = ((augends & addends) | ((augends | addends) & ~sums.result)) & SWAR_HIGH_BITS;
+    sums.signed_overflow = ~(augends ^ addends) & (augends ^ sums.result) & SWAR_HIGH_BITS;
+    return sums;
+}
+
+/**
+ * Subtracts four pairs of 16-bit integers lane by lane. The flags have the same meaning as those of
+ * <code>subtract</code>.
+ * @param menuends the packed numbers to be subtracted from
+ * @param subtrahends the packed numbers to be subtracted from the menuends
+ * @return the packed differences, and each lane's <code>unsigned_overflow</code> and <code>signed_overflow</code> flags
+ */
+swar_result_t swar_subtract(uint64_t menuends, uint64_t subtrahends) {
+    swar_result_t differences;
+    // forcing each minuend's most-significant bit on guarantees that no lane borrows from its neighbor
+    uint64_t low_differences = (menuends | SWAR_HIGH_BITS) - (subtrahends & SWAR_LOW_BITS);
+    differences.result = low_differences ^ ((menuends ^ ~subtrahends) & SWAR_HIGH_BITS);
+    differences.unsigned_overflow =
+            ((~menuends & subtrahends) | (~(menuends ^ subtrahends) & differences.result)) & SWAR_HIGH_BITS;
+    differences.signed_overflow = (menuends ^ subtrahends) & (menuends ^ differences.result) & SWAR_HIGH_BITS;
+    return differences;
+}
+
+/**
+ * Determines which lanes hold negative values when interpreted as two's complement signed integers.
+ * @param values the packed values to be evaluated
+ * @return a mask with all of a lane's bits set if that lane is negative
+ */
+uint64_t swar_is_negative(uint64_t values) {
+    return swar_lane_mask(values);
+}
+
+/**
+ * Compares four pairs of values lane by lane, producing the same flags that <code>compare</code> produces for each
+ * pair.
+ * @param values1 the packed values on the left side of the comparison
+ * @param values2 the packed values on the right side of the comparison
+ * @return each lane's condition flags, in that lane's most-significant bit
+ */
+swar_flags_t swar_compare(uint64_t values1, uint64_t values2) {
+    swar_flags_t flags;
+    swar_result_t differences = swar_subtract(values1, values2);
+    // a lane is non-zero if its high bit is set, or if adding 0x7FFF to its low bits carries into its high bit
+    uint64_t non_zero = (((differences.result & SWAR_LOW_BITS) + SWAR_LOW_BITS) | differences.result);
+    flags.zero = ~non_zero & SWAR_HIGH_BITS;
+    flags.sign = differences.result & SWAR_HIGH_BITS;
+    flags.overflow = differences.signed_overflow;
+    flags.carry = differences.unsigned_overflow;
+    return flags;
+}
+
+/**
+ * Determines which lanes of the first word equal the corresponding lanes of the second.
+ * @param values1 the packed values on the left side of the comparison
+ * @param values2 the packed values on the right side of the comparison
+ * @return a mask with all of a lane's bits set if that lane's values are equal
+ */
+uint64_t swar_equal(uint64_t values1, uint64_t values2) {
+    return swar_lane_mask(swar_compare(values1, values2).zero);
+}
+
+/**
+ * Determines which lanes of the first word differ from the corresponding lanes of the second.
+ * @param values1 the packed values on the left side of the comparison
+ * @param values2 the packed values on the right side of the comparison
+ * @return a mask with all of a lane's bits set if that lane's values are not equal
+ */
+uint64_t swar_not_equal(uint64_t values1, uint64_t values2) {
+    return ~swar_equal(values1, values2);
+}
+
+/**
+ * Determines, as signed integers, which lanes of the first word are strictly less than those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_less_than(uint64_t values1, uint64_t values2) {
+    swar_flags_t flags = swar_compare(values1, values2);
+    return swar_lane_mask(flags.sign ^ flags.overflow);
+}
+
+/**
+ * Determines, as signed integers, which lanes of the first word are at most those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_at_most(uint64_t values1, uint64_t values2) {
+    swar_flags_t flags = swar_compare(values1, values2);
+    return swar_lane_mask(flags.zero | (flags.sign ^ flags.overflow));
+}
+
+/**
+ * Determines, as signed integers, which lanes of the first word are at least those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_at_least(uint64_t values1, uint64_t values2) {
+    return ~swar_less_than(values1, values2);
+}
+
+/**
+ * Determines, as signed integers, which lanes of the first word are strictly greater than those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_greater_than(uint64_t values1, uint64_t values2) {
+    return ~swar_at_most(values1, values2);
+}
+
+/**
+ * Determines, as unsigned integers, which lanes of the first word are strictly less than those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_unsigned_less_than(uint64_t values1, uint64_t values2) {
+    return swar_lane_mask(swar_compare(values1, values2).carry);
+}
+
+/**
+ * Determines, as unsigned integers, which lanes of the first word are at most those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_unsigned_at_most(uint64_t values1, uint64_t values2) {
+    swar_flags_t flags = swar_compare(values1, values2);
+    return swar_lane_mask(flags.zero | flags.carry);
+}
+
+/**
+ * Determines, as unsigned integers, which lanes of the first word are at least those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_unsigned_at_least(uint64_t values1, uint64_t values2) {
+    return ~swar_unsigned_less_than(values1, values2);
+}
+
+/**
+ * Determines, as unsigned integers, which lanes of the first word are strictly greater than those of the second.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @return a mask with all of a lane's bits set if the relation holds for that lane
+ */
+uint64_t swar_unsigned_greater_than(uint64_t values1, uint64_t values2) {
+    return ~swar_unsigned_at_most(values1, values2);
+}
+
+/**
+ * Adds corresponding elements of two arrays of packed words.
+ * @param augends the packed numbers to be added to
+ * @param addends the packed numbers to be added to the augends
+ * @param sums the array that receives the packed sums and their flags
+ * @param count the number of packed words in each array
+ */
+void swar_add_batch(const uint64_t *augends, const uint64_t *addends, swar_result_t *sums, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        sums[i] = swar_add(augends[i], addends[i]);
+    }
+}
+
+/**
+ * Subtracts corresponding elements of two arrays of packed words.
+ * @param menuends the packed numbers to be subtracted from
+ * @param subtrahends the packed numbers to be subtracted from the menuends
+ * @param differences the array that receives the packed differences and their flags
+ * @param count the number of packed words in each array
+ */
+void swar_subtract_batch(const uint64_t *menuends, const uint64_t *subtrahends, swar_result_t *differences,
+                         size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        differences[i] = swar_subtract(menuends[i], subtrahends[i]);
+    }
+}
+
+/**
+ * Compares, as signed integers, corresponding elements of two arrays of packed words.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @param masks the array that receives the lane masks of <code>values1 &lt; values2</code>
+ * @param count the number of packed words in each array
+ */
+void swar_less_than_batch(const uint64_t *values1, const uint64_t *values2, uint64_t *masks, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        masks[i] = swar_less_than(values1[i], values2[i]);
+    }
+}
+
+/**
+ * Compares, as unsigned integers, corresponding elements of two arrays of packed words.
+ * @param values1 the packed values on the left side of the inequality comparison
+ * @param values2 the packed values on the right side of the inequality comparison
+ * @param masks the array that receives the lane masks of <code>values1 &lt; values2</code>
+ * @param count the number of packed words in each array
+ */
+void swar_unsigned_less_than_batch(const uint64_t *values1, const uint64_t *values2, uint64_t *masks, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        masks[i] = swar_unsigned_less_than(values1[i], values2[i]);
+    }
+}
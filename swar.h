@@ -0,0 +1,71 @@
+/**************************************************************************//**
+ *
+ * @file swar.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Function prototypes, macros, and type declarations for SIMD-within-a-
+ *      register arithmetic on four 16-bit lanes packed into a uint64_t.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef SWAR_H
+#define SWAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lane i occupies bits 16i through 16i+15. A per-lane flag is reported in its lane's most-significant bit (the bit
+ * selected by SWAR_HIGH_BITS); a per-lane mask has all 16 bits of its lane set or clear.
+ */
+
+#define SWAR_LANES      4
+#define SWAR_HIGH_BITS  UINT64_C(0x8000800080008000)
+#define SWAR_LOW_BITS   UINT64_C(0x7FFF7FFF7FFF7FFF)
+
+#define swar_lane_mask(flags)   ((((flags) & SWAR_HIGH_BITS) >> 15) * 0xFFFF)
+
+typedef struct {
+    uint64_t result;
+    uint64_t unsigned_overflow;
+    uint64_t signed_overflow;
+} swar_result_t;
+
+typedef struct {
+    uint64_t zero;
+    uint64_t sign;
+    uint64_t overflow;
+    uint64_t carry;     // set when the lane's subtraction borrows
+} swar_flags_t;
+
+uint64_t swar_pack(const uint16_t lanes[SWAR_LANES]) __attribute__ ((no_instrument_function));
+void swar_unpack(uint64_t packed, uint16_t lanes[SWAR_LANES]) __attribute__ ((no_instrument_function));
+
+swar_result_t swar_add(uint64_t augends, uint64_t addends) __attribute__ ((no_instrument_function));
+swar_result_t swar_subtract(uint64_t menuends, uint64_t subtrahends) __attribute__ ((no_instrument_function));
+uint64_t swar_is_negative(uint64_t values) __attribute__ ((no_instrument_function));
+swar_flags_t swar_compare(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+
+uint64_t swar_equal(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_not_equal(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_less_than(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_at_most(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_at_least(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_greater_than(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_unsigned_less_than(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_unsigned_at_most(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_unsigned_at_least(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+uint64_t swar_unsigned_greater_than(uint64_t values1, uint64_t values2) __attribute__ ((no_instrument_function));
+
+void swar_add_batch(const uint64_t *augends, const uint64_t *addends, swar_result_t *sums, size_t count) __attribute__ ((no_instrument_function));
+void swar_subtract_batch(const uint64_t *menuends, const uint64_t *subtrahends, swar_result_t *differences, size_t count) __attribute__ ((no_instrument_function));
+void swar_less_than_batch(const uint64_t *values1, const uint64_t *values2, uint64_t *masks, size_t count) __attribute__ ((no_instrument_function));
+void swar_unsigned_less_than_batch(const uint64_t *values1, const uint64_t *values2, uint64_t *masks, size_t count) __attribute__ ((no_instrument_function));
+
+#endif //SWAR_H
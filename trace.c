@@ -0,0 +1,376 @@
+/**************************************************************************//**
+ *
+ * @file trace.c
+ *
+ * @author Sagun Karki
+ *
+ * @brief Recording of ALU calls to a compact binary trace, and replay of a
+ *      trace against the current build.
+ *
+ * Each thread records into its own buffer, so recording takes no locks. A
+ * full buffer is written out as one self-contained chunk: the writer reserves
+ * the chunk's place in the file with an atomic add and then writes it with
+ * pwrite, so concurrent threads never wait for each other.
+ *
+ * A trace is a 16-byte file header followed by chunks. Each chunk has a
+ * 16-byte header (the payload's length in bytes, the number of records, the
+ * recording thread's number, and a reserved word) and then its records. A
+ * record is one byte holding the function in its low four bits and the
+ * result's three flags in its next three bits, followed by four varints: the
+ * operands, result, and supplemental result, each stored as the zigzag-encoded
+ * 16-bit difference from the same field of the previous call to the same
+ * function in the same chunk. Loop counters and running sums therefore take
+ * one byte per field.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "benchmark.h"
+#include "trace.h"
+
+#define TRACE_MAGIC                 "ALUTRACE"
+#define TRACE_VERSION               1
+#define TRACE_FILE_HEADER_SIZE      16
+#define TRACE_CHUNK_HEADER_SIZE     16
+#define TRACE_BUFFER_SIZE           (64 * 1024)
+#define TRACE_LONGEST_RECORD        13          // the function byte and four three-byte varints
+#define TRACE_FIELDS                4
+
+typedef struct trace_buffer {
+    uint8_t data[TRACE_BUFFER_SIZE];
+    size_t used;                                // including the space reserved for the chunk header
+    uint32_t records;
+    uint32_t thread_number;
+    uint16_t previous[NUMBER_OF_TRACE_FUNCTIONS][TRACE_FIELDS];
+    struct trace_buffer *next;                  // every thread's buffer is on one list, so trace_stop can flush it
+} trace_buffer_t;
+
+typedef alu_result_t (*trace_operation_t)(uint16_t, uint16_t);
+
+static void reset_buffer(trace_buffer_t *buffer) __attribute__ ((no_instrument_function));
+static void flush_buffer(trace_buffer_t *buffer) __attribute__ ((no_instrument_function));
+static trace_buffer_t *thread_buffer(void) __attribute__ ((no_instrument_function));
+static uint8_t *encode(uint8_t *destination, uint16_t value, uint16_t *previous) __attribute__ ((no_instrument_function));
+static const uint8_t *decode(const uint8_t *source, const uint8_t *end, uint16_t *value, uint16_t *previous) __attribute__ ((no_instrument_function));
+static void put_word(uint8_t *destination, uint32_t word) __attribute__ ((no_instrument_function));
+static uint32_t get_word(const uint8_t *source) __attribute__ ((no_instrument_function));
+static alu_result_t compare_as_result(uint16_t value1, uint16_t value2) __attribute__ ((no_instrument_function));
+
+bool trace_recording = false;
+
+static int trace_file = -1;
+static uint64_t trace_file_end;
+static uint64_t trace_records;
+static uint64_t trace_dropped_records;             // calls not recorded because a thread had no buffer
+static uint32_t next_thread_number;
+static trace_buffer_t *trace_buffers;
+static __thread trace_buffer_t *current_buffer;
+
+static const char *function_names[NUMBER_OF_TRACE_FUNCTIONS] = {
+        [TRACE_ADD] = "add",
+        [TRACE_SUBTRACT] = "subtract",
+        [TRACE_UNSIGNED_MULTIPLY] = "unsigned_multiply",
+        [TRACE_SIGNED_MULTIPLY] = "signed_multiply",
+        [TRACE_UNSIGNED_DIVIDE] = "unsigned_divide",
+        [TRACE_SIGNED_DIVIDE] = "signed_divide",
+        [TRACE_COMPARE] = "compare",
+};
+
+static const trace_operation_t operations[NUMBER_OF_TRACE_FUNCTIONS] = {
+        [TRACE_ADD] = add,
+        [TRACE_SUBTRACT] = subtract,
+        [TRACE_UNSIGNED_MULTIPLY] = unsigned_multiply,
+        [TRACE_SIGNED_MULTIPLY] = signed_multiply,
+        [TRACE_UNSIGNED_DIVIDE] = unsigned_divide,
+        [TRACE_SIGNED_DIVIDE] = signed_divide,
+        [TRACE_COMPARE] = compare_as_result,
+};
+
+static alu_result_t compare_as_result(uint16_t value1, uint16_t value2) {
+    alu_result_t flags = {};
+    flags.result = compare(value1, value2);
+    return flags;
+}
+
+/**
+ * Names a traced function.
+ * @param function the traced function's identifier
+ * @return the ALU function's name
+ */
+const char *trace_function_name(trace_function_t function) {
+    return function < NUMBER_OF_TRACE_FUNCTIONS ? function_names[function] : "unknown";
+}
+
+static void put_word(uint8_t *destination, uint32_t word) {
+    for (int i = 0; i < 4; i++) {
+        destination[i] = (uint8_t) (word >> (8 * i));
+    }
+}
+
+static uint32_t get_word(const uint8_t *source) {
+    return (uint32_t) source[0] | (uint32_t) source[1] << 8 | (uint32_t) source[2] << 16 | (uint32_t) source[3] << 24;
+}
+
+/*
+ * RECORDING
+ */
+
+static uint8_t *encode(uint8_t *destination, uint16_t value, uint16_t *previous) {
+    int16_t difference = (int16_t) (uint16_t) (value - *previous);
+    uint32_t zigzag = (uint16_t) ((uint16_t) (difference << 1) ^ (uint16_t) (difference >> 15));
+    *previous = value;
+    while (zigzag >= 0x80) {
+        *destination++ = (uint8_t) (zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    *destination++ = (uint8_t) zigzag;
+    return destination;
+}
+
+static void reset_buffer(trace_buffer_t *buffer) {
+    buffer->used = TRACE_CHUNK_HEADER_SIZE;
+    buffer->records = 0;
+    memset(buffer->previous, 0, sizeof(buffer->previous));
+}
+
+static void flush_buffer(trace_buffer_t *buffer) {
+    if (buffer->records && trace_file >= 0) {
+        put_word(buffer->data, (uint32_t) (buffer->used - TRACE_CHUNK_HEADER_SIZE));
+        put_word(buffer->data + 4, buffer->records);
+        put_word(buffer->data + 8, buffer->thread_number);
+        put_word(buffer->data + 12, 0);
+        uint64_t offset = __atomic_fetch_add(&trace_file_end, buffer->used, __ATOMIC_RELAXED);
+        if (pwrite(trace_file, buffer->data, buffer->used, (off_t) offset) != (ssize_t) buffer->used) {
+            perror("trace");
+        }
+        __atomic_fetch_add(&trace_records, buffer->records, __ATOMIC_RELAXED);
+    }
+    reset_buffer(buffer);
+}
+
+/* returns NULL if the thread has no buffer and one cannot be allocated; the next call tries again */
+static trace_buffer_t *thread_buffer(void) {
+    if (!current_buffer) {
+        trace_buffer_t *buffer = malloc(sizeof(trace_buffer_t));
+        if (!buffer) {
+            return NULL;
+        }
+        buffer->thread_number = __atomic_fetch_add(&next_thread_number, 1, __ATOMIC_RELAXED);
+        reset_buffer(buffer);
+        buffer->next = __atomic_load_n(&trace_buffers, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&trace_buffers, &buffer->next, buffer, true,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {}
+        current_buffer = buffer;
+    }
+    return current_buffer;
+}
+
+/**
+ * Appends one ALU call to the calling thread's trace buffer, writing the buffer to the trace when it fills. The
+ * traced_ wrappers call this only while a trace is being recorded. If the calling thread has no buffer and one cannot
+ * be allocated, the call is dropped and counted instead.
+ * @param function the ALU function that was called
+ * @param operand1 the function's first argument
+ * @param operand2 the function's second argument
+ * @param result what the function returned
+ */
+void trace_record(trace_function_t function, uint16_t operand1, uint16_t operand2, alu_result_t result) {
+    trace_buffer_t *buffer = thread_buffer();
+    if (!buffer) {
+        __atomic_fetch_add(&trace_dropped_records, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    if (buffer->used > TRACE_BUFFER_SIZE - TRACE_LONGEST_RECORD) {
+        flush_buffer(buffer);
+    }
+    uint8_t *next = buffer->data + buffer->used;
+    uint16_t *previous = buffer->previous[function];
+    *next++ = (uint8_t) (function | result.unsigned_overflow << 4 | result.signed_overflow << 5
+                         | result.divide_by_zero << 6);
+    next = encode(next, operand1, previous);
+    next = encode(next, operand2, previous + 1);
+    next = encode(next, result.result, previous + 2);
+    next = encode(next, result.supplemental_result, previous + 3);
+    buffer->used = (size_t) (next - buffer->data);
+    buffer->records++;
+}
+
+/**
+ * Starts recording every traced ALU call, from every thread, to a new trace file.
+ * @param path the trace file, which is created or truncated
+ * @return 1 if recording started; 0 if the file could not be created or a trace is already being recorded
+ */
+bool trace_start(const char *path) {
+    uint8_t header[TRACE_FILE_HEADER_SIZE] = {0};
+    if (trace_file >= 0) {
+        return false;
+    }
+    trace_file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (trace_file < 0) {
+        return false;
+    }
+    memcpy(header, TRACE_MAGIC, 8);
+    put_word(header + 8, TRACE_VERSION);
+    if (write(trace_file, header, sizeof(header)) != sizeof(header)) {
+        close(trace_file);
+        trace_file = -1;
+        return false;
+    }
+    trace_file_end = TRACE_FILE_HEADER_SIZE;
+    trace_records = 0;
+    trace_dropped_records = 0;
+    for (trace_buffer_t *buffer = trace_buffers; buffer; buffer = buffer->next) {
+        reset_buffer(buffer);
+    }
+    __atomic_store_n(&trace_recording, true, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * Stops recording, writes out every thread's partially-filled buffer, and closes the trace file. Other threads must
+ * not be making traced ALU calls while this runs.
+ * @return the number of records in the trace
+ */
+uint64_t trace_stop(void) {
+    __atomic_store_n(&trace_recording, false, __ATOMIC_RELEASE);
+    if (trace_file < 0) {
+        return 0;
+    }
+    for (trace_buffer_t *buffer = __atomic_load_n(&trace_buffers, __ATOMIC_ACQUIRE); buffer; buffer = buffer->next) {
+        flush_buffer(buffer);
+    }
+    close(trace_file);
+    trace_file = -1;
+    return trace_records;
+}
+
+/**
+ * Reports how many ALU calls the current or most recent recording dropped because a thread's buffer could not be
+ * allocated.
+ * @return the number of calls missing from the trace
+ */
+uint64_t trace_dropped(void) {
+    return __atomic_load_n(&trace_dropped_records, __ATOMIC_RELAXED);
+}
+
+/*
+ * REPLAY
+ */
+
+static const uint8_t *decode(const uint8_t *source, const uint8_t *end, uint16_t *value, uint16_t *previous) {
+    uint32_t zigzag = 0;
+    int shift = 0;
+    do {
+        if (source == end || shift > 14) {
+            return NULL;
+        }
+        zigzag |= (uint32_t) (*source & 0x7F) << shift;
+        shift += 7;
+    } while (*source++ & 0x80);
+    uint16_t difference = (uint16_t) ((zigzag >> 1) ^ (0 - (zigzag & 0x1)));
+    *value = (uint16_t) (*previous + difference);
+    *previous = *value;
+    return source;
+}
+
+/**
+ * Re-executes every call in a trace against the current build's ALU and compares each result with the recorded one.
+ * @param path the trace file
+ * @param report receives the number of calls to each function, the number whose results differ, the first few
+ *      differences, and the time taken; if the trace cannot be read, its <code>error</code> field explains why
+ * @return 1 if the trace was replayed; 0 otherwise
+ */
+bool trace_replay(const char *path, trace_replay_report_t *report) {
+    memset(report, 0, sizeof(trace_replay_report_t));
+    int file = open(path, O_RDONLY);
+    struct stat status;
+    if (file < 0 || fstat(file, &status) < 0) {
+        report->error = "cannot open the trace";
+        if (file >= 0) {
+            close(file);
+        }
+        return false;
+    }
+    size_t size = (size_t) status.st_size;
+    const uint8_t *trace = size ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    close(file);
+    if (trace == MAP_FAILED || size < TRACE_FILE_HEADER_SIZE || memcmp(trace, TRACE_MAGIC, 8)
+        || get_word(trace + 8) != TRACE_VERSION) {
+        report->error = "not a trace file";
+        if (trace != MAP_FAILED) {
+            munmap((void *) trace, size);
+        }
+        return false;
+    }
+    posix_madvise((void *) trace, size, POSIX_MADV_SEQUENTIAL);
+    report->bytes = size;
+    const uint8_t *chunk = trace + TRACE_FILE_HEADER_SIZE;
+    const uint8_t *trace_end = trace + size;
+    uint64_t start = benchmark_nanoseconds();
+    while (!report->error && chunk < trace_end) {
+        uint16_t previous[NUMBER_OF_TRACE_FUNCTIONS][TRACE_FIELDS] = {{0}};
+        if ((size_t) (trace_end - chunk) < TRACE_CHUNK_HEADER_SIZE
+            || (size_t) (trace_end - chunk) - TRACE_CHUNK_HEADER_SIZE < get_word(chunk)) {
+            report->error = "the trace is truncated";
+            continue;
+        }
+        const uint8_t *next = chunk + TRACE_CHUNK_HEADER_SIZE;
+        const uint8_t *chunk_end = next + get_word(chunk);
+        uint32_t records = get_word(chunk + 4);
+        for (uint32_t i = 0; i < records && !report->error; i++) {
+            uint8_t header = next < chunk_end ? *next++ : 0xFF;
+            trace_function_t function = (trace_function_t) (header & 0xF);
+            uint16_t operand1, operand2;
+            alu_result_t recorded = {};
+            if (function >= NUMBER_OF_TRACE_FUNCTIONS
+                || !(next = decode(next, chunk_end, &operand1, previous[function]))
+                || !(next = decode(next, chunk_end, &operand2, previous[function] + 1))
+                || !(next = decode(next, chunk_end, &recorded.result, previous[function] + 2))
+                || !(next = decode(next, chunk_end, &recorded.supplemental_result, previous[function] + 3))) {
+                report->error = "the trace is corrupt";
+                continue;
+            }
+            recorded.unsigned_overflow = (header >> 4) & 0x1;
+            recorded.signed_overflow = (header >> 5) & 0x1;
+            recorded.divide_by_zero = (header >> 6) & 0x1;
+            alu_result_t replayed = operations[function](operand1, operand2);
+            report->calls[function]++;
+            if (replayed.result != recorded.result || replayed.supplemental_result != recorded.supplemental_result
+                || replayed.unsigned_overflow != recorded.unsigned_overflow
+                || replayed.signed_overflow != recorded.signed_overflow
+                || replayed.divide_by_zero != recorded.divide_by_zero) {
+                uint64_t mismatches = 0;
+                for (int f = 0; f < NUMBER_OF_TRACE_FUNCTIONS; f++) {
+                    mismatches += report->mismatches[f];
+                }
+                if (mismatches < TRACE_REPORTED_MISMATCHES) {
+                    trace_mismatch_t *mismatch = report->first_mismatches + mismatches;
+                    mismatch->function = function;
+                    mismatch->operand1 = operand1;
+                    mismatch->operand2 = operand2;
+                    mismatch->recorded = recorded;
+                    mismatch->replayed = replayed;
+                }
+                report->mismatches[function]++;
+            }
+            report->records++;
+        }
+        chunk = chunk_end;
+    }
+    report->nanoseconds = benchmark_nanoseconds() - start;
+    munmap((void *) trace, size);
+    return !report->error;
+}
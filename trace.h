@@ -0,0 +1,98 @@
+/**************************************************************************//**
+ *
+ * @file trace.h
+ *
+ * @author Sagun Karki
+ *
+ * @brief Type declarations, function prototypes, and traced ALU wrappers for
+ *      recording ALU calls to a binary trace and replaying the trace later.
+ *
+ * Code that should be traceable calls the ALU through the traced_ wrappers
+ * below. While no trace is being recorded, a wrapper costs one relaxed load
+ * and a not-taken branch.
+ *
+ ******************************************************************************/
+
+/*
+ * IntegerLab assignment and starter code (c) 2018-22 Christopher A. Bohn
+ * IntegerLab extensions (c) the above-named student(s)
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "alu_extensions.h"
+
+#define TRACE_REPORTED_MISMATCHES   8
+
+typedef enum {
+    TRACE_ADD = 0,
+    TRACE_SUBTRACT,
+    TRACE_UNSIGNED_MULTIPLY,
+    TRACE_SIGNED_MULTIPLY,
+    TRACE_UNSIGNED_DIVIDE,
+    TRACE_SIGNED_DIVIDE,
+    TRACE_COMPARE,
+    NUMBER_OF_TRACE_FUNCTIONS
+} trace_function_t;
+
+typedef struct {
+    trace_function_t function;
+    uint16_t operand1;
+    uint16_t operand2;
+    alu_result_t recorded;
+    alu_result_t replayed;
+} trace_mismatch_t;
+
+typedef struct {
+    uint64_t records;
+    uint64_t calls[NUMBER_OF_TRACE_FUNCTIONS];
+    uint64_t mismatches[NUMBER_OF_TRACE_FUNCTIONS];
+    trace_mismatch_t first_mismatches[TRACE_REPORTED_MISMATCHES];
+    uint64_t nanoseconds;
+    uint64_t bytes;
+    const char *error;                  // NULL if the trace was replayed
+} trace_replay_report_t;
+
+extern bool trace_recording;
+
+bool trace_start(const char *path) __attribute__ ((no_instrument_function));
+uint64_t trace_stop(void) __attribute__ ((no_instrument_function));
+uint64_t trace_dropped(void) __attribute__ ((no_instrument_function));
+void trace_record(trace_function_t function, uint16_t operand1, uint16_t operand2, alu_result_t result) __attribute__ ((no_instrument_function));
+bool trace_replay(const char *path, trace_replay_report_t *report) __attribute__ ((no_instrument_function));
+const char *trace_function_name(trace_function_t function) __attribute__ ((no_instrument_function));
+
+#define TRACED_ALU_FUNCTION(name, FUNCTION)                                                                            \
+    static inline alu_result_t traced_##name(uint16_t operand1, uint16_t operand2)                                     \
+            __attribute__ ((no_instrument_function));                                                                  \
+    static inline alu_result_t traced_##name(uint16_t operand1, uint16_t operand2) {                                   \
+        alu_result_t result = name(operand1, operand2);                                                                \
+        if (__atomic_load_n(&trace_recording, __ATOMIC_RELAXED)) {                                                     \
+            trace_record(FUNCTION, operand1, operand2, result);                                                        \
+        }                                                                                                              \
+        return result;                                                                                                 \
+    }
+
+TRACED_ALU_FUNCTION(add, TRACE_ADD)
+TRACED_ALU_FUNCTION(subtract, TRACE_SUBTRACT)
+TRACED_ALU_FUNCTION(unsigned_multiply, TRACE_UNSIGNED_MULTIPLY)
+TRACED_ALU_FUNCTION(signed_multiply, TRACE_SIGNED_MULTIPLY)
+TRACED_ALU_FUNCTION(unsigned_divide, TRACE_UNSIGNED_DIVIDE)
+TRACED_ALU_FUNCTION(signed_divide, TRACE_SIGNED_DIVIDE)
+
+static inline alu_flags_t traced_compare(uint16_t value1, uint16_t value2) __attribute__ ((no_instrument_function));
+
+static inline alu_flags_t traced_compare(uint16_t value1, uint16_t value2) {
+    alu_flags_t flags = compare(value1, value2);
+    if (__atomic_load_n(&trace_recording, __ATOMIC_RELAXED)) {
+        alu_result_t result = {};
+        result.result = flags;
+        trace_record(TRACE_COMPARE, value1, value2, result);
+    }
+    return flags;
+}
+
+#endif //TRACE_H